@@ -60,6 +60,24 @@ public class IMPBitonicSort:IMPContextProvider{
     public func run(direction:Int) {
         bitonicSort(direction:direction)
     }
+    
+    ///
+    /// Sorts the array on CPU with the same direction: y compares as an integer, any count is
+    /// sorted, stable keeps equal y in their order
+    ///
+    public func runOnCpu(direction:Int, stable:Bool = false) {
+        
+        let options = IMPKeyValueSortOptions(descending: direction == 0, stable: stable)
+        
+        var sorted = array
+        let count = sorted.count
+        
+        sorted.withUnsafeMutableBytes { (buffer) in
+            IMPKeyValueSortUInt2(buffer.baseAddress?.assumingMemoryBound(to: UInt32.self), count, options)
+        }
+        
+        array = sorted
+    }
 
     //
     // MARK - Private
@@ -0,0 +1,57 @@
+//
+//  IMPAdaptiveThreshold-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPAdaptiveThreshold_Bridging_CPU_h
+#define IMPAdaptiveThreshold_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum : int {
+        ///  @brief threshold = mean * (1 - k) - offset
+        IMPAdaptiveThresholdBradley = 0,
+        ///  @brief threshold = mean * (1 + k * (deviation / range - 1)) - offset
+        IMPAdaptiveThresholdSauvola = 1
+    } IMPAdaptiveThresholdMethod;
+
+    typedef struct {
+        IMPAdaptiveThresholdMethod method;
+        ///  @brief Window of (2*radius+1) x (2*radius+1) pixels
+        uint32_t radius;
+        ///  @brief Bradley 0 - 0.15, Sauvola 0.2 - 0.5
+        float    k;
+        ///  @brief Normalized luma subtracted from the threshold, IMPAdaptiveThreshold uses 0.05
+        float    offset;
+        ///  @brief Dynamic range of the Sauvola deviation, 0.5 usually
+        float    range;
+    } IMPAdaptiveThresholdOptions;
+
+    ///  @brief Summed-area table adaptive threshold of the source luma, O(1) per pixel whatever the window is.
+    ///  Pixels darker than the threshold are set: the first pixel of a row is the most significant bit
+    ///  of its first byte.
+    ///
+    ///  @param bytesPerRow mask row stride, (width + 7) / 8 at least
+    ///
+    ///  @return false if the format is not supported or the mask rows are too short
+    bool IMPAdaptiveThresholdMask(IMPCpuImage source, uint8_t *mask, size_t bytesPerRow, IMPAdaptiveThresholdOptions options);
+
+    ///  @brief The same threshold written as an image the way kernel_adaptiveThreshold does: 1 in colour
+    ///  channels of the foreground, 0 elsewhere and alpha 1. Source and destination must have the same
+    ///  size and format and may be the same image.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPAdaptiveThresholdApply(IMPCpuImage source, IMPCpuImage destination, IMPAdaptiveThresholdOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPAdaptiveThreshold_Bridging_CPU_h */
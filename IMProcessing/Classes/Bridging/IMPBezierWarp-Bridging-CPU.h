@@ -0,0 +1,33 @@
+//
+//  IMPBezierWarp-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPBezierWarp_Bridging_CPU_h
+#define IMPBezierWarp_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief fragment_bezierWarpTransformation on CPU: the cubic of each row is stepped by forward
+    ///  differences and the source is sampled bilinearly, clamped to the edge. Destination may have
+    ///  any size, the format of the source, and must not overlap it.
+    ///
+    ///  @param surface      IMPFloat2x4x4 control points, 16 (x, y) pairs in normalized source
+    ///                      coordinates, rows along y
+    ///  @param background   RGBA in [0, 1] where the sample has zero alpha, may be NULL for transparent black
+    ///
+    ///  @return false if the formats don't match or the format is not supported
+    bool IMPBezierWarp(IMPCpuImage source, IMPCpuImage destination, const float *surface, const float *background);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPBezierWarp_Bridging_CPU_h */
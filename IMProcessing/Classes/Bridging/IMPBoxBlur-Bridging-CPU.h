@@ -0,0 +1,34 @@
+//
+//  IMPBoxBlur-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPBoxBlur_Bridging_CPU_h
+#define IMPBoxBlur_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Running sum box blur of (2*radius+1) x (2*radius+1) window, the cost does not depend on radius.
+    ///  Source and destination must have the same size and format and may be the same image.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPRunningSumBoxBlur(IMPCpuImage source, IMPCpuImage destination, uint32_t radius);
+
+    ///  @brief Gaussian approximation by a few running sum box passes with optimal box sizes for sigma.
+    ///  3 - 5 passes are usually enough.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPStackedBoxGaussianBlur(IMPCpuImage source, IMPCpuImage destination, float sigma, uint32_t passes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPBoxBlur_Bridging_CPU_h */
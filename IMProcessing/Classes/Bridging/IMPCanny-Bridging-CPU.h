@@ -0,0 +1,52 @@
+//
+//  IMPCanny-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCanny_Bridging_CPU_h
+#define IMPCanny_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct {
+        ///  @brief Gaussian sigma of the luma, 0 skips the blur
+        float blurRadius;
+        ///  @brief Normalized gradient magnitude which starts an edge, 0.4 usually
+        float upperThreshold;
+        ///  @brief Normalized gradient magnitude an edge may continue through, 0.1 usually
+        float lowerThreshold;
+    } IMPCannyOptions;
+
+    ///  @brief IMPEdgel memory layout without the simd types, so IMPEdgelList.array can be filled
+    ///  directly: position in normalized texture coordinates, slope is the unit gradient.
+    typedef struct {
+        float position[2];
+        float slope[2];
+    } IMPCpuEdgel;
+
+    ///  @brief Canny edges with exact hysteresis in the IMPCannyEdges layout: 1 in colour channels
+    ///  of edges, 0 elsewhere and alpha 1. Source and destination must have the same size and format
+    ///  and may be the same image.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPCannyApply(IMPCpuImage source, IMPCpuImage destination, IMPCannyOptions options);
+
+    ///  @brief Edge pixels of the source in raster order.
+    ///
+    ///  @param edgels   up to capacity edgels are written, may be NULL to count them only
+    ///
+    ///  @return the number of edgels found, may be greater than capacity
+    size_t IMPCannyEdgels(IMPCpuImage source, IMPCpuEdgel *edgels, size_t capacity, IMPCannyOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPCanny_Bridging_CPU_h */
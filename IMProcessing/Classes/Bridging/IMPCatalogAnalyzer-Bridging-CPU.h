@@ -0,0 +1,52 @@
+//
+//  IMPCatalogAnalyzer-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCatalogAnalyzer_Bridging_CPU_h
+#define IMPCatalogAnalyzer_Bridging_CPU_h
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Headless catalog histogram analyzer options
+    typedef struct {
+        ///  @brief Decoding workers, 0 - one per core
+        uint32_t workers;
+        ///  @brief Catalog entries waiting for a worker, 0 - twice the number of workers
+        uint32_t queueDepth;
+        ///  @brief The smallest side of reduced DCT scale decoding, 0 - full size
+        uint32_t minimumSide;
+        ///  @brief Shadows clipping of the range solver
+        float    shadowsClipping;
+        ///  @brief Highlights clipping of the range solver
+        float    highlightsClipping;
+        ///  @brief Analyzed region, the same meaning as IMPRegion
+        float    regionLeft;
+        float    regionRight;
+        float    regionTop;
+        float    regionBottom;
+    } IMPCatalogAnalyzerOptions;
+
+    ///  @brief Default options: one worker per core, minimum decoded side 256px, 0.1% clipping
+    IMPCatalogAnalyzerOptions IMPCatalogAnalyzerDefaultOptions(void);
+
+    ///  @brief Analyze JPEG files listed one per line in catalogPath and write results
+    ///  as newline delimited JSON to outputPath. "-" stands for stdin/stdout.
+    ///
+    ///  @return number of processed catalog entries or -1 if catalog or output can't be opened
+    long IMPCatalogAnalyzerRun(const char *catalogPath,
+                               const char *outputPath,
+                               const IMPCatalogAnalyzerOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPCatalogAnalyzer_Bridging_CPU_h */
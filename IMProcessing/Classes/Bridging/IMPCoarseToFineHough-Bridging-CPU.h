@@ -0,0 +1,43 @@
+//
+//  IMPCoarseToFineHough-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCoarseToFineHough_Bridging_CPU_h
+#define IMPCoarseToFineHough_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+#include "IMPHoughSpace-Bridging-CPU.h"
+#include "IMPHoughPeaks-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Peaks of the IMPHoughSpace accumulator of the options without voting it: a space of factor
+    ///  times the steps is voted first, then the fine bins around its 2 * linesMax strongest peaks only.
+    ///  Indices are the bins of the fine accumulator, IMPHoughSpaceDimensions gives its numrho.
+    ///
+    ///  @param edges        pixels whose first channel is at least half of the range
+    ///  @param factor       coarse bins per fine bin along distance and angle, 1 votes the fine space
+    ///  @param peaks        up to capacity peaks, the strongest first, may be NULL to count them only
+    ///
+    ///  @return the number of peaks found, may be greater than capacity
+    size_t IMPHoughCoarseToFinePeaks(IMPCpuImage edges, IMPHoughSpaceOptions options, IMPHoughPeaksOptions peaksOptions,
+                                     uint32_t factor, IMPCpuHoughPeak *peaks, size_t capacity);
+
+    ///  @brief IMPHoughCoarseToFinePeaks of points in normalized coordinates of a width x height image
+    ///
+    ///  @param points       size x, y pairs
+    size_t IMPHoughCoarseToFinePeaksPoints(const float *points, size_t size, size_t width, size_t height,
+                                           IMPHoughSpaceOptions options, IMPHoughPeaksOptions peaksOptions,
+                                           uint32_t factor, IMPCpuHoughPeak *peaks, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPCoarseToFineHough_Bridging_CPU_h */
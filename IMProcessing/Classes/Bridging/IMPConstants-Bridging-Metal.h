@@ -72,6 +72,12 @@ static constant float3 kIMP_Y_YUV_factor = {0.2125, 0.7154, 0.0721};
 
 #define  kIMP_Color_Ramps  6
 
+//
+// Side of the blocks of the tile-relative summed-area tables: an entry sums at most
+// kIMP_Integral_Tile^2 samples whatever the frame size is, so float32 keeps the window sums
+//
+#define  kIMP_Integral_Tile  64
+
 static constant float4 kIMP_HSV_K0      = {0.0, -1.0 / 3.0, 2.0 / 3.0, -1.0};
 static constant float4 kIMP_HSV_K1      = {0.0, -1.0 / 3.0, 2.0 / 3.0, -1.0};
 static constant float4 kIMP_Reds        = {315.0, 345.0, 15.0,   45.0};
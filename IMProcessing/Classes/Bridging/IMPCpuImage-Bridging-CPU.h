@@ -0,0 +1,45 @@
+//
+//  IMPCpuImage-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCpuImage_Bridging_CPU_h
+#define IMPCpuImage_Bridging_CPU_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Pixel layouts CPU engines can read and write.
+    ///  Integral formats are processed in their own scale and rounded back on store.
+    typedef enum : int {
+        IMPCpuPixelFormatR8      = 0,
+        IMPCpuPixelFormatRGBA8   = 1,
+        IMPCpuPixelFormatR16     = 2,
+        IMPCpuPixelFormatRGBA16  = 3,
+        IMPCpuPixelFormatR32F    = 4,
+        IMPCpuPixelFormatRGBA32F = 5
+    } IMPCpuPixelFormat;
+
+    ///  @brief Host memory image plane, usually mapped from an MTLTexture or a decoded file.
+    typedef struct {
+        void              *data;
+        size_t             width;
+        size_t             height;
+        ///  @brief Signed row pitch in bytes, negative walks rows bottom-up
+        long               bytesPerRow;
+        IMPCpuPixelFormat  format;
+    } IMPCpuImage;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPCpuImage_Bridging_CPU_h */
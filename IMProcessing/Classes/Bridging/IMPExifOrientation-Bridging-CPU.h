@@ -0,0 +1,42 @@
+//
+//  IMPExifOrientation-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPExifOrientation_Bridging_CPU_h
+#define IMPExifOrientation_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Turn an image stored in an EXIF orientation upright on CPU. Destination has the format of the
+    ///  source, its width and height swapped if IMPExifOrientationTransposes, and must not overlap it.
+    ///
+    ///  @param orientation  IMPExifOrientation code, 0 is taken as up
+    ///
+    ///  @return false if the formats or the sizes don't match
+    bool IMPExifOrientationApply(IMPCpuImage source, IMPCpuImage destination, int orientation);
+
+    ///  @brief The upright image sharing the pixels of source, for the up and vertically flipped orientations:
+    ///  the flip starts at the last row with a negative bytesPerRow, for engines reading signed pitches.
+    ///
+    ///  @return false for the orientations reversing or transposing rows, these need IMPExifOrientationApply
+    bool IMPExifOrientationView(IMPCpuImage source, int orientation, IMPCpuImage *upright);
+
+    ///  @brief True if the upright image swaps the width and the height
+    bool IMPExifOrientationTransposes(int orientation);
+
+    ///  @brief The orientation storing an upright image back in orientation
+    int IMPExifOrientationInverse(int orientation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPExifOrientation_Bridging_CPU_h */
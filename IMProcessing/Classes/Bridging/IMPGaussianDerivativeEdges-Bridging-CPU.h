@@ -0,0 +1,32 @@
+//
+//  IMPGaussianDerivativeEdges-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPGaussianDerivativeEdges_Bridging_CPU_h
+#define IMPGaussianDerivativeEdges_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief kernel_gaussianDerivativeEdge with every derivative computed once: 1 in colour
+    ///  channels of edges, 0 elsewhere and alpha 1. Source and destination must have the same size
+    ///  and format and may be the same image.
+    ///
+    ///  @param pitch     distance between the derivative taps in pixels, 0 means 1
+    ///  @param threshold the shader uses 1
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPGaussianDerivativeEdgesApply(IMPCpuImage source, IMPCpuImage destination, uint32_t pitch, float threshold);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPGaussianDerivativeEdges_Bridging_CPU_h */
@@ -0,0 +1,67 @@
+//
+//  IMPHarrisCorners-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHarrisCorners_Bridging_CPU_h
+#define IMPHarrisCorners_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief IMPCorner memory layout without the simd types, so a [IMPCorner] buffer can be filled
+    ///  directly: point in normalized texture coordinates, slope of the left, top, bottom and right
+    ///  quadrants, color is left to the caller.
+    typedef struct {
+        float point[2];
+        float slope[4] __attribute__((aligned(16)));
+        float color[4];
+    } IMPCpuCorner;
+
+    typedef struct {
+        ///  @brief Distance of the derivative taps in pixels, 0 means 1
+        uint32_t texelRadius;
+        ///  @brief Gaussian sigma of the structure tensor window, 0 skips it
+        float    blurRadius;
+        ///  @brief Response scale, IMPHarrisCorner uses 16
+        float    sensitivity;
+        ///  @brief Harris k, 0.04 usually
+        float    k;
+        ///  @brief Minimal scaled response, IMPNonMaximumSuppression uses 0.2
+        float    threshold;
+        ///  @brief Window of the corner slopes, slopeRegion/2 pixels on each side of a corner; 0 leaves them zero
+        uint32_t slopeRegion;
+        ///  @brief Keep the strongest corners only, 0 keeps all
+        uint32_t topK;
+        ///  @brief Drop corners closer than that to a stronger kept one, in pixels; 0 keeps all
+        float    minDistance;
+    } IMPHarrisCornersOptions;
+
+    ///  @brief Harris corners of the source in raster order, detected tile by tile without full frame
+    ///  intermediates.
+    ///
+    ///  @param corners  up to capacity corners are written, may be NULL to count them only
+    ///
+    ///  @return the number of corners found, may be greater than capacity
+    size_t IMPHarrisCornersDetect(IMPCpuImage source, IMPCpuCorner *corners, size_t capacity, IMPHarrisCornersOptions options);
+
+    ///  @brief Slopes of the given corners: the squared fragment_xyDerivative derivatives summed over the
+    ///  left, top, bottom and right quadrants of the window, from summed-area tables, four lookups a quadrant.
+    ///
+    ///  @param texelRadius  distance of the derivative taps in pixels, 0 means 1
+    ///  @param regionSize   the window covers regionSize/2 pixels on each side of a corner
+    ///
+    ///  @return false if the source is empty
+    bool IMPCornerSlopes(IMPCpuImage source, IMPCpuCorner *corners, size_t count, uint32_t texelRadius, uint32_t regionSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPHarrisCorners_Bridging_CPU_h */
@@ -0,0 +1,55 @@
+//
+//  IMPHoughPeaks-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHoughPeaks_Bridging_CPU_h
+#define IMPHoughPeaks_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Accumulator bin (n + 1) * (numrho + 2) + r + 1 and its votes
+    typedef struct {
+        uint32_t index;
+        uint32_t votes;
+    } IMPCpuHoughPeak;
+
+    typedef struct {
+        ///  @brief Votes a peak must exceed
+        uint32_t threshold;
+        ///  @brief Strongest peaks to keep, 0 keeps all
+        uint32_t linesMax;
+        ///  @brief Weaker peaks within these distance and angle bins of a kept one are dropped, 0 keeps all
+        uint32_t rhoRadius;
+        uint32_t thetaRadius;
+    } IMPHoughPeaksOptions;
+
+    ///  @brief Strongest local maximums of an IMPHoughSpace accumulator, the kernel_houghSpaceLocalMaximums
+    ///  test, scanned by bands of angles into bounded heaps.
+    ///
+    ///  @param accumulator  (numangle + 2) * (numrho + 2) bins
+    ///  @param peaks        up to capacity peaks, the strongest first, may be NULL to count them only
+    ///
+    ///  @return the number of peaks found, may be greater than capacity
+    size_t IMPHoughPeaksFind(const uint32_t *accumulator, size_t numangle, size_t numrho,
+                             IMPHoughPeaksOptions options, IMPCpuHoughPeak *peaks, size_t capacity);
+
+    ///  @brief Strongest of local maximums found elsewhere with the suppression radius of the options,
+    ///  the threshold is not applied.
+    ///
+    ///  @return the number of peaks selected, may be greater than capacity
+    size_t IMPHoughPeaksSelect(const IMPCpuHoughPeak *candidates, size_t count, size_t numrho,
+                               IMPHoughPeaksOptions options, IMPCpuHoughPeak *peaks, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPHoughPeaks_Bridging_CPU_h */
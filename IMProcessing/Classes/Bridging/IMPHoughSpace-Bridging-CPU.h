@@ -0,0 +1,68 @@
+//
+//  IMPHoughSpace-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHoughSpace_Bridging_CPU_h
+#define IMPHoughSpace_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct {
+        ///  @brief Distance resolution in pixels
+        float rhoStep;
+        ///  @brief Angle resolution in radians
+        float thetaStep;
+        float minTheta;
+        float maxTheta;
+    } IMPHoughSpaceOptions;
+
+    typedef struct {
+        ///  @brief Voted angles on each side of the edge normal in radians
+        float spread;
+        ///  @brief A pixel votes 1 + weight * gradient length rounded, 0 counts pixels
+        float weight;
+    } IMPHoughOrientationOptions;
+
+    ///  @brief Angles and distances of the IMPHoughSpace accumulator of an image, it holds
+    ///  (numangle + 2) * (numrho + 2) bins.
+    void IMPHoughSpaceDimensions(size_t width, size_t height, IMPHoughSpaceOptions options, size_t *numangle, size_t *numrho);
+
+    ///  @brief IMPHoughSpace accumulator of the pixels whose first channel is at least half of the range,
+    ///  voted by angle ranges in parallel.
+    ///
+    ///  @param accumulator  (numangle + 2) * (numrho + 2) bins
+    ///  @param count        size of the accumulator in bins
+    ///
+    ///  @return false if the accumulator is too small or the image is empty
+    bool IMPHoughSpaceTransform(IMPCpuImage image, IMPHoughSpaceOptions options, uint32_t *accumulator, size_t count);
+
+    ///  @brief IMPHoughSpace accumulator where an edge pixel votes only the angles within the spread of
+    ///  its edge normal, the normal is the direction of the Sobel gradient of the source luma.
+    ///
+    ///  @param edges   pixels whose first channel is at least half of the range vote
+    ///  @param source  any supported format of the edges size
+    ///
+    ///  @return false if the accumulator is too small, sizes don't match or an image is empty
+    bool IMPHoughSpaceTransformOriented(IMPCpuImage edges, IMPCpuImage source, IMPHoughSpaceOptions options,
+                                        IMPHoughOrientationOptions orientation, uint32_t *accumulator, size_t count);
+
+    ///  @brief IMPHoughSpace accumulator of points in normalized coordinates of a width x height image.
+    ///
+    ///  @param points  x, y pairs
+    ///  @param size    number of points
+    bool IMPHoughSpaceTransformPoints(const float *points, size_t size, size_t width, size_t height,
+                                      IMPHoughSpaceOptions options, uint32_t *accumulator, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPHoughSpace_Bridging_CPU_h */
@@ -0,0 +1,37 @@
+//
+//  IMPKeyValueSort-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPKeyValueSort_Bridging_CPU_h
+#define IMPKeyValueSort_Bridging_CPU_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct {
+        ///  @brief The greatest key first
+        bool descending;
+        ///  @brief Equal keys keep their order
+        bool stable;
+    } IMPKeyValueSortOptions;
+
+    ///  @brief Sorts uint2 pairs by y as a 32-bit integer, any count, in place: the CPU counterpart
+    ///  of kernel_bitonicSortUInt2 without the power of two padding.
+    ///
+    ///  @param pairs        count (x, y) pairs, 2 * count words
+    void IMPKeyValueSortUInt2(uint32_t *pairs, size_t count, IMPKeyValueSortOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPKeyValueSort_Bridging_CPU_h */
@@ -0,0 +1,46 @@
+//
+//  IMPMedian-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPMedian_Bridging_CPU_h
+#define IMPMedian_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum : int {
+        ///  @brief Every channel is filtered independently
+        IMPMedianModePerChannel = 0,
+        ///  @brief Colour of the pixels with the median luma, the same ordering kernel_median uses
+        IMPMedianModeLuma       = 1
+    } IMPMedianMode;
+
+    ///  @brief Perreault - Hébert median of (2*radius+1) x (2*radius+1) window, the cost does not depend on radius.
+    ///  Source and destination must have the same size and format and may be the same image.
+    ///
+    ///  @param bits quantization levels of 16-bit and float samples as a power of 2, 8 - 12, 0 means 12.
+    ///  8-bit samples are never quantized.
+    ///
+    ///  @return false if the images don't match, the format is not supported or radius is more than 32766
+    bool IMPConstantTimeMedian(IMPCpuImage source, IMPCpuImage destination,
+                               uint32_t radius, IMPMedianMode mode, uint32_t bits);
+
+    ///  @brief 3x3 median of every channel by vectorized exchange networks over 16 (8-bit), 8 (16-bit)
+    ///  or 4 (float) samples at once, packed RGBA8 included. Source and destination must have the same
+    ///  size and format and may be the same image.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPMedian3x3(IMPCpuImage source, IMPCpuImage destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPMedian_Bridging_CPU_h */
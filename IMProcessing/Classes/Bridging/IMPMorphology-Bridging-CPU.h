@@ -0,0 +1,55 @@
+//
+//  IMPMorphology-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPMorphology_Bridging_CPU_h
+#define IMPMorphology_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum : int {
+        IMPMorphologyErode    = 0,
+        IMPMorphologyDilate   = 1,
+        ///  @brief Dilation of the erosion
+        IMPMorphologyOpen     = 2,
+        ///  @brief Erosion of the dilation
+        IMPMorphologyClose    = 3,
+        ///  @brief Source minus opening
+        IMPMorphologyTopHat   = 4,
+        ///  @brief Closing minus source
+        IMPMorphologyBlackHat = 5,
+        ///  @brief Dilation minus erosion
+        IMPMorphologyGradient = 6
+    } IMPMorphologyOperation;
+
+    typedef enum : int {
+        ///  @brief (2*radiusX+1) x (2*radiusY+1) rectangle
+        IMPMorphologyRectangle = 0,
+        ///  @brief |x| + |y| <= radiusX
+        IMPMorphologyDiamond   = 1,
+        ///  @brief Regular octagon of radiusX approximating the disk
+        IMPMorphologyDisk      = 2
+    } IMPMorphologyShape;
+
+    ///  @brief Van Herk - Gil-Werman morphology, the cost per pixel does not depend on the radius.
+    ///  Composite operations keep their intermediates in bands of rows instead of whole images.
+    ///  Source and destination must have the same size and format and may be the same image.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPMorphologyApply(IMPCpuImage source, IMPCpuImage destination,
+                            IMPMorphologyOperation operation, IMPMorphologyShape shape,
+                            uint32_t radiusX, uint32_t radiusY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPMorphology_Bridging_CPU_h */
@@ -0,0 +1,45 @@
+//
+//  IMPNonMaximumSuppression-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPNonMaximumSuppression_Bridging_CPU_h
+#define IMPNonMaximumSuppression_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief A local maximum: point in normalized texture coordinates and its response
+    typedef struct {
+        float point[2];
+        float response;
+    } IMPCpuMaximum;
+
+    typedef struct {
+        ///  @brief Minimal response, IMPNonMaximumSuppression uses 0.2
+        float    threshold;
+        ///  @brief Keep the strongest maxima only, 0 keeps all
+        uint32_t topK;
+        ///  @brief Drop maxima closer than that to a stronger kept one, in pixels; 0 keeps all
+        float    minDistance;
+    } IMPNonMaximumSuppressionOptions;
+
+    ///  @brief fragment_nonMaximumSuppression maxima of the first channel of the response as a list in
+    ///  raster order, no mask is written.
+    ///
+    ///  @param maxima  up to capacity maxima are written, may be NULL to count them only
+    ///
+    ///  @return the number of maxima selected, may be greater than capacity
+    size_t IMPNonMaximumSuppressionMaxima(IMPCpuImage response, IMPCpuMaximum *maxima, size_t capacity, IMPNonMaximumSuppressionOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPNonMaximumSuppression_Bridging_CPU_h */
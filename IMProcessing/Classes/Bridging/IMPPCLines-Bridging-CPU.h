@@ -0,0 +1,48 @@
+//
+//  IMPPCLines-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPPCLines_Bridging_CPU_h
+#define IMPPCLines_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief IMPPolarLine in pixels of the image: x * cos(theta) + y * sin(theta) = rho, and its votes
+    typedef struct {
+        float    rho;
+        float    theta;
+        uint32_t votes;
+    } IMPCpuPolarLine;
+
+    typedef struct {
+        ///  @brief Columns of each of the T and S spaces, 0 means 1
+        uint32_t resolution;
+        ///  @brief Minimal votes of a line
+        uint32_t threshold;
+        ///  @brief Strongest lines to keep, 0 keeps all
+        uint32_t linesMax;
+        ///  @brief Minimal distance of two maxima in accumulator bins
+        float    minDistance;
+    } IMPPCLinesOptions;
+
+    ///  @brief PCLines detection of the lines through the pixels whose first channel is at least half
+    ///  of the range, the strongest first.
+    ///
+    ///  @param lines  up to capacity lines are written, may be NULL to count them only
+    ///
+    ///  @return the number of lines found, may be greater than capacity
+    size_t IMPPCLinesDetect(IMPCpuImage image, IMPCpuPolarLine *lines, size_t capacity, IMPPCLinesOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPPCLines_Bridging_CPU_h */
@@ -0,0 +1,56 @@
+//
+//  IMPPerspectiveWarp-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPPerspectiveWarp_Bridging_CPU_h
+#define IMPPerspectiveWarp_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum : int {
+        IMPPerspectiveWarpBilinear = 0,
+        IMPPerspectiveWarpBicubic  = 1
+    } IMPPerspectiveWarpFilter;
+
+    typedef struct {
+        IMPPerspectiveWarpFilter filter;
+        ///  @brief Pixels interpolated between two divides, 1 divides every pixel
+        uint32_t span;
+        ///  @brief Largest position error of an interpolated span in source pixels
+        float    tolerance;
+        ///  @brief RGBA in [0, 1] outside the source
+        float    background[4];
+    } IMPPerspectiveWarpOptions;
+
+    ///  @brief Homography warp on CPU: the destination pixel (x, y) samples the source at the projection
+    ///  of matrix * (x, y, 1), texel centres at integers. Destination may have any size, the format of
+    ///  the source, and must not overlap it.
+    ///
+    ///  @param matrix       row major 3 x 3 map of destination pixels to homogeneous source pixels
+    ///
+    ///  @return false if the formats don't match or the format is not supported
+    bool IMPPerspectiveWarpMatrix(IMPCpuImage source, IMPCpuImage destination, const float *matrix,
+                                  IMPPerspectiveWarpOptions options);
+
+    ///  @brief IMPPerspectiveWarpMatrix of a vertex_warpTransformation model, e.g. IMPQuad.transformTo(destination:)
+    ///  or IMPTransfromModel.matrix, moving the full frame source quad in clip space
+    ///
+    ///  @param model        column major float4x4
+    ///
+    ///  @return false if the model is singular or the formats don't match
+    bool IMPPerspectiveWarpModel(IMPCpuImage source, IMPCpuImage destination, const float *model,
+                                 IMPPerspectiveWarpOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPPerspectiveWarp_Bridging_CPU_h */
@@ -0,0 +1,57 @@
+//
+//  IMPProbabilisticHough-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPProbabilisticHough_Bridging_CPU_h
+#define IMPProbabilisticHough_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief IMPLineSegment ends in normalized coordinates of the image and the votes of its line
+    typedef struct {
+        float    p0[2];
+        float    p1[2];
+        uint32_t votes;
+    } IMPCpuLineSegment;
+
+    typedef struct {
+        ///  @brief Distance resolution in pixels
+        float    rhoStep;
+        ///  @brief Angle resolution in radians
+        float    thetaStep;
+        ///  @brief Votes a line needs to be walked
+        uint32_t threshold;
+        ///  @brief Shorter segments are dropped, in pixels along x or y
+        float    minLineLength;
+        ///  @brief Longest run of missing pixels a segment may bridge
+        float    maxLineGap;
+        ///  @brief Stop after so many segments, 0 does not stop
+        uint32_t linesMax;
+        ///  @brief Stop after so many drawn edge pixels, 0 draws all of them
+        uint32_t samplesMax;
+        ///  @brief Seed of the random order of the pixels
+        uint32_t seed;
+    } IMPProbabilisticHoughOptions;
+
+    ///  @brief Progressive probabilistic Hough segments of the pixels whose first channel is at least half
+    ///  of the range, in the order they are found.
+    ///
+    ///  @param segments  up to capacity segments are written, may be NULL to count them only
+    ///
+    ///  @return the number of segments found, may be greater than capacity
+    size_t IMPProbabilisticHoughSegments(IMPCpuImage edges, IMPCpuLineSegment *segments, size_t capacity,
+                                         IMPProbabilisticHoughOptions options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPProbabilisticHough_Bridging_CPU_h */
@@ -0,0 +1,28 @@
+//
+//  IMPRecursiveGaussian-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPRecursiveGaussian_Bridging_CPU_h
+#define IMPRecursiveGaussian_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Young - van Vliet recursive gaussian blur, the cost does not depend on sigma.
+    ///  Source and destination must have the same size and format and may be the same image.
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPRecursiveGaussianBlur(IMPCpuImage source, IMPCpuImage destination, float sigma);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPRecursiveGaussian_Bridging_CPU_h */
@@ -0,0 +1,37 @@
+//
+//  IMPSeparableConvolution-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPSeparableConvolution_Bridging_CPU_h
+#define IMPSeparableConvolution_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Cache blocked separable convolution with odd length kernels, the centre tap in the middle.
+    ///  Source and destination must have the same size and format and may be the same image.
+    ///
+    ///  @return false if the images don't match, the format is not supported or a kernel length is even
+    bool IMPSeparableConvolve(IMPCpuImage source, IMPCpuImage destination,
+                              const float *horizontal, uint32_t horizontalLength,
+                              const float *vertical, uint32_t verticalLength);
+
+    ///  @brief Separable convolution with linearly sampled weights and offsets, the same arrays
+    ///  kernel_gaussianSampledBlur reads: weights[0] at the centre, weights[i] at +/- offsets[i].
+    ///
+    ///  @return false if the images don't match or the format is not supported
+    bool IMPSampledSeparableConvolve(IMPCpuImage source, IMPCpuImage destination,
+                                     const float *weights, const float *offsets, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPSeparableConvolution_Bridging_CPU_h */
@@ -0,0 +1,33 @@
+//
+//  IMPSobelGradient-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPSobelGradient_Bridging_CPU_h
+#define IMPSobelGradient_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Sobel gradient of the source luma in one pass, the kernel_directionalSobelEdge output.
+    ///  RGBA destinations get magnitude, direction x, direction y and 1, direction components are
+    ///  0, 0.5 or 1. Single channel destinations get the magnitude only.
+    ///
+    ///  @param source      any supported format
+    ///  @param destination the source size, its format may differ from the source one: 8/16-bit
+    ///                     magnitudes saturate the way a unorm texture does
+    ///
+    ///  @return false if the sizes don't match or a format is not supported
+    bool IMPSobelGradient(IMPCpuImage source, IMPCpuImage destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPSobelGradient_Bridging_CPU_h */
@@ -0,0 +1,47 @@
+//
+//  IMPStripStream-Bridging-CPU.h
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPStripStream_Bridging_CPU_h
+#define IMPStripStream_Bridging_CPU_h
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///  @brief Neighbourhood operations of a streamed chain
+    typedef enum : int {
+        IMPStripStageGaussianBlur = 0,
+        IMPStripStageSobel        = 1,
+        IMPStripStageMedian3x3    = 2,
+        IMPStripStageErode        = 3,
+        IMPStripStageDilate       = 4
+    } IMPStripStageType;
+
+    typedef struct {
+        IMPStripStageType type;
+        ///  @brief Gaussian sigma or morphology square radius in pixels, unused by the rest
+        float             radius;
+    } IMPStripStage;
+
+    ///  @brief Run a chain of stages band by band, intermediate memory is proportional to
+    ///  width * (band + halo rows) instead of the whole image. Source and destination must have
+    ///  the same size and format and may be the same image.
+    ///
+    ///  @param band rows of a band, 0 - 64
+    ///
+    ///  @return false if the images don't match, the format or a stage is not supported
+    bool IMPStripStreamRun(IMPCpuImage source, IMPCpuImage destination,
+                           const IMPStripStage *stages, uint32_t count, uint32_t band);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMPStripStream_Bridging_CPU_h */
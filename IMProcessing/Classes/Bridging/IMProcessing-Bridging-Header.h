@@ -14,6 +14,29 @@
 #ifndef __METAL_VERSION__
 
 #include "IMPExif.h"
+#include "IMPCpuImage-Bridging-CPU.h"
+#include "IMPCatalogAnalyzer-Bridging-CPU.h"
+#include "IMPRecursiveGaussian-Bridging-CPU.h"
+#include "IMPBoxBlur-Bridging-CPU.h"
+#include "IMPSeparableConvolution-Bridging-CPU.h"
+#include "IMPStripStream-Bridging-CPU.h"
+#include "IMPMedian-Bridging-CPU.h"
+#include "IMPMorphology-Bridging-CPU.h"
+#include "IMPAdaptiveThreshold-Bridging-CPU.h"
+#include "IMPSobelGradient-Bridging-CPU.h"
+#include "IMPCanny-Bridging-CPU.h"
+#include "IMPGaussianDerivativeEdges-Bridging-CPU.h"
+#include "IMPHarrisCorners-Bridging-CPU.h"
+#include "IMPNonMaximumSuppression-Bridging-CPU.h"
+#include "IMPHoughSpace-Bridging-CPU.h"
+#include "IMPHoughPeaks-Bridging-CPU.h"
+#include "IMPPCLines-Bridging-CPU.h"
+#include "IMPProbabilisticHough-Bridging-CPU.h"
+#include "IMPCoarseToFineHough-Bridging-CPU.h"
+#include "IMPKeyValueSort-Bridging-CPU.h"
+#include "IMPBezierWarp-Bridging-CPU.h"
+#include "IMPPerspectiveWarp-Bridging-CPU.h"
+#include "IMPExifOrientation-Bridging-CPU.h"
 
 #endif
 
@@ -0,0 +1,264 @@
+//
+//  IMPAdaptiveThreshold_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPAdaptiveThreshold_cpu.hpp"
+#include "IMPAdaptiveThreshold-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            //
+            // kIMP_Y_YUV_factor luma, the one kernel_luminance extracts. Integral samples keep an exact
+            // integral luma of their own scale.
+            //
+            inline uint32_t luma(const uint8_t *p, size_t channels) {
+                if (channels < 3) return p[0];
+                return (2125u * p[0] + 7154u * p[1] + 721u * p[2] + 5000u) / 10000u;
+            }
+
+            inline uint32_t luma(const uint16_t *p, size_t channels) {
+                if (channels < 3) return p[0];
+                return (2125u * p[0] + 7154u * p[1] + 721u * p[2] + 5000u) / 10000u;
+            }
+
+            inline double luma(const float *p, size_t channels) {
+                if (channels < 3) return p[0];
+                return 0.2125 * p[0] + 0.7154 * p[1] + 0.0721 * p[2];
+            }
+        }
+
+        template<typename T, typename F> void AdaptiveThreshold::run(const ImageView<const T> &source, F &&emit) const {
+
+            typedef decltype(luma(source.data, 1)) Value;
+            typedef typename std::conditional<std::is_integral<T>::value, uint64_t, double>::type Sum;
+
+            const size_t width    = source.width;
+            const size_t height   = source.height;
+            const size_t channels = source.channels;
+            const size_t radius   = _options.radius;
+            const size_t ring     = 2 * radius + 2;
+
+            const double scale  = PixelTraits<T>::maximum;
+            const double k      = _options.k;
+            const double offset = _options.offset * scale;
+            const double range  = std::max(double(_options.range), 1e-6) * scale;
+
+            const bool deviation = _options.method == AdaptiveThreshold::sauvola;
+
+            parallelStrips(height, std::max<size_t>(64, 4 * radius), [&](size_t begin, size_t end){
+
+                //
+                // Table row i holds the sums of the image rows [start, start + i), only the last
+                // ring rows are kept
+                //
+                const size_t start = begin > radius ? begin - radius : 0;
+
+                std::vector<Sum>     sums(ring * (width + 1), Sum(0));
+                std::vector<Sum>     squares(ring * (width + 1), Sum(0));
+                std::vector<Value>   lumas(ring * width);
+                std::vector<uint8_t> bits((width + 7) / 8);
+
+                auto sumRow    = [&](size_t i){ return sums.data()    + (i % ring) * (width + 1); };
+                auto squareRow = [&](size_t i){ return squares.data() + (i % ring) * (width + 1); };
+                auto lumaRow   = [&](size_t y){ return lumas.data()   + (y % ring) * width; };
+
+                size_t built = 0;
+
+                for (size_t y = begin; y < end; y++) {
+
+                    const size_t y1 = y > radius ? y - radius : 0;
+                    const size_t y2 = std::min(height, y + radius + 1);
+
+                    for (; start + built < y2; built++) {
+
+                        const T *p = source.row(start + built);
+                        Value   *l = lumaRow(start + built);
+
+                        const Sum *previous       = sumRow(built);
+                        const Sum *previousSquare = squareRow(built);
+                        Sum       *next           = sumRow(built + 1);
+                        Sum       *nextSquare     = squareRow(built + 1);
+
+                        Sum row = 0, rowSquare = 0;
+
+                        next[0] = nextSquare[0] = 0;
+
+                        for (size_t x = 0; x < width; x++, p += channels) {
+                            Value v = luma(p, channels);
+                            l[x] = v;
+                            row       += Sum(v);
+                            rowSquare += Sum(v) * Sum(v);
+                            next[x + 1]       = previous[x + 1] + row;
+                            nextSquare[x + 1] = previousSquare[x + 1] + rowSquare;
+                        }
+                    }
+
+                    const Sum   *a  = sumRow(y2 - start);
+                    const Sum   *b  = sumRow(y1 - start);
+                    const Sum   *a2 = squareRow(y2 - start);
+                    const Sum   *b2 = squareRow(y1 - start);
+                    const Value *l  = lumaRow(y);
+
+                    const size_t rows = y2 - y1;
+
+                    std::fill(bits.begin(), bits.end(), 0);
+
+                    for (size_t x = 0; x < width; x++) {
+
+                        const size_t x1 = x > radius ? x - radius : 0;
+                        const size_t x2 = std::min(width, x + radius + 1);
+
+                        const double count = double((x2 - x1) * rows);
+                        const double mean  = double((a[x2] - b[x2]) - (a[x1] - b[x1])) / count;
+
+                        double threshold;
+
+                        if (deviation) {
+                            double variance = double((a2[x2] - b2[x2]) - (a2[x1] - b2[x1])) / count - mean * mean;
+                            double sigma    = std::sqrt(std::max(variance, 0.0));
+                            threshold = mean * (1.0 + k * (sigma / range - 1.0)) - offset;
+                        }
+                        else {
+                            threshold = mean * (1.0 - k) - offset;
+                        }
+
+                        if (double(l[x]) < threshold) bits[x >> 3] |= uint8_t(0x80 >> (x & 7));
+                    }
+
+                    emit(y, bits.data());
+                }
+            });
+        }
+
+        template<typename T> bool AdaptiveThreshold::packed(const ImageView<const T> &source, uint8_t *mask, size_t bytesPerRow) const {
+
+            if (source.empty() || !mask || bytesPerRow < (source.width + 7) / 8) return false;
+
+            run(source, [&](size_t y, const uint8_t *bits){
+                std::copy(bits, bits + (source.width + 7) / 8, mask + y * bytesPerRow);
+            });
+
+            return true;
+        }
+
+        template<typename T> bool AdaptiveThreshold::expanded(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+
+            //
+            // Bands read the rows of their neighbours, in place thresholding needs a copy of the source
+            //
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == destination.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            const T one      = PixelTraits<T>::fromFloat(PixelTraits<T>::maximum);
+            const T zero     = T(0);
+            const size_t c   = destination.channels;
+            const size_t rgb = c == 4 ? 3 : c;
+
+            run(input, [&](size_t y, const uint8_t *bits){
+                T *out = destination.row(y);
+                for (size_t x = 0; x < destination.width; x++, out += c) {
+                    T v = (bits[x >> 3] & (0x80 >> (x & 7))) ? one : zero;
+                    for (size_t i = 0; i < rgb; i++) out[i] = v;
+                    if (c == 4) out[3] = one;
+                }
+            });
+
+            return true;
+        }
+
+        bool AdaptiveThreshold::mask(const ImageView<const uint8_t> &source, uint8_t *mask, size_t bytesPerRow) const {
+            return packed(source, mask, bytesPerRow);
+        }
+
+        bool AdaptiveThreshold::mask(const ImageView<const uint16_t> &source, uint8_t *mask, size_t bytesPerRow) const {
+            return packed(source, mask, bytesPerRow);
+        }
+
+        bool AdaptiveThreshold::mask(const ImageView<const float> &source, uint8_t *mask, size_t bytesPerRow) const {
+            return packed(source, mask, bytesPerRow);
+        }
+
+        bool AdaptiveThreshold::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return expanded(source, destination);
+        }
+
+        bool AdaptiveThreshold::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return expanded(source, destination);
+        }
+
+        bool AdaptiveThreshold::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return expanded(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static AdaptiveThreshold::Options thresholdOptions(const IMPAdaptiveThresholdOptions &options) {
+    AdaptiveThreshold::Options o;
+    o.method = options.method == IMPAdaptiveThresholdSauvola ? AdaptiveThreshold::sauvola : AdaptiveThreshold::bradley;
+    o.radius = options.radius;
+    o.k      = options.k;
+    o.offset = options.offset;
+    o.range  = options.range;
+    return o;
+}
+
+extern "C" {
+
+    bool IMPAdaptiveThresholdMask(IMPCpuImage source, uint8_t *mask, size_t bytesPerRow, IMPAdaptiveThresholdOptions options) {
+
+        AdaptiveThreshold threshold(thresholdOptions(options));
+
+        bool done = false;
+
+        dispatch(source, [&](auto view){
+            done = threshold.mask(view.readonly(), mask, bytesPerRow);
+        });
+
+        return done;
+    }
+
+    bool IMPAdaptiveThresholdApply(IMPCpuImage source, IMPCpuImage destination, IMPAdaptiveThresholdOptions options) {
+
+        if (source.format != destination.format) return false;
+
+        AdaptiveThreshold threshold(thresholdOptions(options));
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = threshold.apply(view, target);
+        });
+
+        return done;
+    }
+}
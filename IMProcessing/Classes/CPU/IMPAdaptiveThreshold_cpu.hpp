@@ -0,0 +1,85 @@
+//
+//  IMPAdaptiveThreshold_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPAdaptiveThreshold_cpu_hpp
+#define IMPAdaptiveThreshold_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Local threshold of luma against the mean (and deviation) of the (2*radius+1)^2 window around
+        /// every pixel. Luma is extracted while the summed-area table is built, the table is exact 64-bit
+        /// integers for 8 and 16-bit images and doubles for float ones, so the window statistics cost
+        /// O(1) per pixel. Only 2*radius+2 rows of the table are kept, bands of rows run in parallel.
+        /// Windows are clipped by the image edges.
+        ///
+        /// Pixels darker than the threshold are the foreground, the same as kernel_adaptiveThreshold
+        /// writes 1 for.
+        ///
+        class AdaptiveThreshold {
+
+        public:
+
+            enum Method {
+                /// Bradley - Roth: mean * (1 - k) - offset
+                bradley,
+                /// Sauvola: mean * (1 + k * (deviation / range - 1)) - offset
+                sauvola
+            };
+
+            struct Options {
+                Method method = bradley;
+                size_t radius = 4;
+                float  k      = 0.0f;
+                /// Normalized luma units, 0.05 is what kernel_adaptiveThreshold subtracts
+                float  offset = 0.05f;
+                /// Dynamic range of the deviation in normalized luma units
+                float  range  = 0.5f;
+            };
+
+            explicit AdaptiveThreshold(const Options &options): _options(options) {}
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Bit packed mask, rows of (width + 7) / 8 bytes at least. The first pixel of a row is the
+            /// most significant bit of its first byte, set bits are the foreground.
+            ///
+            bool mask(const ImageView<const uint8_t>  &source, uint8_t *mask, size_t bytesPerRow) const;
+            bool mask(const ImageView<const uint16_t> &source, uint8_t *mask, size_t bytesPerRow) const;
+            bool mask(const ImageView<const float>    &source, uint8_t *mask, size_t bytesPerRow) const;
+
+            ///
+            /// Mask expanded to the destination: foreground pixels are 1 and the rest 0 in every colour
+            /// channel, alpha is 1. Source and destination may be the same image.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T, typename F> void run(const ImageView<const T> &source, F &&row) const;
+
+            template<typename T> bool packed(const ImageView<const T> &source, uint8_t *mask, size_t bytesPerRow) const;
+            template<typename T> bool expanded(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPAdaptiveThreshold_cpu_hpp */
@@ -0,0 +1,161 @@
+//
+//  IMPBezierWarp_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPBezierWarp_cpu.hpp"
+#include "IMPBezierWarp-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSampler_cpu.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            inline void bernstein(double t, double b[4]) {
+                const double s = 1.0 - t;
+                b[0] = s * s * s;
+                b[1] = 3.0 * t * s * s;
+                b[2] = 3.0 * t * t * s;
+                b[3] = t * t * t;
+            }
+
+            //
+            // Cubic stepped by forward differences from u0 with the step h
+            //
+            struct Steps {
+
+                double f, d1, d2, d3;
+
+                Steps(const double a[4], double u0, double h) {
+                    auto at = [&](double u){ return ((a[3] * u + a[2]) * u + a[1]) * u + a[0]; };
+                    const double f0 = at(u0), f1 = at(u0 + h), f2 = at(u0 + 2 * h), f3 = at(u0 + 3 * h);
+                    f  = f0;
+                    d1 = f1 - f0;
+                    d2 = f2 - 2 * f1 + f0;
+                    d3 = f3 - 3 * f2 + 3 * f1 - f0;
+                }
+
+                inline void next() { f += d1; d1 += d2; d2 += d3; }
+            };
+        }
+
+        BezierWarp::BezierWarp(const Surface &surface, const float background[4]): _surface(surface) {
+            for (int c = 0; c < 4; c++) _background[c] = background ? background[c] : 0.0f;
+        }
+
+        template<typename T> bool BezierWarp::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.channels != destination.channels) return false;
+            if (source.channels != 1 && source.channels != 4) return false;
+
+            const size_t width    = destination.width;
+            const size_t height   = destination.height;
+            const size_t channels = source.channels;
+            const double scale[2] = { double(source.width), double(source.height) };
+
+            const float  maximum = PixelTraits<T>::maximum;
+            const Vec4f  background(_background[0] * maximum, _background[1] * maximum,
+                                    _background[2] * maximum, _background[3] * maximum);
+
+            const BilinearSampler<T> sampler(source);
+
+            const double h = 1.0 / double(width);
+
+            parallelStrips(height, 16, [&](size_t begin, size_t end){
+
+                for (size_t y = begin; y < end; y++) {
+
+                    //
+                    // Row points c[j] = sum P[i][j] b_i(v) in source texels, then the power basis of
+                    // sum c[j] b_j(u)
+                    //
+                    double bv[4];
+                    bernstein((double(y) + 0.5) / double(height), bv);
+
+                    double a[2][4];
+
+                    for (int k = 0; k < 2; k++) {
+
+                        double c[4];
+                        for (int j = 0; j < 4; j++) {
+                            c[j] = 0;
+                            for (int i = 0; i < 4; i++) c[j] += double(_surface.points[i][j][k]) * bv[i];
+                            c[j] = c[j] * scale[k] - 0.5;
+                        }
+
+                        a[k][0] = c[0];
+                        a[k][1] = 3.0 * (c[1] - c[0]);
+                        a[k][2] = 3.0 * (c[0] - 2.0 * c[1] + c[2]);
+                        a[k][3] = c[3] - c[0] + 3.0 * (c[1] - c[2]);
+                    }
+
+                    Steps sx(a[0], 0.5 * h, h), sy(a[1], 0.5 * h, h);
+
+                    T *out = destination.row(y);
+
+                    if (channels == 4) {
+                        for (size_t x = 0; x < width; x++, sx.next(), sy.next()) {
+                            Vec4f color = sampler.rgba(float(sx.f), float(sy.f));
+                            if (color[3] == 0.0f) color = background;
+                            storePixel(color, out + x * 4);
+                        }
+                    }
+                    else {
+                        for (size_t x = 0; x < width; x++, sx.next(), sy.next())
+                            out[x] = PixelTraits<T>::fromFloat(sampler.gray(float(sx.f), float(sy.f)));
+                    }
+                }
+            });
+
+            return true;
+        }
+
+        bool BezierWarp::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool BezierWarp::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool BezierWarp::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPBezierWarp(IMPCpuImage source, IMPCpuImage destination, const float *surface, const float *background) {
+
+        if (!surface || source.format != destination.format) return false;
+
+        BezierWarp::Surface net;
+        std::copy(surface, surface + 32, &net.points[0][0][0]);
+
+        const BezierWarp warp(net, background);
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = warp.apply(view, target);
+        });
+
+        return done;
+    }
+}
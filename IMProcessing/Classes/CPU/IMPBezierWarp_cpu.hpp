@@ -0,0 +1,71 @@
+//
+//  IMPBezierWarp_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPBezierWarp_cpu_hpp
+#define IMPBezierWarp_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Bicubic Bézier surface warp of fragment_bezierWarpTransformation: the destination pixel at
+        /// (u, v) samples the source at Q(u, v) = sum P[i][j] b_i(v) b_j(u), b the cubic Bernstein
+        /// polynomials, with the bilinear clamp to edge sampler; a sample of zero alpha takes the
+        /// background.
+        ///
+        /// The net is contracted with b_i(v) once per row, leaving a cubic in u that is stepped
+        /// along the row by forward differences, three adds per pixel, in double so the steps do
+        /// not drift over wide rows. Rows are split between threads.
+        ///
+        class BezierWarp {
+
+        public:
+
+            ///
+            /// IMPFloat2x4x4 control points in normalized source coordinates, points[i][j] is the
+            /// j-th point along u of the i-th row along v
+            ///
+            struct Surface {
+                float points[4][4][2];
+            };
+
+            ///
+            /// Background RGBA in [0, 1] of the pixel range, nullptr is transparent black
+            ///
+            BezierWarp(const Surface &surface, const float background[4]);
+
+            explicit BezierWarp(const Surface &surface): BezierWarp(surface, nullptr) {}
+
+            inline const Surface &surface() const { return _surface; }
+
+            ///
+            /// Warp source into destination of any size, both have the same channels (1 or 4) and
+            /// must not overlap. Returns false if the layouts don't match.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            Surface _surface;
+            float   _background[4];
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPBezierWarp_cpu_hpp */
@@ -0,0 +1,261 @@
+//
+//  IMPBoxBlur_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPBoxBlur_cpu.hpp"
+#include "IMPBoxBlur-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        //
+        // Columns of the vertical pass handled by one strip, in floats
+        //
+        static const size_t verticalStrip = 256;
+
+        BoxBlur::BoxBlur(size_t radius): _radii(1, radius) {}
+
+        BoxBlur::BoxBlur(const std::vector<size_t> &radii): _radii(radii) {}
+
+        std::vector<size_t> BoxBlur::gaussianRadii(float sigma, size_t passes) {
+
+            std::vector<size_t> radii;
+
+            if (!(sigma > 0) || passes == 0) return radii;
+
+            double n        = double(passes);
+            double variance = 12.0 * double(sigma) * double(sigma);
+
+            long lower = long(std::floor(std::sqrt(variance / n + 1.0)));
+            if (lower % 2 == 0) lower--;
+            lower = std::max(lower, 1L);
+
+            long upper = lower + 2;
+
+            //
+            // Number of passes using the lower width, the rest use the upper one
+            //
+            double ideal = (variance - n * lower * lower - 4.0 * n * lower - 3.0 * n) / (-4.0 * lower - 4.0);
+            long   m     = std::max(0L, std::min(long(passes), long(std::lround(ideal))));
+
+            for (size_t i = 0; i < passes; i++) {
+                long width = long(i) < m ? lower : upper;
+                radii.push_back(size_t(width - 1) / 2);
+            }
+
+            return radii;
+        }
+
+        BoxBlur BoxBlur::gaussian(float sigma, size_t passes) {
+            //
+            // Zero radius boxes are identities, small sigmas don't need them
+            //
+            std::vector<size_t> radii = gaussianRadii(sigma, passes);
+            radii.erase(std::remove(radii.begin(), radii.end(), size_t(0)), radii.end());
+            return BoxBlur(radii);
+        }
+
+        //
+        // One box pass over `count` four lane elements: RGBA pixels or four packed rows.
+        // Sums are kept in double, so integral samples are summed exactly at any radius.
+        //
+        static void boxLine(const float *source, float *destination, size_t count, size_t radius) {
+
+            const size_t last  = count - 1;
+            const Vec4d  scale(1.0 / double(2 * radius + 1));
+
+            Vec4d sum = Vec4d::load(source) * Vec4d(double(radius + 1));
+
+            for (size_t k = 1; k <= radius; k++) sum = sum + Vec4d::load(source + std::min(k, last) * 4);
+
+            for (size_t x = 0; x < count; x++) {
+                (sum * scale).store(destination + x * 4);
+                size_t add = std::min(x + radius + 1, last);
+                size_t sub = x >= radius ? x - radius : 0;
+                sum = sum + Vec4d::load(source + add * 4) - Vec4d::load(source + sub * 4);
+            }
+        }
+
+        //
+        // Horizontal passes: every row goes through all the boxes while it stays in cache.
+        // RGBA keeps a pixel in one vector, one channel planes pack four rows into the lanes.
+        //
+        template<typename T> static void horizontal(const ImageView<const T> &source,
+                                                    const ImageView<float> &destination,
+                                                    const std::vector<size_t> &radii) {
+
+            size_t width  = source.width;
+            size_t height = source.height;
+
+            auto filter = [&](AlignedBuffer<float> &line, AlignedBuffer<float> &temp) -> float* {
+                float *a = line.data(), *b = temp.data();
+                for (size_t r: radii) {
+                    boxLine(a, b, width, r);
+                    std::swap(a, b);
+                }
+                return a;
+            };
+
+            if (source.channels == 4) {
+                parallelStrips(height, 16, [&](size_t begin, size_t end){
+                    AlignedBuffer<float> line(width * 4), temp(width * 4);
+                    for (size_t y = begin; y < end; y++) {
+                        loadRow(source.row(y), line.data(), width * 4);
+                        const float *result = filter(line, temp);
+                        std::copy(result, result + width * 4, destination.row(y));
+                    }
+                });
+                return;
+            }
+
+            size_t quads = (height + 3) / 4;
+
+            parallelStrips(quads, 4, [&](size_t begin, size_t end){
+                AlignedBuffer<float> line(width * 4), temp(width * 4), row(width);
+                for (size_t q = begin; q < end; q++) {
+
+                    size_t y0 = q * 4;
+
+                    for (size_t lane = 0; lane < 4; lane++) {
+                        size_t y = std::min(y0 + lane, height - 1);
+                        loadRow(source.row(y), row.data(), width);
+                        for (size_t x = 0; x < width; x++) line[x * 4 + lane] = row[x];
+                    }
+
+                    const float *result = filter(line, temp);
+
+                    for (size_t lane = 0; lane < 4 && y0 + lane < height; lane++) {
+                        float *out = destination.row(y0 + lane);
+                        for (size_t x = 0; x < width; x++) out[x] = result[x * 4 + lane];
+                    }
+                }
+            });
+        }
+
+        //
+        // Vertical pass: rows stream through, every column strip keeps its running sums
+        //
+        template<typename T> static void vertical(const ImageView<const float> &source,
+                                                  const ImageView<T> &destination,
+                                                  size_t radius) {
+
+            size_t elements = source.rowElements();
+            size_t height   = source.height;
+            size_t last     = height - 1;
+            size_t groups   = (elements + verticalStrip - 1) / verticalStrip;
+            double scale    = 1.0 / double(2 * radius + 1);
+
+            parallelFor(groups, [&](size_t g){
+
+                size_t begin = g * verticalStrip;
+                size_t count = std::min(elements, begin + verticalStrip) - begin;
+
+                double sum[verticalStrip];
+                float  line[verticalStrip];
+
+                const float *top = source.row(0) + begin;
+                for (size_t i = 0; i < count; i++) sum[i] = double(top[i]) * double(radius + 1);
+
+                for (size_t k = 1; k <= radius; k++) {
+                    const float *p = source.row(std::min(k, last)) + begin;
+                    for (size_t i = 0; i < count; i++) sum[i] += p[i];
+                }
+
+                for (size_t y = 0; y < height; y++) {
+
+                    for (size_t i = 0; i < count; i++) line[i] = float(sum[i] * scale);
+                    storeRow(line, destination.row(y) + begin, count);
+
+                    const float *add = source.row(std::min(y + radius + 1, last)) + begin;
+                    const float *sub = source.row(y >= radius ? y - radius : 0) + begin;
+                    for (size_t i = 0; i < count; i++) sum[i] += double(add[i]) - double(sub[i]);
+                }
+            });
+        }
+
+        template<typename T> bool BoxBlur::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+            if (source.channels != 1 && source.channels != 4) return false;
+
+            if (_radii.empty()) {
+                if (static_cast<const void*>(source.data) != destination.data) {
+                    for (size_t y = 0; y < source.height; y++)
+                        std::copy(source.row(y), source.row(y) + source.rowElements(), destination.row(y));
+                }
+                return true;
+            }
+
+            Image<float> plane(source.width, source.height, source.channels);
+            Image<float> temp;
+
+            horizontal(source, plane.view(), _radii);
+
+            if (_radii.size() > 1) temp.resize(source.width, source.height, source.channels);
+
+            ImageView<float> in = plane.view(), out = temp.view();
+
+            for (size_t i = 0; i + 1 < _radii.size(); i++) {
+                vertical(in.readonly(), out, _radii[i]);
+                std::swap(in, out);
+            }
+
+            vertical(in.readonly(), destination, _radii.back());
+
+            return true;
+        }
+
+        bool BoxBlur::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool BoxBlur::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool BoxBlur::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static bool applyBoxBlur(const BoxBlur &blur, const IMPCpuImage &source, const IMPCpuImage &destination) {
+
+    if (source.format != destination.format) return false;
+
+    bool done = false;
+
+    dispatch(destination, [&](auto target){
+        typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+        ImageView<const T> view(static_cast<const T*>(source.data),
+                                source.width, source.height, target.channels, source.bytesPerRow);
+        done = blur.apply(view, target);
+    });
+
+    return done;
+}
+
+extern "C" {
+
+    bool IMPRunningSumBoxBlur(IMPCpuImage source, IMPCpuImage destination, uint32_t radius) {
+        return applyBoxBlur(BoxBlur(radius), source, destination);
+    }
+
+    bool IMPStackedBoxGaussianBlur(IMPCpuImage source, IMPCpuImage destination, float sigma, uint32_t passes) {
+        return applyBoxBlur(BoxBlur::gaussian(sigma, passes), source, destination);
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  IMPBoxBlur_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPBoxBlur_cpu_hpp
+#define IMPBoxBlur_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Running sum box filter: every pass adds the sample entering the window and subtracts
+        /// the one leaving it, so the cost does not depend on the radius. Rows are filtered first,
+        /// then columns stream through with one accumulator per column. Edges are replicated.
+        ///
+        /// Several passes make a stacked box approximation of a gaussian.
+        ///
+        class BoxBlur {
+
+        public:
+
+            /// One box pass of (2*radius+1) x (2*radius+1) window
+            explicit BoxBlur(size_t radius);
+
+            /// Box passes applied one after another
+            explicit BoxBlur(const std::vector<size_t> &radii);
+
+            ///
+            /// Radii of `passes` boxes whose convolution has the closest variance to sigma^2
+            /// (P. Kovesi, "Fast Almost-Gaussian Filtering").
+            ///
+            static std::vector<size_t> gaussianRadii(float sigma, size_t passes = 3);
+
+            /// Stacked box gaussian approximation, 3 - 5 passes are usually enough
+            static BoxBlur gaussian(float sigma, size_t passes = 3);
+
+            inline const std::vector<size_t> &radii() const { return _radii; }
+
+            ///
+            /// Blur source into destination, both must have the same size and channels (1 or 4).
+            /// Source and destination may be the same image. Returns false if the layouts don't match.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            std::vector<size_t> _radii;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPBoxBlur_cpu_hpp */
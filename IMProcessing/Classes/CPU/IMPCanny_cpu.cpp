@@ -0,0 +1,318 @@
+//
+//  IMPCanny_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPCanny_cpu.hpp"
+#include "IMPCanny-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPRecursiveGaussian_cpu.hpp"
+#include "IMPSobelGradient_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            enum Label : uint8_t {
+                none   = 0,
+                weak   = 1,
+                strong = 2,
+                edge   = 3
+            };
+
+            //
+            // kIMP_Y_YUV_factor, the kernel_luminance stage
+            //
+            template<typename T> void lumaRow(const T *p, size_t width, size_t channels, float *luma) {
+
+                const float scale = 1.0f / PixelTraits<T>::maximum;
+
+                if (channels < 3) {
+                    for (size_t x = 0; x < width; x++, p += channels) luma[x] = float(p[0]) * scale;
+                    return;
+                }
+
+                const float r = 0.2125f * scale, g = 0.7154f * scale, b = 0.0721f * scale;
+
+                for (size_t x = 0; x < width; x++, p += channels)
+                    luma[x] = r * float(p[0]) + g * float(p[1]) + b * float(p[2]);
+            }
+
+            //
+            // Sobel gradient of one pixel for the edgel slopes, edges are replicated
+            //
+            inline void gradient(const ImageView<const float> &luma, size_t x, size_t y, float &gx, float &gy) {
+
+                const size_t x0 = x > 0 ? x - 1 : 0, x2 = std::min(x + 1, luma.width  - 1);
+                const size_t y0 = y > 0 ? y - 1 : 0, y2 = std::min(y + 1, luma.height - 1);
+
+                const float *t = luma.row(y0), *m = luma.row(y), *b = luma.row(y2);
+
+                gx = (t[x2] - t[x0]) + 2.0f * (m[x2] - m[x0]) + (b[x2] - b[x0]);
+                gy = (t[x0] - b[x0]) + 2.0f * (t[x]  - b[x])  + (t[x2] - b[x2]);
+            }
+        }
+
+        template<typename T> void Canny::run(const ImageView<const T> &source, std::vector<uint8_t> &labels, std::vector<Edgel> *edgels) const {
+
+            const size_t width  = source.width;
+            const size_t height = source.height;
+
+            Image<float> luma;
+            luma.resize(width, height, 1);
+
+            ImageView<float> lumaView = luma.view();
+
+            parallelStrips(height, 64, [&](size_t begin, size_t end){
+                for (size_t y = begin; y < end; y++) lumaRow(source.row(y), width, source.channels, lumaView.row(y));
+            });
+
+            if (_options.blurRadius > 0) {
+                RecursiveGaussian(_options.blurRadius).apply(lumaView.readonly(), lumaView);
+            }
+
+            Image<float> magnitude, direction;
+            magnitude.resize(width, height, 1);
+            direction.resize(width, height, 2);
+
+            const ImageView<float> magnitudeView = magnitude.view();
+            const ImageView<float> directionView = direction.view();
+
+            SobelGradient().apply(lumaView.readonly(), magnitudeView, directionView);
+
+            //
+            // Non maximum suppression along the quantized gradient. The direction y component is
+            // measured upwards (IMPSobelEdges.Gy is top minus bottom) while rows go down. Ties keep
+            // the first pixel only, so a step between two pixels stays one pixel thick.
+            //
+            labels.assign(width * height, none);
+
+            const float upper = _options.upperThreshold;
+            const float lower = _options.lowerThreshold;
+
+            parallelStrips(height, 32, [&](size_t begin, size_t end){
+                for (size_t y = begin; y < end; y++) {
+
+                    const float *m = magnitudeView.row(y);
+                    const float *d = directionView.row(y);
+
+                    uint8_t *label = labels.data() + y * width;
+
+                    for (size_t x = 0; x < width; x++, d += 2) {
+
+                        const float value = m[x];
+
+                        if (!(value > lower)) continue;
+
+                        const long dx =  long(std::lround(d[0] * 2.0f - 1.0f));
+                        const long dy = -long(std::lround(d[1] * 2.0f - 1.0f));
+
+                        const long w = long(width) - 1, h = long(height) - 1;
+
+                        const long x1 = std::min(std::max(long(x) + dx, 0L), w), y1 = std::min(std::max(long(y) + dy, 0L), h);
+                        const long x2 = std::min(std::max(long(x) - dx, 0L), w), y2 = std::min(std::max(long(y) - dy, 0L), h);
+
+                        if (magnitudeView.row(y1)[x1] > value || magnitudeView.row(y2)[x2] >= value) continue;
+
+                        label[x] = value >= upper ? strong : weak;
+                    }
+                }
+            });
+
+            //
+            // Hysteresis: every strong pixel floods its 8-connected weak neighbours, a pixel enters
+            // the worklist once
+            //
+            std::vector<size_t> worklist;
+
+            for (size_t i = 0, count = width * height; i < count; i++) {
+
+                if (labels[i] != strong) continue;
+
+                labels[i] = edge;
+                worklist.push_back(i);
+
+                while (!worklist.empty()) {
+
+                    const size_t index = worklist.back();
+                    worklist.pop_back();
+
+                    const size_t x = index % width, y = index / width;
+
+                    const size_t xb = x > 0 ? x - 1 : 0, xe = std::min(x + 1, width  - 1);
+                    const size_t yb = y > 0 ? y - 1 : 0, ye = std::min(y + 1, height - 1);
+
+                    for (size_t v = yb; v <= ye; v++) {
+                        uint8_t *label = labels.data() + v * width;
+                        for (size_t u = xb; u <= xe; u++) {
+                            if (label[u] == weak || label[u] == strong) {
+                                label[u] = edge;
+                                worklist.push_back(v * width + u);
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (auto &label: labels) label = label == edge ? 1 : 0;
+
+            if (!edgels) return;
+
+            for (size_t y = 0; y < height; y++) {
+                const uint8_t *label = labels.data() + y * width;
+                for (size_t x = 0; x < width; x++) {
+
+                    if (!label[x]) continue;
+
+                    float gx, gy;
+                    gradient(lumaView.readonly(), x, y, gx, gy);
+
+                    float length = std::sqrt(gx * gx + gy * gy);
+                    if (length > 0) { gx /= length; gy /= length; }
+
+                    edgels->push_back(Edgel{ float(x) / float(width), float(y) / float(height), gx, gy });
+                }
+            }
+        }
+
+        template<typename T> bool Canny::masked(const ImageView<const T> &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels) const {
+
+            if (source.empty() || mask.empty()) return false;
+            if (source.width != mask.width || source.height != mask.height || mask.channels != 1) return false;
+
+            std::vector<uint8_t> labels;
+
+            run(source, labels, edgels);
+
+            for (size_t y = 0; y < mask.height; y++) {
+                const uint8_t *label = labels.data() + y * mask.width;
+                uint8_t       *out   = mask.row(y);
+                for (size_t x = 0; x < mask.width; x++) out[x] = label[x] ? 255 : 0;
+            }
+
+            return true;
+        }
+
+        template<typename T> bool Canny::expanded(const ImageView<const T> &source, const ImageView<T> &destination, std::vector<Edgel> *edgels) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+
+            //
+            // The source is read into the luma plane before anything is written, in place is safe
+            //
+            std::vector<uint8_t> labels;
+
+            run(source, labels, edgels);
+
+            const T one      = PixelTraits<T>::fromFloat(PixelTraits<T>::maximum);
+            const size_t c   = destination.channels;
+            const size_t rgb = c == 4 ? 3 : c;
+
+            parallelStrips(destination.height, 64, [&](size_t begin, size_t end){
+                for (size_t y = begin; y < end; y++) {
+                    const uint8_t *label = labels.data() + y * destination.width;
+                    T *out = destination.row(y);
+                    for (size_t x = 0; x < destination.width; x++, out += c) {
+                        T v = label[x] ? one : T(0);
+                        for (size_t i = 0; i < rgb; i++) out[i] = v;
+                        if (c == 4) out[3] = one;
+                    }
+                }
+            });
+
+            return true;
+        }
+
+        bool Canny::edges(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels) const {
+            return masked(source, mask, edgels);
+        }
+
+        bool Canny::edges(const ImageView<const uint16_t> &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels) const {
+            return masked(source, mask, edgels);
+        }
+
+        bool Canny::edges(const ImageView<const float> &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels) const {
+            return masked(source, mask, edgels);
+        }
+
+        bool Canny::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination, std::vector<Edgel> *edgels) const {
+            return expanded(source, destination, edgels);
+        }
+
+        bool Canny::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination, std::vector<Edgel> *edgels) const {
+            return expanded(source, destination, edgels);
+        }
+
+        bool Canny::apply(const ImageView<const float> &source, const ImageView<float> &destination, std::vector<Edgel> *edgels) const {
+            return expanded(source, destination, edgels);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static_assert(sizeof(Canny::Edgel) == sizeof(IMPCpuEdgel), "IMPCpuEdgel must keep the IMPEdgel layout");
+
+static Canny::Options cannyOptions(const IMPCannyOptions &options) {
+    Canny::Options o;
+    o.blurRadius     = options.blurRadius;
+    o.upperThreshold = options.upperThreshold;
+    o.lowerThreshold = options.lowerThreshold;
+    return o;
+}
+
+extern "C" {
+
+    bool IMPCannyApply(IMPCpuImage source, IMPCpuImage destination, IMPCannyOptions options) {
+
+        if (source.format != destination.format) return false;
+
+        Canny canny(cannyOptions(options));
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = canny.apply(view, target);
+        });
+
+        return done;
+    }
+
+    size_t IMPCannyEdgels(IMPCpuImage source, IMPCpuEdgel *edgels, size_t capacity, IMPCannyOptions options) {
+
+        Canny canny(cannyOptions(options));
+
+        std::vector<Canny::Edgel> found;
+
+        dispatch(source, [&](auto view){
+            Image<uint8_t> mask;
+            mask.resize(view.width, view.height, 1);
+            canny.edges(view.readonly(), mask.view(), &found);
+        });
+
+        const size_t count = std::min(capacity, found.size());
+
+        for (size_t i = 0; edgels && i < count; i++) {
+            edgels[i].position[0] = found[i].x;
+            edgels[i].position[1] = found[i].y;
+            edgels[i].slope[0]    = found[i].dx;
+            edgels[i].slope[1]    = found[i].dy;
+        }
+
+        return found.size();
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  IMPCanny_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCanny_cpu_hpp
+#define IMPCanny_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Canny edges with the IMPCannyEdges stages: luma, gaussian blur, Sobel gradient and
+        /// directional non maximum suppression, by bands of rows in parallel. Hysteresis is exact:
+        /// strong pixels seed a worklist that walks every 8-connected weak pixel once, instead of
+        /// the one neighbourhood step fragment_weakPixelInclusion makes per pass.
+        ///
+        class Canny {
+
+        public:
+
+            struct Options {
+                /// Gaussian sigma of the luma, IMPCannyEdges.defaultBlurRadius; 0 skips the blur
+                float blurRadius     = 2.0f;
+                /// Normalized gradient magnitude which starts an edge
+                float upperThreshold = 0.4f;
+                /// Normalized gradient magnitude an edge may continue through
+                float lowerThreshold = 0.1f;
+            };
+
+            ///
+            /// IMPEdgel layout: position in normalized texture coordinates, slope is the unit gradient
+            /// with the IMPSobelEdges.Gx/Gy signs
+            ///
+            struct Edgel {
+                float x, y;
+                float dx, dy;
+            };
+
+            explicit Canny(const Options &options): _options(options) {}
+
+            Canny(): Canny(Options()) {}
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// One byte per pixel mask: 255 on edges, 0 elsewhere. Edgels, if requested, are appended
+            /// in raster order.
+            ///
+            bool edges(const ImageView<const uint8_t>  &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels = nullptr) const;
+            bool edges(const ImageView<const uint16_t> &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels = nullptr) const;
+            bool edges(const ImageView<const float>    &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels = nullptr) const;
+
+            ///
+            /// IMPCannyEdges layout: 1 in colour channels of edges, 0 elsewhere and alpha 1.
+            /// Source and destination may be the same image.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination, std::vector<Edgel> *edgels = nullptr) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination, std::vector<Edgel> *edgels = nullptr) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination, std::vector<Edgel> *edgels = nullptr) const;
+
+        private:
+
+            ///
+            /// Labels of width * height bytes, non zero on edges
+            ///
+            template<typename T> void run(const ImageView<const T> &source, std::vector<uint8_t> &labels, std::vector<Edgel> *edgels) const;
+
+            template<typename T> bool masked(const ImageView<const T> &source, const ImageView<uint8_t> &mask, std::vector<Edgel> *edgels) const;
+            template<typename T> bool expanded(const ImageView<const T> &source, const ImageView<T> &destination, std::vector<Edgel> *edgels) const;
+
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPCanny_cpu_hpp */
@@ -0,0 +1,361 @@
+//
+//  IMPCatalogAnalyzer_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPCatalogAnalyzer_cpu.hpp"
+#include "IMPCatalogAnalyzer-Bridging-CPU.h"
+#include "IMPWorkerPool_cpu.hpp"
+
+#include "turbojpeg.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        struct CatalogAnalyzer::Worker {
+
+            tjhandle                   decoder = nullptr;
+            std::vector<unsigned char> file;
+            AlignedBuffer<uint8_t>     pixels;
+            Histogram                  histogram;
+
+            ~Worker() {
+                if (decoder) tjDestroy(decoder);
+            }
+        };
+
+        static bool readFile(const std::string &path, std::vector<unsigned char> &data) {
+
+            FILE *f = fopen(path.c_str(), "rb");
+            if (!f) return false;
+
+            bool ok = fseek(f, 0, SEEK_END) == 0;
+            long length = ok ? ftell(f) : -1;
+            ok = ok && length > 0 && fseek(f, 0, SEEK_SET) == 0;
+
+            if (ok) {
+                data.resize(size_t(length));
+                ok = fread(data.data(), 1, size_t(length), f) == size_t(length);
+            }
+
+            fclose(f);
+            return ok;
+        }
+
+        //
+        // The smallest turbojpeg scaling factor which keeps min(width,height) >= minimumSide
+        //
+        static tjscalingfactor scalingFactor(int width, int height, size_t minimumSide) {
+
+            tjscalingfactor best = {1, 1};
+
+            if (minimumSide == 0) return best;
+
+            int count = 0;
+            tjscalingfactor *factors = tjGetScalingFactors(&count);
+            if (!factors) return best;
+
+            long bestArea = long(width) * long(height);
+
+            for (int i = 0; i < count; i++) {
+                tjscalingfactor f = factors[i];
+                if (f.num > f.denom) continue;
+
+                int w = TJSCALED(width, f);
+                int h = TJSCALED(height, f);
+
+                if (size_t(std::min(w, h)) < minimumSide) continue;
+
+                if (long(w) * long(h) < bestArea) {
+                    bestArea = long(w) * long(h);
+                    best = f;
+                }
+            }
+            return best;
+        }
+
+        CatalogAnalyzer::CatalogAnalyzer(const CatalogAnalyzerOptions &options): _options(options) {
+            if (_options.workers == 0)    _options.workers = concurrency();
+            if (_options.queueDepth == 0) _options.queueDepth = _options.workers * 2;
+            _workers.reset(new Worker[_options.workers]);
+        }
+
+        CatalogAnalyzer::~CatalogAnalyzer() {}
+
+        bool CatalogAnalyzer::analyze(const std::string &path, size_t worker, CatalogAnalysis &result) {
+
+            Worker &w = _workers[worker % _options.workers];
+
+            result.path = path;
+
+            if (!readFile(path, w.file)) {
+                result.error = "could not read file";
+                return false;
+            }
+
+            if (!w.decoder && !(w.decoder = tjInitDecompress())) {
+                result.error = "could not create decoder";
+                return false;
+            }
+
+            int width = 0, height = 0, subsamp = 0, colorspace = 0;
+
+            if (tjDecompressHeader3(w.decoder, w.file.data(), (unsigned long)w.file.size(),
+                                    &width, &height, &subsamp, &colorspace) != 0) {
+                result.error = tjGetErrorStr();
+                return false;
+            }
+
+            tjscalingfactor factor = scalingFactor(width, height, _options.minimumSide);
+
+            int dw = TJSCALED(width, factor);
+            int dh = TJSCALED(height, factor);
+
+            w.pixels.resize(size_t(dw) * size_t(dh) * 3);
+
+            int flags = _options.fastDecoding ? (TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) : 0;
+
+            if (tjDecompress2(w.decoder, w.file.data(), (unsigned long)w.file.size(),
+                              w.pixels.data(), dw, 0, dh, TJPF_RGB, flags) != 0) {
+                result.error = tjGetErrorStr();
+                return false;
+            }
+
+            result.width  = size_t(width);
+            result.height = size_t(height);
+            result.decodedWidth  = size_t(dw);
+            result.decodedHeight = size_t(dh);
+
+            w.histogram.clear();
+            w.histogram.accumulate(ImageView<const uint8_t>(w.pixels.data(), size_t(dw), size_t(dh), 3),
+                                   _options.region);
+
+            result.range.shadows    = _options.shadowsClipping;
+            result.range.highlights = _options.highlightsClipping;
+            result.range.solve(w.histogram);
+            result.zones.solve(w.histogram);
+            result.dominantColor.solve(w.histogram);
+
+            return true;
+        }
+
+        //
+        // Records written between two flushes of the output, one per record costs a system call
+        // per image
+        //
+        static const size_t flushRecords = 64;
+
+        size_t CatalogAnalyzer::run(std::istream &catalog, std::ostream &output) {
+
+            std::mutex          outputMutex;
+            std::atomic<size_t> processed(0);
+
+            WorkerPool pool(_options.workers, _options.queueDepth);
+
+            std::string line;
+            size_t      index = 0;
+
+            while (std::getline(catalog, line)) {
+
+                while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+                    line.pop_back();
+
+                if (line.empty()) continue;
+
+                pool.submit([this, &outputMutex, &output, &processed, path = line, i = index](size_t worker){
+
+                    CatalogAnalysis result;
+                    result.index = i;
+                    analyze(path, worker, result);
+
+                    std::string json = result.json();
+                    json.push_back('\n');
+
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    output.write(json.data(), std::streamsize(json.size()));
+                    if (++processed % flushRecords == 0) output.flush();
+                });
+
+                index++;
+            }
+
+            pool.wait();
+            output.flush();
+
+            return processed;
+        }
+
+        //
+        // JSON
+        //
+
+        static void appendString(std::string &out, const std::string &value) {
+            out.push_back('"');
+            for (unsigned char c: value) {
+                switch (c) {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n";  break;
+                    case '\r': out += "\\r";  break;
+                    case '\t': out += "\\t";  break;
+                    default:
+                        if (c < 0x20) {
+                            char buf[8];
+                            snprintf(buf, sizeof(buf), "\\u%04x", c);
+                            out += buf;
+                        }
+                        else {
+                            out.push_back(char(c));
+                        }
+                }
+            }
+            out.push_back('"');
+        }
+
+        static void appendNumber(std::string &out, double value) {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%.6g", std::isfinite(value) ? value : 0.0);
+            out += buf;
+        }
+
+        //
+        // Indexes and sizes stay exact integers whatever their magnitude
+        //
+        static void appendInteger(std::string &out, size_t value) {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%zu", value);
+            out += buf;
+        }
+
+        static void appendArray(std::string &out, const float *values, size_t count) {
+            out.push_back('[');
+            for (size_t i = 0; i < count; i++) {
+                if (i) out.push_back(',');
+                appendNumber(out, values[i]);
+            }
+            out.push_back(']');
+        }
+
+        std::string CatalogAnalysis::json() const {
+
+            std::string out;
+            out.reserve(512);
+
+            out += "{\"index\":";
+            appendInteger(out, index);
+            out += ",\"path\":";
+            appendString(out, path);
+
+            if (!ok()) {
+                out += ",\"error\":";
+                appendString(out, error);
+                out.push_back('}');
+                return out;
+            }
+
+            out += ",\"size\":[";
+            appendInteger(out, width);  out.push_back(',');
+            appendInteger(out, height); out += "]";
+
+            out += ",\"decodedSize\":[";
+            appendInteger(out, decodedWidth);  out.push_back(',');
+            appendInteger(out, decodedHeight); out += "]";
+
+            out += ",\"range\":{\"minimum\":";
+            appendArray(out, range.minimum, Histogram::channels);
+            out += ",\"maximum\":";
+            appendArray(out, range.maximum, Histogram::channels);
+            out += "}";
+
+            out += ",\"zones\":{\"steps\":";
+            appendArray(out, zones.steps, 12);
+            out += ",\"balance\":";
+            appendArray(out, zones.balance, 3);
+            out += ",\"spots\":";
+            appendArray(out, zones.spots, 3);
+            out += ",\"range\":";
+            appendArray(out, zones.range, 3);
+            out += "}";
+
+            out += ",\"dominantColor\":";
+            appendArray(out, dominantColor.color, Histogram::channels);
+
+            out.push_back('}');
+            return out;
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    IMPCatalogAnalyzerOptions IMPCatalogAnalyzerDefaultOptions(void) {
+        CatalogAnalyzerOptions defaults;
+        IMPCatalogAnalyzerOptions options;
+        options.workers            = 0;
+        options.queueDepth         = 0;
+        options.minimumSide        = uint32_t(defaults.minimumSide);
+        options.shadowsClipping    = defaults.shadowsClipping;
+        options.highlightsClipping = defaults.highlightsClipping;
+        options.regionLeft   = 0;
+        options.regionRight  = 0;
+        options.regionTop    = 0;
+        options.regionBottom = 0;
+        return options;
+    }
+
+    long IMPCatalogAnalyzerRun(const char *catalogPath,
+                               const char *outputPath,
+                               const IMPCatalogAnalyzerOptions *options) {
+
+        if (!catalogPath || !outputPath) return -1;
+
+        IMPCatalogAnalyzerOptions o = options ? *options : IMPCatalogAnalyzerDefaultOptions();
+
+        CatalogAnalyzerOptions opts;
+        opts.workers            = o.workers;
+        opts.queueDepth         = o.queueDepth;
+        opts.minimumSide        = o.minimumSide;
+        opts.shadowsClipping    = o.shadowsClipping;
+        opts.highlightsClipping = o.highlightsClipping;
+        opts.region.left   = o.regionLeft;
+        opts.region.right  = o.regionRight;
+        opts.region.top    = o.regionTop;
+        opts.region.bottom = o.regionBottom;
+
+        std::ifstream catalogFile;
+        std::ofstream outputFile;
+
+        bool fromStdin = std::string(catalogPath) == "-";
+        bool toStdout  = std::string(outputPath)  == "-";
+
+        if (!fromStdin) {
+            catalogFile.open(catalogPath);
+            if (!catalogFile.is_open()) return -1;
+        }
+
+        if (!toStdout) {
+            outputFile.open(outputPath, std::ios::out | std::ios::trunc);
+            if (!outputFile.is_open()) return -1;
+        }
+
+        CatalogAnalyzer analyzer(opts);
+
+        return long(analyzer.run(fromStdin ? std::cin  : catalogFile,
+                                 toStdout  ? std::cout : outputFile));
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  IMPCatalogAnalyzer_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCatalogAnalyzer_cpu_hpp
+#define IMPCatalogAnalyzer_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "IMPHistogram_cpu.hpp"
+#include "IMPParallel_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        struct CatalogAnalyzerOptions {
+
+            /// Decoding/binning workers, 0 - one per core
+            size_t workers     = 0;
+
+            /// Paths waiting for a free worker, 0 - twice the number of workers.
+            /// The catalog reader blocks when the queue is full.
+            size_t queueDepth  = 0;
+
+            /// The smallest side of a decoded image. JPEGs are decoded with the
+            /// smallest libjpeg-turbo DCT scaling factor which still keeps this side,
+            /// 0 - always decode at full size.
+            size_t minimumSide = 256;
+
+            /// Use fast integer DCT and fast upsampling
+            bool   fastDecoding = true;
+
+            Region region;
+
+            float  shadowsClipping    = 0.1f/100.0f;
+            float  highlightsClipping = 0.1f/100.0f;
+        };
+
+        struct CatalogAnalysis {
+
+            size_t      index  = 0;
+            std::string path;
+            std::string error;
+
+            size_t width  = 0;
+            size_t height = 0;
+
+            size_t decodedWidth  = 0;
+            size_t decodedHeight = 0;
+
+            HistogramRangeSolver         range;
+            HistogramZonesSolver         zones;
+            HistogramDominantColorSolver dominantColor;
+
+            inline bool ok() const { return error.empty(); }
+
+            /// One line of newline delimited JSON, without the trailing newline
+            std::string json() const;
+        };
+
+        ///
+        /// Headless histogram analyzer for large catalogs of JPEG files: decodes with turbojpeg,
+        /// builds IMPHistogram compatible bins and runs range, zones and dominant color solvers.
+        /// Memory is bounded by (workers × the largest decoded image) plus the queue of paths.
+        ///
+        class CatalogAnalyzer {
+
+        public:
+
+            explicit CatalogAnalyzer(const CatalogAnalyzerOptions &options = CatalogAnalyzerOptions());
+            ~CatalogAnalyzer();
+
+            CatalogAnalyzer(const CatalogAnalyzer&) = delete;
+            CatalogAnalyzer& operator=(const CatalogAnalyzer&) = delete;
+
+            inline const CatalogAnalyzerOptions &options() const { return _options; }
+
+            ///
+            /// Read paths line by line from `catalog` and stream one JSON object per analyzed
+            /// image to `output` in completion order, flushed every few dozen records and at the end.
+            /// Returns the number of processed entries.
+            ///
+            size_t run(std::istream &catalog, std::ostream &output);
+
+            ///
+            /// Analyze a single file with the state of the given worker.
+            ///
+            bool analyze(const std::string &path, size_t worker, CatalogAnalysis &result);
+
+        private:
+            struct Worker;
+
+            CatalogAnalyzerOptions    _options;
+            std::unique_ptr<Worker[]> _workers;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPCatalogAnalyzer_cpu_hpp */
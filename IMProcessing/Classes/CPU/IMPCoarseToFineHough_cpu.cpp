@@ -0,0 +1,276 @@
+//
+//  IMPCoarseToFineHough_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPCoarseToFineHough_cpu.hpp"
+#include "IMPCoarseToFineHough-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            HoughSpace::Options coarseOptions(const CoarseToFineHough::Options &options) {
+                HoughSpace::Options o = options.space;
+                o.rhoStep   *= float(std::max<size_t>(options.factor, 1));
+                o.thetaStep *= float(std::max<size_t>(options.factor, 1));
+                return o;
+            }
+
+            //
+            // Interior bins [n0, n1] x [r0, r1] of the fine space, voted with one more bin around
+            //
+            struct Window {
+                long n0, n1, r0, r1;
+            };
+        }
+
+        CoarseToFineHough::CoarseToFineHough(size_t width, size_t height, const Options &options):
+        _options(options), _width(width), _height(height), _fine(width, height, options.space) {
+            _options.factor = std::max<size_t>(_options.factor, 1);
+        }
+
+        bool CoarseToFineHough::peaks(const std::vector<HoughSpace::Point> &points, std::vector<HoughPeaks::Peak> &peaks) const {
+
+            peaks.clear();
+
+            const long  N       = long(_fine.numangle());
+            const long  numrho  = long(_fine.numrho());
+            const long  factor  = long(_options.factor);
+            const long  radius  = long(_options.radius);
+            const float offset  = (float(numrho) - 1.0f) * 0.5f;
+
+            if (N == 0 || numrho == 0) return true;
+
+            //
+            // Coarse candidates
+            //
+            HoughSpace coarse(_width, _height, coarseOptions(_options));
+            coarse.transform(points);
+
+            //
+            // A coarse peak suppressed by a stronger one is within its window, so candidates are
+            // taken one window apart to cover more lines
+            //
+            HoughPeaks::Options co;
+            co.threshold   = _options.peaks.threshold;
+            co.linesMax    = _options.windows > 0 ? _options.windows : 2 * std::max<size_t>(_options.peaks.linesMax, 1);
+            co.rhoRadius   = _options.radius;
+            co.thetaRadius = _options.radius;
+
+            std::vector<HoughPeaks::Peak> candidates;
+            HoughPeaks(co).peaks(coarse, candidates);
+
+            //
+            // Coarse bin r holds distances of [r - offset - 0.5, r - offset + 0.5] coarse steps, its
+            // angle n is the fine angle n * factor
+            //
+            const long  coarseStride = long(coarse.numrho() + 2);
+            const float coarseOffset = (float(coarse.numrho()) - 1.0f) * 0.5f;
+
+            std::vector<Window> windows;
+            windows.reserve(candidates.size());
+
+            for (const auto &c: candidates) {
+
+                const long nc = long(c.index) / coarseStride - 1;
+                const long rc = long(c.index) % coarseStride - 1;
+
+                Window w;
+                w.n0 = std::max((nc - radius) * factor - factor / 2, 0L);
+                w.n1 = std::min((nc + radius) * factor + factor / 2, N - 1);
+                w.r0 = std::max(long(std::floor((float(rc - radius) - coarseOffset - 0.5f) * float(factor) + offset)) - 1, 0L);
+                w.r1 = std::min(long(std::ceil ((float(rc + radius) - coarseOffset + 0.5f) * float(factor) + offset)) + 1, numrho - 1);
+
+                if (w.n0 <= w.n1 && w.r0 <= w.r1) windows.push_back(w);
+            }
+
+            //
+            // Point distances from the origin bound the change of rho over the angles of a window
+            //
+            std::vector<float> lengths(points.size());
+            for (size_t i = 0; i < points.size(); i++) lengths[i] = std::sqrt(points[i].x * points[i].x + points[i].y * points[i].y);
+
+            const float *tabSin  = _fine.tabSin().data();
+            const float *tabCos  = _fine.tabCos().data();
+            const float  step    = _fine.options().thetaStep / _fine.options().rhoStep;
+            const long   stride  = numrho + 2;
+            const uint32_t threshold = _options.peaks.threshold;
+
+            std::vector<std::vector<HoughPeaks::Peak>> found(windows.size());
+
+            parallelFor(windows.size(), [&](size_t k){
+
+                const Window &w = windows[k];
+
+                //
+                // Voted bins [a0, a1] x [b0, b1] padded around the interior
+                //
+                const long a0 = std::max(w.n0 - 1, 0L), a1 = std::min(w.n1 + 1, N - 1);
+                const long b0 = std::max(w.r0 - 1, 0L), b1 = std::min(w.r1 + 1, numrho - 1);
+
+                const long rows    = w.n1 - w.n0 + 3;
+                const long columns = w.r1 - w.r0 + 3;
+
+                std::vector<uint32_t> bins(size_t(rows * columns), 0);
+
+                auto at = [&](long n, long r) -> uint32_t & {
+                    return bins[size_t((n - w.n0 + 1) * columns + (r - w.r0 + 1))];
+                };
+
+                //
+                // Distances landing in [b0, b1] are within half of the middle one, widened by a bin
+                //
+                const long  middle = (a0 + a1) / 2;
+                const float center = float(b0 + b1 + 1) * 0.5f - offset;
+                const float half   = float(b1 + 1 - b0) * 0.5f + 1.0f;
+                const float spread = float(std::max(middle - a0, a1 - middle)) * step;
+
+                const float cm = tabCos[middle], sm = tabSin[middle];
+
+                for (size_t i = 0; i < points.size(); i++) {
+
+                    const float x = points[i].x, y = points[i].y;
+
+                    if (std::fabs(x * cm + y * sm - center) > half + spread * lengths[i] + 1.0f) continue;
+
+                    for (long n = a0; n <= a1; n++) {
+                        const long r = long(std::round(x * tabCos[n] + y * tabSin[n]) + offset);
+                        if (r >= b0 && r <= b1) at(n, r)++;
+                    }
+                }
+
+                for (long n = w.n0; n <= w.n1; n++) {
+                    for (long r = w.r0; r <= w.r1; r++) {
+
+                        const uint32_t v = at(n, r);
+
+                        if (v <= threshold) continue;
+
+                        if (v > at(n, r - 1) && v >= at(n, r + 1) && v > at(n - 1, r) && v >= at(n + 1, r))
+                            found[k].push_back(HoughPeaks::Peak{ uint32_t((n + 1) * stride + r + 1), v });
+                    }
+                }
+            });
+
+            //
+            // Overlapping windows find a peak more than once
+            //
+            std::vector<HoughPeaks::Peak> merged;
+            for (const auto &list: found) merged.insert(merged.end(), list.begin(), list.end());
+
+            std::sort(merged.begin(), merged.end(), [](const HoughPeaks::Peak &a, const HoughPeaks::Peak &b){
+                return a.index < b.index;
+            });
+
+            merged.erase(std::unique(merged.begin(), merged.end(), [](const HoughPeaks::Peak &a, const HoughPeaks::Peak &b){
+                return a.index == b.index;
+            }), merged.end());
+
+            HoughPeaks(_options.peaks).select(merged, size_t(numrho), peaks);
+
+            return true;
+        }
+
+        template<typename T> bool CoarseToFineHough::image(const ImageView<const T> &edges, std::vector<HoughPeaks::Peak> &peaks) const {
+
+            peaks.clear();
+
+            if (edges.empty() || edges.width != _width || edges.height != _height) return false;
+
+            std::vector<HoughSpace::Point> points;
+
+            HoughSpace::edges(edges, points);
+
+            return this->peaks(points, peaks);
+        }
+
+        bool CoarseToFineHough::peaks(const ImageView<const uint8_t> &edges, std::vector<HoughPeaks::Peak> &peaks) const {
+            return image(edges, peaks);
+        }
+
+        bool CoarseToFineHough::peaks(const ImageView<const uint16_t> &edges, std::vector<HoughPeaks::Peak> &peaks) const {
+            return image(edges, peaks);
+        }
+
+        bool CoarseToFineHough::peaks(const ImageView<const float> &edges, std::vector<HoughPeaks::Peak> &peaks) const {
+            return image(edges, peaks);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static CoarseToFineHough::Options coarseToFineOptions(const IMPHoughSpaceOptions &space, const IMPHoughPeaksOptions &peaks, uint32_t factor) {
+    CoarseToFineHough::Options o;
+    o.space.rhoStep     = space.rhoStep;
+    o.space.thetaStep   = space.thetaStep;
+    o.space.minTheta    = space.minTheta;
+    o.space.maxTheta    = space.maxTheta;
+    o.peaks.threshold   = peaks.threshold;
+    o.peaks.linesMax    = peaks.linesMax;
+    o.peaks.rhoRadius   = peaks.rhoRadius;
+    o.peaks.thetaRadius = peaks.thetaRadius;
+    o.factor            = factor;
+    return o;
+}
+
+static size_t copyPeaks(const std::vector<HoughPeaks::Peak> &found, IMPCpuHoughPeak *peaks, size_t capacity) {
+
+    const size_t count = std::min(capacity, found.size());
+
+    for (size_t i = 0; peaks && i < count; i++) {
+        peaks[i].index = found[i].index;
+        peaks[i].votes = found[i].votes;
+    }
+
+    return found.size();
+}
+
+extern "C" {
+
+    size_t IMPHoughCoarseToFinePeaks(IMPCpuImage edges, IMPHoughSpaceOptions options, IMPHoughPeaksOptions peaksOptions,
+                                     uint32_t factor, IMPCpuHoughPeak *peaks, size_t capacity) {
+
+        CoarseToFineHough hough(edges.width, edges.height, coarseToFineOptions(options, peaksOptions, factor));
+
+        std::vector<HoughPeaks::Peak> found;
+
+        dispatch(edges, [&](auto view){
+            hough.peaks(view.readonly(), found);
+        });
+
+        return copyPeaks(found, peaks, capacity);
+    }
+
+    size_t IMPHoughCoarseToFinePeaksPoints(const float *points, size_t size, size_t width, size_t height,
+                                           IMPHoughSpaceOptions options, IMPHoughPeaksOptions peaksOptions,
+                                           uint32_t factor, IMPCpuHoughPeak *peaks, size_t capacity) {
+
+        if (!points && size > 0) return 0;
+
+        CoarseToFineHough hough(width, height, coarseToFineOptions(options, peaksOptions, factor));
+
+        std::vector<HoughSpace::Point> list(size);
+
+        for (size_t i = 0; i < size; i++) {
+            list[i].x = points[2 * i]     * float(width);
+            list[i].y = points[2 * i + 1] * float(height);
+        }
+
+        std::vector<HoughPeaks::Peak> found;
+
+        hough.peaks(list, found);
+
+        return copyPeaks(found, peaks, capacity);
+    }
+}
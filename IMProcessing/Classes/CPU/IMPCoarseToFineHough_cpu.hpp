@@ -0,0 +1,87 @@
+//
+//  IMPCoarseToFineHough_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPCoarseToFineHough_cpu_hpp
+#define IMPCoarseToFineHough_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+#include "IMPHoughSpace_cpu.hpp"
+#include "IMPHoughPeaks_cpu.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Two level Hough: peaks of a fine IMPHoughSpace without its accumulator. A coarse space of
+        /// factor times the steps is voted first, windows of the fine space around its strongest
+        /// peaks are voted next by the points that can reach them only.
+        ///
+        /// A point reaches a window when its distance at the middle angle is within the window
+        /// distances widened by the largest change over the window angles, so the bins of a window
+        /// hold exactly the votes of the fine accumulator. Peaks are the bins of the window interior
+        /// passing the HoughPeaks test, the same peaks the fine accumulator has there; a fine peak
+        /// is missed only when no coarse candidate window covers it.
+        ///
+        class CoarseToFineHough {
+
+        public:
+
+            struct Options {
+                /// Resolution of the peaks
+                HoughSpace::Options space;
+                /// Threshold, linesMax and the suppression radius in fine bins
+                HoughPeaks::Options peaks;
+                /// Coarse bins span factor fine bins of distance and angle
+                size_t factor  = 4;
+                /// Coarse peaks refined, 0 refines twice linesMax of them
+                size_t windows = 0;
+                /// Coarse bins on each side of a coarse peak covered by its window
+                size_t radius  = 1;
+            };
+
+            CoarseToFineHough(size_t width, size_t height, const Options &options);
+
+            inline const Options &options() const { return _options; }
+
+            /// Fine space dimensions, the peak indices are the bins of its accumulator
+            inline size_t numangle() const { return _fine.numangle(); }
+            inline size_t numrho()   const { return _fine.numrho(); }
+
+            ///
+            /// Peaks of the pixels whose first channel is at least half of the range, the strongest
+            /// first, replaces the content of peaks
+            ///
+            bool peaks(const ImageView<const uint8_t>  &edges, std::vector<HoughPeaks::Peak> &peaks) const;
+            bool peaks(const ImageView<const uint16_t> &edges, std::vector<HoughPeaks::Peak> &peaks) const;
+            bool peaks(const ImageView<const float>    &edges, std::vector<HoughPeaks::Peak> &peaks) const;
+
+            ///
+            /// Peaks of points in pixel coordinates
+            ///
+            bool peaks(const std::vector<HoughSpace::Point> &points, std::vector<HoughPeaks::Peak> &peaks) const;
+
+        private:
+
+            template<typename T> bool image(const ImageView<const T> &edges, std::vector<HoughPeaks::Peak> &peaks) const;
+
+            Options    _options;
+            size_t     _width, _height;
+            HoughSpace _fine;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPCoarseToFineHough_cpu_hpp */
@@ -0,0 +1,381 @@
+//
+//  IMPExifOrientation_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPExifOrientation_cpu.hpp"
+#include "IMPExifOrientation-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            //
+            // Pixels are moved as opaque words of their size
+            //
+            struct Word128 {
+                uint64_t lo, hi;
+            };
+
+            template<size_t bytes> struct PixelWord;
+            template<> struct PixelWord<1>  { typedef uint8_t  type; };
+            template<> struct PixelWord<2>  { typedef uint16_t type; };
+            template<> struct PixelWord<4>  { typedef uint32_t type; };
+            template<> struct PixelWord<8>  { typedef uint64_t type; };
+            template<> struct PixelWord<16> { typedef Word128  type; };
+
+            template<typename W, typename T> inline ImageView<W> words(const ImageView<T> &view) {
+                return ImageView<W>(reinterpret_cast<W*>(view.data), view.width, view.height, 1, view.bytesPerRow);
+            }
+
+            //
+            // Rows of about this many bytes are worth a thread
+            //
+            inline size_t stripRows(size_t rowBytes) {
+                return std::max<size_t>(1, (size_t(1) << 18) / std::max<size_t>(rowBytes, 1));
+            }
+
+            template<typename W> void copy(const ImageView<const W> &source, const ImageView<W> &destination) {
+                const size_t bytes = source.width * sizeof(W);
+                parallelStrips(source.height, stripRows(bytes), [&](size_t begin, size_t end){
+                    for (size_t y = begin; y < end; y++) std::memcpy(destination.row(y), source.row(y), bytes);
+                });
+            }
+
+            template<typename W> inline void reverseRow(const W *in, W *out, size_t width) {
+                std::reverse_copy(in, in + width, out);
+            }
+
+            inline void reverseRow(const uint32_t *in, uint32_t *out, size_t width) {
+                size_t x = 0;
+#if IMP_CPU_SSE2
+                for (; x + 4 <= width; x += 4) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + width - 4 - x));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)));
+                }
+#elif IMP_CPU_NEON
+                for (; x + 4 <= width; x += 4) {
+                    const uint32x4_t v = vrev64q_u32(vld1q_u32(in + width - 4 - x));
+                    vst1q_u32(out + x, vcombine_u32(vget_high_u32(v), vget_low_u32(v)));
+                }
+#endif
+                for (; x < width; x++) out[x] = in[width - 1 - x];
+            }
+
+            template<typename W> void reverse(const ImageView<const W> &source, const ImageView<W> &destination) {
+                parallelStrips(source.height, stripRows(source.width * sizeof(W)), [&](size_t begin, size_t end){
+                    for (size_t y = begin; y < end; y++) reverseRow(source.row(y), destination.row(y), source.width);
+                });
+            }
+
+            //
+            // Source pixel (x, y) to destination pixel (y, x) for x in [x0, x1), y in [y0, y1)
+            //
+            template<typename W> void transposeTile(const ImageView<const W> &source, const ImageView<W> &destination,
+                                                    size_t x0, size_t x1, size_t y0, size_t y1) {
+                for (size_t x = x0; x < x1; x++) {
+                    W *out = destination.row(x);
+                    for (size_t y = y0; y < y1; y++) out[y] = source.row(y)[x];
+                }
+            }
+
+            void transposeTile(const ImageView<const uint32_t> &source, const ImageView<uint32_t> &destination,
+                               size_t x0, size_t x1, size_t y0, size_t y1) {
+
+                size_t x = x0;
+
+#if IMP_CPU_SSE2 || IMP_CPU_NEON
+                //
+                // Four destination rows at a time, each written on in order
+                //
+                const size_t y4 = y0 + (y1 - y0) / 4 * 4;
+
+                for (; x + 4 <= x1; x += 4) {
+
+                    uint32_t *d0 = destination.row(x),     *d1 = destination.row(x + 1);
+                    uint32_t *d2 = destination.row(x + 2), *d3 = destination.row(x + 3);
+
+                    for (size_t y = y0; y < y4; y += 4) {
+
+                        const uint32_t *s0 = source.row(y)     + x, *s1 = source.row(y + 1) + x;
+                        const uint32_t *s2 = source.row(y + 2) + x, *s3 = source.row(y + 3) + x;
+#if IMP_CPU_SSE2
+                        const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0));
+                        const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1));
+                        const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2));
+                        const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s3));
+
+                        const __m128i t0 = _mm_unpacklo_epi32(r0, r1), t1 = _mm_unpacklo_epi32(r2, r3);
+                        const __m128i t2 = _mm_unpackhi_epi32(r0, r1), t3 = _mm_unpackhi_epi32(r2, r3);
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(d0 + y), _mm_unpacklo_epi64(t0, t1));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(d1 + y), _mm_unpackhi_epi64(t0, t1));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(d2 + y), _mm_unpacklo_epi64(t2, t3));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(d3 + y), _mm_unpackhi_epi64(t2, t3));
+#else
+                        const uint32x4x2_t p = vtrnq_u32(vld1q_u32(s0), vld1q_u32(s1));
+                        const uint32x4x2_t q = vtrnq_u32(vld1q_u32(s2), vld1q_u32(s3));
+
+                        vst1q_u32(d0 + y, vcombine_u32(vget_low_u32(p.val[0]),  vget_low_u32(q.val[0])));
+                        vst1q_u32(d1 + y, vcombine_u32(vget_low_u32(p.val[1]),  vget_low_u32(q.val[1])));
+                        vst1q_u32(d2 + y, vcombine_u32(vget_high_u32(p.val[0]), vget_high_u32(q.val[0])));
+                        vst1q_u32(d3 + y, vcombine_u32(vget_high_u32(p.val[1]), vget_high_u32(q.val[1])));
+#endif
+                    }
+
+                    for (size_t y = y4; y < y1; y++) {
+                        const uint32_t *s = source.row(y) + x;
+                        d0[y] = s[0]; d1[y] = s[1]; d2[y] = s[2]; d3[y] = s[3];
+                    }
+                }
+#endif
+
+                transposeTile<uint32_t>(source, destination, x, x1, y0, y1);
+            }
+
+#if IMP_CPU_AVX2_DISPATCH
+            IMP_CPU_TARGET_AVX2 void transposeTileAVX2(const ImageView<const uint32_t> &source, const ImageView<uint32_t> &destination,
+                                                       size_t x0, size_t x1, size_t y0, size_t y1) {
+
+                const size_t x8 = x0 + (x1 - x0) / 8 * 8;
+                const size_t y8 = y0 + (y1 - y0) / 8 * 8;
+
+                for (size_t x = x0; x < x8; x += 8) {
+                    for (size_t y = y0; y < y8; y += 8) {
+
+                        __m256i r[8];
+                        for (int i = 0; i < 8; i++)
+                            r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source.row(y + i) + x));
+
+                        //
+                        // Pairs of rows, quads of rows within the lanes, then the lanes
+                        //
+                        const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+                        const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+                        const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+                        const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+                        const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+                        const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+                        const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+                        const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+
+                        const __m256i o[8] = {
+                            _mm256_permute2x128_si256(u0, u4, 0x20), _mm256_permute2x128_si256(u1, u5, 0x20),
+                            _mm256_permute2x128_si256(u2, u6, 0x20), _mm256_permute2x128_si256(u3, u7, 0x20),
+                            _mm256_permute2x128_si256(u0, u4, 0x31), _mm256_permute2x128_si256(u1, u5, 0x31),
+                            _mm256_permute2x128_si256(u2, u6, 0x31), _mm256_permute2x128_si256(u3, u7, 0x31)
+                        };
+
+                        for (int i = 0; i < 8; i++)
+                            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination.row(x + i) + y), o[i]);
+                    }
+                }
+
+                if (x8 < x1) transposeTile(source, destination, x8, x1, y0, y8);
+                if (y8 < y1) transposeTile(source, destination, x0, x1, y8, y1);
+            }
+#endif
+
+            //
+            // Halves of the longer side, cut at multiples of 8 to keep the register blocks whole,
+            // until both sides fit a tile
+            //
+            template<typename F> void recurse(size_t x0, size_t x1, size_t y0, size_t y1, size_t tile, const F &kernel) {
+
+                const size_t w = x1 - x0, h = y1 - y0;
+
+                if (w <= tile && h <= tile) {
+                    kernel(x0, x1, y0, y1);
+                }
+                else if (w >= h) {
+                    const size_t m = x0 + (w / 2 + 7) / 8 * 8;
+                    recurse(x0, m, y0, y1, tile, kernel);
+                    recurse(m, x1, y0, y1, tile, kernel);
+                }
+                else {
+                    const size_t m = y0 + (h / 2 + 7) / 8 * 8;
+                    recurse(x0, x1, y0, m, tile, kernel);
+                    recurse(x0, x1, m, y1, tile, kernel);
+                }
+            }
+
+            template<typename W, typename F> void transposeWith(const ImageView<const W> &source, const ImageView<W> &destination,
+                                                                size_t tile, const F &kernel) {
+                //
+                // A strip of source columns writes a strip of destination rows
+                //
+                parallelStrips(source.width, std::max(tile, stripRows(source.height * sizeof(W))), [&](size_t begin, size_t end){
+                    recurse(begin, end, 0, source.height, tile, [&](size_t x0, size_t x1, size_t y0, size_t y1){
+                        kernel(source, destination, x0, x1, y0, y1);
+                    });
+                });
+            }
+
+            template<typename W> void transpose(const ImageView<const W> &source, const ImageView<W> &destination, size_t tile) {
+                transposeWith(source, destination, tile, [](const ImageView<const W> &s, const ImageView<W> &d,
+                                                            size_t x0, size_t x1, size_t y0, size_t y1){
+                    transposeTile(s, d, x0, x1, y0, y1);
+                });
+            }
+
+#if IMP_CPU_AVX2_DISPATCH
+            template<> void transpose<uint32_t>(const ImageView<const uint32_t> &source, const ImageView<uint32_t> &destination, size_t tile) {
+                if (hasAVX2())
+                    transposeWith(source, destination, tile, transposeTileAVX2);
+                else
+                    transposeWith(source, destination, tile, [](const ImageView<const uint32_t> &s, const ImageView<uint32_t> &d,
+                                                                size_t x0, size_t x1, size_t y0, size_t y1){
+                        transposeTile(s, d, x0, x1, y0, y1);
+                    });
+            }
+#endif
+        }
+
+        ExifOrientation::ExifOrientation(Orientation orientation, const Options &options):
+        _orientation(orientation), _options(options) {
+            _options.tileSize = std::max<size_t>(_options.tileSize, 16);
+        }
+
+        bool ExifOrientation::transposes(Orientation orientation) {
+            switch (orientation) {
+                case Orientation::left90VerticalFlipped:
+                case Orientation::left90:
+                case Orientation::left90HorizontalFlipped:
+                case Orientation::right90:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        ExifOrientation::Orientation ExifOrientation::inverse(Orientation orientation) {
+            switch (orientation) {
+                case Orientation::left90:  return Orientation::right90;
+                case Orientation::right90: return Orientation::left90;
+                default:                   return orientation;
+            }
+        }
+
+        //
+        // The vertical flips are views, what is left is a copy, a reversal of the rows or a
+        // transpose:
+        //
+        //   2: reverse(S)    3: reverse(S')    4: copy(S')
+        //   5: D = S^T       6: D = S'^T       7: D' = S'^T    8: D' = S^T
+        //
+        // where S' and D' are the views flipped upside down
+        //
+        template<typename W> void ExifOrientation::orient(const ImageView<const W> &source, const ImageView<W> &destination) const {
+
+            const size_t tile = _options.tileSize;
+
+            switch (_orientation) {
+                case Orientation::horizontalFlipped:       reverse(source, destination); break;
+                case Orientation::left180:                 reverse(source.flipped(), destination); break;
+                case Orientation::verticalFlipped:         copy(source.flipped(), destination); break;
+                case Orientation::left90VerticalFlipped:   transpose(source, destination, tile); break;
+                case Orientation::left90:                  transpose(source.flipped(), destination, tile); break;
+                case Orientation::left90HorizontalFlipped: transpose(source.flipped(), destination.flipped(), tile); break;
+                case Orientation::right90:                 transpose(source, destination.flipped(), tile); break;
+                default:                                   copy(source, destination); break;
+            }
+        }
+
+        template<typename T> bool ExifOrientation::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.channels != destination.channels) return false;
+            if (source.channels != 1 && source.channels != 4) return false;
+            if (int(_orientation) < 0 || int(_orientation) > 8) return false;
+
+            const bool swapped = transposes(_orientation);
+
+            if (destination.width  != (swapped ? source.height : source.width))  return false;
+            if (destination.height != (swapped ? source.width  : source.height)) return false;
+
+            if (source.channels == 4) {
+                typedef typename PixelWord<4 * sizeof(T)>::type W;
+                orient(words<const W>(source), words<W>(destination));
+            }
+            else {
+                typedef typename PixelWord<sizeof(T)>::type W;
+                orient(words<const W>(source), words<W>(destination));
+            }
+
+            return true;
+        }
+
+        bool ExifOrientation::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool ExifOrientation::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool ExifOrientation::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPExifOrientationApply(IMPCpuImage source, IMPCpuImage destination, int orientation) {
+
+        if (source.format != destination.format) return false;
+
+        const ExifOrientation engine{ExifOrientation::Orientation(orientation)};
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = engine.apply(view, target);
+        });
+
+        return done;
+    }
+
+    bool IMPExifOrientationView(IMPCpuImage source, int orientation, IMPCpuImage *upright) {
+
+        if (!upright) return false;
+
+        bool done = false;
+
+        dispatch(source, [&](auto view){
+            decltype(view) result;
+            if (!ExifOrientation::view(view, ExifOrientation::Orientation(orientation), result)) return;
+            *upright = source;
+            upright->data        = result.data;
+            upright->bytesPerRow = long(result.bytesPerRow);
+            done = true;
+        });
+
+        return done;
+    }
+
+    bool IMPExifOrientationTransposes(int orientation) {
+        return ExifOrientation::transposes(ExifOrientation::Orientation(orientation));
+    }
+
+    int IMPExifOrientationInverse(int orientation) {
+        return int(ExifOrientation::inverse(ExifOrientation::Orientation(orientation)));
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  IMPExifOrientation_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPExifOrientation_cpu_hpp
+#define IMPExifOrientation_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Turns an image stored in one of the eight EXIF orientations upright, the CPU counterpart
+        /// of fragment_transformation with a flip vector and of the CoreImage oriented images.
+        ///
+        /// Every orientation is a row copy, a row reversal or a transpose, the vertical flips folded
+        /// into the views: the source, the destination or both are walked bottom-up by a negative
+        /// bytesPerRow. Transposes recurse into halves of the longer side down to tiles that fit the
+        /// cache; 32-bit pixels, RGBA8 and one channel float, are moved by 4 x 4 in-register
+        /// transposes, 8 x 8 on AVX2. Source columns are split between threads.
+        ///
+        class ExifOrientation {
+
+        public:
+
+            ///
+            /// IMPExifOrientation codes
+            ///
+            enum class Orientation : int {
+                none                    = 0,
+                up                      = 1,
+                horizontalFlipped       = 2,
+                left180                 = 3,
+                verticalFlipped         = 4,
+                left90VerticalFlipped   = 5,
+                left90                  = 6,
+                left90HorizontalFlipped = 7,
+                right90                 = 8
+            };
+
+            struct Options {
+                /// Side of the transposed tiles, at least 16
+                size_t tileSize = 64;
+            };
+
+            ExifOrientation(Orientation orientation, const Options &options);
+
+            explicit ExifOrientation(Orientation orientation): ExifOrientation(orientation, Options()) {}
+
+            inline Orientation orientation() const { return _orientation; }
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// True if the upright image swaps the width and the height of the stored one
+            ///
+            static bool transposes(Orientation orientation);
+
+            ///
+            /// The orientation storing an upright image back in orientation
+            ///
+            static Orientation inverse(Orientation orientation);
+
+            ///
+            /// The upright image without copying, for up and verticalFlipped, the flip walking the
+            /// source rows bottom-up. Returns false for orientations reversing or transposing rows,
+            /// these need apply().
+            ///
+            template<typename T> static bool view(const ImageView<T> &source, Orientation orientation, ImageView<T> &upright) {
+                switch (orientation) {
+                    case Orientation::none:
+                    case Orientation::up:
+                        upright = source;
+                        return true;
+                    case Orientation::verticalFlipped:
+                        upright = source.flipped();
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            ///
+            /// Write the upright source into destination, both have the same channels (1 or 4),
+            /// destination is width x height or height x width if transposes(), and must not
+            /// overlap source. Returns false if the layouts don't match.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            template<typename W> void orient(const ImageView<const W> &source, const ImageView<W> &destination) const;
+
+            Orientation _orientation;
+            Options     _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPExifOrientation_cpu_hpp */
@@ -0,0 +1,241 @@
+//
+//  IMPGaussianDerivativeEdges_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPGaussianDerivativeEdges_cpu.hpp"
+#include "IMPGaussianDerivativeEdges-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            //
+            // IMProcessing::max_component of the colour, normalized. The row goes to
+            // values[0 ... width - 1], pad samples on both sides replicate the edges.
+            //
+            template<typename T> void maxRow(const T *p, size_t width, size_t channels, size_t pad, float *values) {
+
+                const float scale = 1.0f / PixelTraits<T>::maximum;
+
+                if (channels < 3) {
+                    for (size_t x = 0; x < width; x++, p += channels) values[x] = float(p[0]) * scale;
+                }
+                else {
+                    for (size_t x = 0; x < width; x++, p += channels)
+                        values[x] = float(std::max(p[0], std::max(p[1], p[2]))) * scale;
+                }
+
+                std::fill(values - pad, values, values[0]);
+                std::fill(values + width, values + width + pad, values[width - 1]);
+            }
+
+            //
+            // |-3a - 5b + 5c + 3d|
+            //
+            inline void derivative(const float *a, const float *b, const float *c, const float *d, float *out, size_t count) {
+
+                const Vec4f three(3.0f), five(5.0f), zero(0.0f);
+
+                size_t i = 0;
+
+                for (; i + 4 <= count; i += 4) {
+                    Vec4f v = madd(three, Vec4f::load(d + i) - Vec4f::load(a + i), five * (Vec4f::load(c + i) - Vec4f::load(b + i)));
+                    max(v, zero - v).store(out + i);
+                }
+                for (; i < count; i++) out[i] = std::fabs(3.0f * (d[i] - a[i]) + 5.0f * (c[i] - b[i]));
+            }
+        }
+
+        template<typename T, typename F> void GaussianDerivativeEdges::run(const ImageView<const T> &source, F &&emit) const {
+
+            const size_t width    = source.width;
+            const size_t height   = source.height;
+            const size_t channels = source.channels;
+            const long   pitch    = long(std::max<size_t>(_options.pitch, 1));
+            const size_t pad      = size_t(2 * pitch + 1);
+            const size_t stride   = width + 2 * pad;
+            const long   last     = long(height) - 1;
+
+            //
+            // The y derivatives of rows y - 1 ... y + 1 read rows y - 1 - 2 * pitch ... y + 1 + 2 * pitch,
+            // a ring of that many source rows never evicts a row still in use
+            //
+            const size_t ring = size_t(4 * pitch + 3);
+
+            parallelStrips(height, std::max<size_t>(64, size_t(8 * pitch)), [&](size_t begin, size_t end){
+
+                AlignedBuffer<float> values(ring * stride);
+                AlignedBuffer<float> vertical(3 * width);
+                AlignedBuffer<float> horizontal(width + 2);
+
+                std::vector<long> loaded(ring, -1);
+                long computed[3] = { -2, -2, -2 };
+
+                auto value = [&](long r){
+                    r = std::min(std::max(r, 0L), last);
+                    const size_t slot = size_t(r) % ring;
+                    float *row = values.data() + slot * stride + pad;
+                    if (loaded[slot] != r) {
+                        maxRow(source.row(size_t(r)), width, channels, pad, row);
+                        loaded[slot] = r;
+                    }
+                    return static_cast<const float*>(row);
+                };
+
+                //
+                // Rows -1 and height are sampled with replicated edges as well
+                //
+                auto derivativeY = [&](long r){
+                    const size_t slot = size_t(r + 1) % 3;
+                    float *out = vertical.data() + slot * width;
+                    if (computed[slot] != r) {
+                        derivative(value(r - 2 * pitch), value(r - pitch), value(r + pitch), value(r + 2 * pitch), out, width);
+                        computed[slot] = r;
+                    }
+                    return static_cast<const float*>(out);
+                };
+
+                for (size_t y = begin; y < end; y++) {
+
+                    const float *above = derivativeY(long(y) - 1);
+                    const float *dy    = derivativeY(long(y));
+                    const float *below = derivativeY(long(y) + 1);
+
+                    const float *v = value(long(y)) - 1;
+
+                    derivative(v - 2 * pitch, v - pitch, v + pitch, v + 2 * pitch, horizontal.data(), width + 2);
+
+                    emit(y, static_cast<const float*>(horizontal.data() + 1), above, dy, below);
+                }
+            });
+        }
+
+        template<typename T> bool GaussianDerivativeEdges::planes(const ImageView<const T> &source, const ImageView<float> &dx, const ImageView<float> &dy) const {
+
+            if (source.empty() || (dx.empty() && dy.empty())) return false;
+
+            if (!dx.empty() && (dx.width != source.width || dx.height != source.height || dx.channels != 1)) return false;
+            if (!dy.empty() && (dy.width != source.width || dy.height != source.height || dy.channels != 1)) return false;
+
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == dx.data || static_cast<const void*>(source.data) == dy.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            run(input, [&](size_t y, const float *x, const float *, const float *v, const float *){
+                if (!dx.empty()) std::copy(x, x + dx.width, dx.row(y));
+                if (!dy.empty()) std::copy(v, v + dy.width, dy.row(y));
+            });
+
+            return true;
+        }
+
+        template<typename T> bool GaussianDerivativeEdges::edges(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == destination.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            const float  threshold = _options.threshold;
+            const T      one       = PixelTraits<T>::fromFloat(PixelTraits<T>::maximum);
+            const size_t c         = destination.channels;
+            const size_t rgb       = c == 4 ? 3 : c;
+
+            run(input, [&](size_t y, const float *dx, const float *above, const float *dy, const float *below){
+
+                T *out = destination.row(y);
+
+                for (size_t x = 0; x < destination.width; x++, out += c) {
+
+                    bool edge = (dx[x] > threshold && dx[long(x) - 1] > threshold && dx[x + 1] > threshold) ||
+                                (dy[x] > threshold && above[x] > threshold && below[x] > threshold);
+
+                    T v = edge ? one : T(0);
+                    for (size_t i = 0; i < rgb; i++) out[i] = v;
+                    if (c == 4) out[3] = one;
+                }
+            });
+
+            return true;
+        }
+
+        bool GaussianDerivativeEdges::derivatives(const ImageView<const uint8_t> &source, const ImageView<float> &dx, const ImageView<float> &dy) const {
+            return planes(source, dx, dy);
+        }
+
+        bool GaussianDerivativeEdges::derivatives(const ImageView<const uint16_t> &source, const ImageView<float> &dx, const ImageView<float> &dy) const {
+            return planes(source, dx, dy);
+        }
+
+        bool GaussianDerivativeEdges::derivatives(const ImageView<const float> &source, const ImageView<float> &dx, const ImageView<float> &dy) const {
+            return planes(source, dx, dy);
+        }
+
+        bool GaussianDerivativeEdges::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return edges(source, destination);
+        }
+
+        bool GaussianDerivativeEdges::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return edges(source, destination);
+        }
+
+        bool GaussianDerivativeEdges::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return edges(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPGaussianDerivativeEdgesApply(IMPCpuImage source, IMPCpuImage destination, uint32_t pitch, float threshold) {
+
+        if (source.format != destination.format) return false;
+
+        GaussianDerivativeEdges::Options options;
+        options.pitch     = std::max<uint32_t>(pitch, 1);
+        options.threshold = threshold;
+
+        GaussianDerivativeEdges engine(options);
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = engine.apply(view, target);
+        });
+
+        return done;
+    }
+}
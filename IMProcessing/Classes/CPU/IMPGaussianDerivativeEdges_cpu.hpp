@@ -0,0 +1,79 @@
+//
+//  IMPGaussianDerivativeEdges_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPGaussianDerivativeEdges_cpu_hpp
+#define IMPGaussianDerivativeEdges_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// kernel_gaussianDerivativeEdge: |[-3 -5 0 5 3]| derivatives of the max colour component with
+        /// taps `pitch` pixels apart, a pixel is an edge when the x or y derivative exceeds the
+        /// threshold at the pixel and both its neighbours along the same axis.
+        ///
+        /// Every derivative is computed once: the x derivative of a row and a 3 row window of y
+        /// derivatives stream through rings of source rows, bands of rows run in parallel. Samples
+        /// are taken at pixel centres with replicated edges, edges are written at the pixel itself.
+        ///
+        class GaussianDerivativeEdges {
+
+        public:
+
+            struct Options {
+                /// Distance between the derivative taps in pixels
+                size_t pitch     = 1;
+                /// The shader compares derivatives with 1
+                float  threshold = 1.0f;
+            };
+
+            explicit GaussianDerivativeEdges(const Options &options): _options(options) {}
+
+            GaussianDerivativeEdges(): GaussianDerivativeEdges(Options()) {}
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Absolute x and y derivative planes of 1 channel, either of them may be empty
+            ///
+            bool derivatives(const ImageView<const uint8_t>  &source, const ImageView<float> &dx, const ImageView<float> &dy) const;
+            bool derivatives(const ImageView<const uint16_t> &source, const ImageView<float> &dx, const ImageView<float> &dy) const;
+            bool derivatives(const ImageView<const float>    &source, const ImageView<float> &dx, const ImageView<float> &dy) const;
+
+            ///
+            /// Edges: 1 in colour channels, 0 elsewhere and alpha 1. Source and destination may be
+            /// the same image.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            ///
+            /// row(y, dx, above, dy, below) for every row: dx covers columns -1 ... width, the y rows
+            /// cover columns 0 ... width - 1
+            ///
+            template<typename T, typename F> void run(const ImageView<const T> &source, F &&row) const;
+
+            template<typename T> bool planes(const ImageView<const T> &source, const ImageView<float> &dx, const ImageView<float> &dy) const;
+            template<typename T> bool edges(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPGaussianDerivativeEdges_cpu_hpp */
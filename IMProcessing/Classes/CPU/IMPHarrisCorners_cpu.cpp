@@ -0,0 +1,477 @@
+//
+//  IMPHarrisCorners_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPHarrisCorners_cpu.hpp"
+#include "IMPHarrisCorners-Bridging-CPU.h"
+#include "IMPNonMaximumSuppression_cpu.hpp"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        constexpr size_t HarrisCorners::tileSize;
+
+        namespace {
+
+            //
+            // Tile plane over image columns [x0, x0 + width) and rows [y0, y0 + height). Samples
+            // outside the image are the ones of the nearest image pixel, as clamp_to_edge reads them.
+            //
+            struct Plane {
+
+                long   x0 = 0, y0 = 0;
+                size_t width = 0, height = 0;
+
+                /// Part of the plane inside the image
+                long   vx0 = 0, vx1 = 0, vy0 = 0, vy1 = 0;
+
+                AlignedBuffer<float> data;
+
+                void reset(long x, long y, size_t w, size_t h, size_t imageWidth, size_t imageHeight) {
+                    x0 = x; y0 = y; width = w; height = h;
+                    vx0 = std::max(x0, 0L); vx1 = std::min(x0 + long(w), long(imageWidth));
+                    vy0 = std::max(y0, 0L); vy1 = std::min(y0 + long(h), long(imageHeight));
+                    data.resize(w * h);
+                }
+
+                inline float *row(long y) { return data.data() + size_t(y - y0) * width; }
+
+                /// Fill the outside of the image from its edge samples
+                void replicate() {
+                    const size_t left = size_t(vx0 - x0), right = size_t(vx1 - x0);
+                    for (long y = vy0; y < vy1; y++) {
+                        float *r = row(y);
+                        std::fill(r, r + left, r[left]);
+                        std::fill(r + right, r + width, r[right - 1]);
+                    }
+                    for (long y = y0; y < vy0; y++)                 std::copy(row(vy0), row(vy0) + width, row(y));
+                    for (long y = vy1; y < y0 + long(height); y++)  std::copy(row(vy1 - 1), row(vy1 - 1) + width, row(y));
+                }
+            };
+
+            //
+            // kIMP_Y_YCbCr_factor, the luma Kernel3x3Colors samples, normalized
+            //
+            template<typename T> inline float luma(const T *p, size_t channels) {
+                const float scale = 1.0f / PixelTraits<T>::maximum;
+                if (channels < 3) return float(p[0]) * scale;
+                return (0.299f * float(p[0]) + 0.587f * float(p[1]) + 0.114f * float(p[2])) * scale;
+            }
+
+            //
+            // out[i] = sum w[k] * in[k][i]
+            //
+            inline void weighted(const std::vector<float> &w, const float *const *in, float *out, size_t count) {
+
+                size_t i = 0;
+
+                for (; i + 4 <= count; i += 4) {
+                    Vec4f acc(0.0f);
+                    for (size_t k = 0; k < w.size(); k++) acc = madd(Vec4f(w[k]), Vec4f::load(in[k] + i), acc);
+                    acc.store(out + i);
+                }
+                for (; i < count; i++) {
+                    float acc = 0.0f;
+                    for (size_t k = 0; k < w.size(); k++) acc += w[k] * in[k][i];
+                    out[i] = acc;
+                }
+            }
+
+            struct Workspace {
+                Plane luma;
+                Plane product[3];
+                Plane horizontal[3];
+                Plane blurred[3];
+                Plane response;
+                std::vector<const float*> taps;
+            };
+        }
+
+        template<typename T> bool HarrisCorners::run(const ImageView<const T> &source, std::vector<Corner> &corners) const {
+
+            corners.clear();
+
+            if (source.empty()) return false;
+
+            const size_t width  = source.width;
+            const size_t height = source.height;
+
+            const long  texel     = long(std::max<size_t>(_options.texelRadius, 1));
+            const float sigma     = _options.blurRadius;
+            const long  radius    = sigma > 0 ? long(std::ceil(3.0f * sigma)) : 0;
+            const float k         = _options.k;
+            const float scale     = _options.sensitivity;
+            const float threshold = _options.threshold;
+
+            std::vector<float> weights(size_t(2 * radius + 1), 1.0f);
+
+            if (radius > 0) {
+                float sum = 0;
+                for (long i = -radius; i <= radius; i++) sum += weights[size_t(i + radius)] = std::exp(-float(i * i) / (2.0f * sigma * sigma));
+                for (auto &w: weights) w /= sum;
+            }
+
+            const size_t columns = (width  + tileSize - 1) / tileSize;
+            const size_t rows    = (height + tileSize - 1) / tileSize;
+
+            NonMaximumSuppression::Options suppressionOptions;
+            suppressionOptions.threshold   = threshold;
+            suppressionOptions.topK        = _options.topK;
+            suppressionOptions.minDistance = _options.minDistance;
+
+            const NonMaximumSuppression suppression(suppressionOptions);
+
+            std::vector<std::vector<NonMaximumSuppression::Maximum>> found(columns * rows);
+
+            parallelFor(columns * rows, [&](size_t tile){
+
+                Workspace ws;
+
+                const long tx0 = long((tile % columns) * tileSize), tx1 = std::min(tx0 + long(tileSize), long(width));
+                const long ty0 = long((tile / columns) * tileSize), ty1 = std::min(ty0 + long(tileSize), long(height));
+
+                const size_t tw = size_t(tx1 - tx0), th = size_t(ty1 - ty0);
+
+                //
+                // Regions of every stage: the response has a 1 pixel ring for the suppression, the
+                // tensor the gaussian radius more and the luma the derivative taps more
+                //
+                ws.response.reset(tx0 - 1, ty0 - 1, tw + 2, th + 2, width, height);
+
+                for (int c = 0; c < 3; c++) {
+                    ws.blurred[c].reset(tx0 - 1, ty0 - 1, tw + 2, th + 2, width, height);
+                    ws.horizontal[c].reset(tx0 - 1, ty0 - 1 - radius, tw + 2, th + 2 + 2 * size_t(radius), width, height);
+                    ws.product[c].reset(tx0 - 1 - radius, ty0 - 1 - radius, tw + 2 + 2 * size_t(radius), th + 2 + 2 * size_t(radius), width, height);
+                }
+
+                const Plane &p = ws.product[0];
+
+                ws.luma.reset(p.x0 - texel, p.y0 - texel, p.width + 2 * size_t(texel), p.height + 2 * size_t(texel), width, height);
+
+                for (long y = ws.luma.vy0; y < ws.luma.vy1; y++) {
+                    const T *s = source.row(size_t(y)) + size_t(ws.luma.vx0) * source.channels;
+                    float   *r = ws.luma.row(y) + (ws.luma.vx0 - ws.luma.x0);
+                    for (long x = ws.luma.vx0; x < ws.luma.vx1; x++, s += source.channels) *r++ = luma(s, source.channels);
+                }
+                ws.luma.replicate();
+
+                //
+                // fragment_xyDerivative: Prewitt with taps texelRadius apart, the tensor keeps Ixy signed
+                //
+                for (long y = p.vy0; y < p.vy1; y++) {
+
+                    const long   offset = p.vx0 - ws.luma.x0;
+                    const float *top    = ws.luma.row(y - texel) + offset;
+                    const float *mid    = ws.luma.row(y) + offset;
+                    const float *bottom = ws.luma.row(y + texel) + offset;
+
+                    float *xx = ws.product[0].row(y) + (p.vx0 - p.x0);
+                    float *yy = ws.product[1].row(y) + (p.vx0 - p.x0);
+                    float *xy = ws.product[2].row(y) + (p.vx0 - p.x0);
+
+                    for (long i = 0, n = p.vx1 - p.vx0; i < n; i++) {
+                        float hd = (top[i + texel] + mid[i + texel] + bottom[i + texel]) - (top[i - texel] + mid[i - texel] + bottom[i - texel]);
+                        float vd = (bottom[i - texel] + bottom[i] + bottom[i + texel]) - (top[i - texel] + top[i] + top[i + texel]);
+                        xx[i] = hd * hd;
+                        yy[i] = vd * vd;
+                        xy[i] = hd * vd;
+                    }
+                }
+
+                //
+                // Separable gaussian window of the tensor
+                //
+                ws.taps.resize(weights.size());
+
+                for (int c = 0; c < 3; c++) {
+
+                    ws.product[c].replicate();
+
+                    Plane &h = ws.horizontal[c];
+                    Plane &b = ws.blurred[c];
+
+                    for (long y = h.y0; y < h.y0 + long(h.height); y++) {
+                        const float *in = ws.product[c].row(y);
+                        for (size_t j = 0; j < weights.size(); j++) ws.taps[j] = in + j;
+                        weighted(weights, ws.taps.data(), h.row(y), h.width);
+                    }
+
+                    for (long y = b.y0; y < b.y0 + long(b.height); y++) {
+                        for (size_t j = 0; j < weights.size(); j++) ws.taps[j] = h.row(y - radius + long(j));
+                        weighted(weights, ws.taps.data(), b.row(y), b.width);
+                    }
+                }
+
+                //
+                // fragment_harrisCorner
+                //
+                Plane &r = ws.response;
+
+                for (long y = r.vy0; y < r.vy1; y++) {
+                    const long   offset = r.vx0 - r.x0;
+                    const float *xx = ws.blurred[0].row(y) + offset;
+                    const float *yy = ws.blurred[1].row(y) + offset;
+                    const float *xy = ws.blurred[2].row(y) + offset;
+                    float       *out = r.row(y) + offset;
+                    for (long i = 0, n = r.vx1 - r.vx0; i < n; i++) {
+                        float trace = xx[i] + yy[i];
+                        out[i] = (xx[i] * yy[i] - xy[i] * xy[i] - k * trace * trace) * scale;
+                    }
+                }
+                r.replicate();
+
+                //
+                // fragment_nonMaximumSuppression straight into the tile list
+                //
+                NonMaximumSuppression::suppress([&](long y){ return static_cast<const float*>(r.row(y) - r.x0); },
+                                                tx0, tx1, ty0, ty1, threshold, found[tile]);
+            });
+
+            //
+            // Tile lists are compacted into raster order, the strongest selected as the options say
+            //
+            std::vector<NonMaximumSuppression::Maximum> maxima;
+
+            suppression.compact(found, columns, maxima);
+
+            corners.resize(maxima.size());
+
+            for (size_t i = 0; i < maxima.size(); i++) {
+                corners[i] = Corner{ float(maxima[i].x) / float(width), float(maxima[i].y) / float(height), maxima[i].response, {0, 0, 0, 0} };
+            }
+
+            if (_options.slopeRegion > 0) CornerSlopes(size_t(texel), _options.slopeRegion).apply(source, corners);
+
+            return true;
+        }
+
+        bool HarrisCorners::detect(const ImageView<const uint8_t> &source, std::vector<Corner> &corners) const {
+            return run(source, corners);
+        }
+
+        bool HarrisCorners::detect(const ImageView<const uint16_t> &source, std::vector<Corner> &corners) const {
+            return run(source, corners);
+        }
+
+        bool HarrisCorners::detect(const ImageView<const float> &source, std::vector<Corner> &corners) const {
+            return run(source, corners);
+        }
+
+        template<typename T> bool CornerSlopes::run(const ImageView<const T> &source, std::vector<HarrisCorners::Corner> &corners) const {
+
+            if (source.empty()) return false;
+
+            for (auto &c: corners) std::fill(c.slope, c.slope + 4, 0.0f);
+
+            if (_regionSize == 0 || corners.empty()) return true;
+
+            const long width  = long(source.width);
+            const long height = long(source.height);
+            const long texel  = long(_texelRadius);
+
+            //
+            // Slope window: offsets [-regionSize/2, regionSize/2] on both axes
+            //
+            const long rs = -long(_regionSize / 2);
+            const long re =  long(_regionSize / 2) + 1;
+
+            struct Point { long x, y; size_t index; };
+
+            std::vector<Point> points(corners.size());
+
+            for (size_t i = 0; i < corners.size(); i++) {
+                points[i].x = std::min(std::max(long(std::lround(corners[i].x * float(width))),  0L), width  - 1);
+                points[i].y = std::min(std::max(long(std::lround(corners[i].y * float(height))), 0L), height - 1);
+                points[i].index = i;
+            }
+
+            std::stable_sort(points.begin(), points.end(), [](const Point &a, const Point &b){ return a.y < b.y; });
+
+            const size_t stride    = size_t(width) + 1;
+            const size_t padded    = size_t(width + 2 * texel);
+            const size_t lumaRing  = size_t(2 * texel + 1);
+            const size_t tableRing = _regionSize + 2;
+
+            parallelStrips(size_t(height), 64, [&](size_t begin, size_t end){
+
+                auto first = std::lower_bound(points.begin(), points.end(), long(begin), [](const Point &p, long y){ return p.y < y; });
+                auto last  = std::lower_bound(first, points.end(), long(end), [](const Point &p, long y){ return p.y < y; });
+
+                if (first == last) return;
+
+                AlignedBuffer<float>  lumas(lumaRing * padded);
+                AlignedBuffer<double> tables(tableRing * stride * 2);
+
+                std::vector<long> loaded(lumaRing, -1);
+
+                auto lumaRow = [&](long r){
+                    r = std::min(std::max(r, 0L), height - 1);
+                    const size_t slot = size_t(r) % lumaRing;
+                    float *row = lumas.data() + slot * padded + texel;
+                    if (loaded[slot] != r) {
+                        const T *p = source.row(size_t(r));
+                        for (long x = 0; x < width; x++, p += source.channels) row[x] = luma(p, source.channels);
+                        std::fill(row - texel, row, row[0]);
+                        std::fill(row + width, row + width + texel, row[width - 1]);
+                        loaded[slot] = r;
+                    }
+                    return static_cast<const float*>(row);
+                };
+
+                //
+                // Table row t holds interleaved hd^2, vd^2 sums of rows [start, start + t) and columns
+                // [0, c) at 2c, the ring keeps the last regionSize + 2 rows
+                //
+                const long start = std::max(long(begin) + rs, 0L);
+                long built = 0;
+
+                std::fill(tables.data(), tables.data() + 2 * stride, 0.0);
+
+                auto table = [&](long y){
+                    const long t = y - start;
+                    for (; built < t; built++) {
+
+                        const long   r      = start + built;
+                        const float *top    = lumaRow(r - texel);
+                        const float *mid    = lumaRow(r);
+                        const float *bottom = lumaRow(r + texel);
+
+                        const double *above = tables.data() + size_t(built) % tableRing * stride * 2;
+                        double       *out   = tables.data() + size_t(built + 1) % tableRing * stride * 2;
+
+                        double sx = 0, sy = 0;
+                        out[0] = out[1] = 0;
+
+                        for (long i = 0; i < width; i++) {
+                            float hd = (top[i + texel] + mid[i + texel] + bottom[i + texel]) - (top[i - texel] + mid[i - texel] + bottom[i - texel]);
+                            float vd = (bottom[i - texel] + bottom[i] + bottom[i + texel]) - (top[i - texel] + top[i] + top[i + texel]);
+                            sx += double(hd * hd);
+                            sy += double(vd * vd);
+                            out[2 * i + 2] = above[2 * i + 2] + sx;
+                            out[2 * i + 3] = above[2 * i + 3] + sy;
+                        }
+                    }
+                    return static_cast<const double*>(tables.data() + size_t(t) % tableRing * stride * 2);
+                };
+
+                for (auto p = first; p != last; ++p) {
+
+                    const long x0 = std::max(p->x + rs, 0L), x1 = std::min(p->x + re, width);
+                    const long y0 = std::max(p->y + rs, 0L), y1 = std::min(p->y + re, height);
+
+                    //
+                    // Rows are requested in increasing order, the lower ones stay in the ring
+                    //
+                    const double *b = table(y1);
+                    const double *m = table(p->y);
+                    const double *a = table(y0);
+
+                    auto sum = [](const double *lower, const double *upper, long u0, long u1, int c){
+                        return (lower[2 * u1 + c] - lower[2 * u0 + c]) - (upper[2 * u1 + c] - upper[2 * u0 + c]);
+                    };
+
+                    double slope[4] = {
+                        sum(b, a, x0, p->x, 1),
+                        sum(m, a, x0, x1,   0),
+                        sum(b, m, x0, x1,   0),
+                        sum(b, a, p->x, x1, 1)
+                    };
+
+                    const double length = std::sqrt(slope[0] * slope[0] + slope[1] * slope[1] + slope[2] * slope[2] + slope[3] * slope[3]);
+
+                    float *out = corners[p->index].slope;
+                    for (int i = 0; i < 4; i++) out[i] = float(length > 0 ? slope[i] / length : slope[i]);
+                }
+            });
+
+            return true;
+        }
+
+        bool CornerSlopes::apply(const ImageView<const uint8_t> &source, std::vector<HarrisCorners::Corner> &corners) const {
+            return run(source, corners);
+        }
+
+        bool CornerSlopes::apply(const ImageView<const uint16_t> &source, std::vector<HarrisCorners::Corner> &corners) const {
+            return run(source, corners);
+        }
+
+        bool CornerSlopes::apply(const ImageView<const float> &source, std::vector<HarrisCorners::Corner> &corners) const {
+            return run(source, corners);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static HarrisCorners::Options harrisOptions(const IMPHarrisCornersOptions &options) {
+    HarrisCorners::Options o;
+    o.texelRadius = std::max<uint32_t>(options.texelRadius, 1);
+    o.blurRadius  = options.blurRadius;
+    o.sensitivity = options.sensitivity;
+    o.k           = options.k;
+    o.threshold   = options.threshold;
+    o.slopeRegion = options.slopeRegion;
+    o.topK        = options.topK;
+    o.minDistance = options.minDistance;
+    return o;
+}
+
+extern "C" {
+
+    size_t IMPHarrisCornersDetect(IMPCpuImage source, IMPCpuCorner *corners, size_t capacity, IMPHarrisCornersOptions options) {
+
+        HarrisCorners harris(harrisOptions(options));
+
+        std::vector<HarrisCorners::Corner> found;
+
+        dispatch(source, [&](auto view){
+            harris.detect(view.readonly(), found);
+        });
+
+        const size_t count = std::min(capacity, found.size());
+
+        for (size_t i = 0; corners && i < count; i++) {
+            IMPCpuCorner &c = corners[i];
+            c.point[0] = found[i].x;
+            c.point[1] = found[i].y;
+            std::copy(found[i].slope, found[i].slope + 4, c.slope);
+            c.color[0] = c.color[1] = c.color[2] = c.color[3] = 0;
+        }
+
+        return found.size();
+    }
+
+    bool IMPCornerSlopes(IMPCpuImage source, IMPCpuCorner *corners, size_t count, uint32_t texelRadius, uint32_t regionSize) {
+
+        if (!corners) return false;
+
+        std::vector<HarrisCorners::Corner> list(count);
+
+        for (size_t i = 0; i < count; i++) {
+            list[i].x = corners[i].point[0];
+            list[i].y = corners[i].point[1];
+        }
+
+        CornerSlopes slopes(texelRadius, regionSize);
+
+        bool done = false;
+
+        dispatch(source, [&](auto view){
+            done = slopes.apply(view.readonly(), list);
+        });
+
+        for (size_t i = 0; done && i < count; i++) std::copy(list[i].slope, list[i].slope + 4, corners[i].slope);
+
+        return done;
+    }
+}
@@ -0,0 +1,122 @@
+//
+//  IMPHarrisCorners_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHarrisCorners_cpu_hpp
+#define IMPHarrisCorners_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Harris corners with the IMPHarrisCornerDetector stages fused per tile: luma,
+        /// fragment_xyDerivative, gaussian window of the structure tensor, fragment_harrisCorner and
+        /// fragment_nonMaximumSuppression. A tile and its halo stay in cache, no full frame
+        /// intermediate is written and Ixy keeps full precision instead of the (x+1)/2 packing.
+        /// Tiles run in parallel, every stage samples with replicated edges like the shaders do.
+        /// Tiles suppress into local lists which NonMaximumSuppression compacts, no mask is written.
+        ///
+        class HarrisCorners {
+
+        public:
+
+            struct Options {
+                /// Distance of the derivative taps in pixels, IMPHarrisCornerDetector.defaultTexelRadius
+                size_t texelRadius = 2;
+                /// Gaussian sigma of the tensor window, IMPHarrisCornerDetector.defaultBlurRadius; 0 skips it
+                float  blurRadius  = 2.0f;
+                /// Response scale, IMPHarrisCorner.defaultSensitivity
+                float  sensitivity = 16.0f;
+                /// Harris k
+                float  k           = 0.04f;
+                /// Minimal scaled response of a corner, IMPNonMaximumSuppression.defaultThreshold
+                float  threshold   = 0.2f;
+                /// CornerSlopes region, 0 leaves the slopes zero
+                size_t slopeRegion = 24;
+                /// Keep the strongest corners only, 0 keeps all
+                size_t topK        = 0;
+                /// Drop corners closer than that to a stronger kept one, in pixels; 0 keeps all
+                float  minDistance = 0;
+            };
+
+            ///
+            /// IMPCorner: point in normalized texture coordinates, slope of the left, top, bottom and
+            /// right quadrants
+            ///
+            struct Corner {
+                float x, y;
+                float response;
+                float slope[4];
+            };
+
+            /// Output tile side, the working set of a tile is about 200 KB
+            static constexpr size_t tileSize = 64;
+
+            explicit HarrisCorners(const Options &options): _options(options) {}
+
+            HarrisCorners(): HarrisCorners(Options()) {}
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Corners of the source in raster order, replaces the content of corners
+            ///
+            bool detect(const ImageView<const uint8_t>  &source, std::vector<Corner> &corners) const;
+            bool detect(const ImageView<const uint16_t> &source, std::vector<Corner> &corners) const;
+            bool detect(const ImageView<const float>    &source, std::vector<Corner> &corners) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, std::vector<Corner> &corners) const;
+
+            Options _options;
+        };
+
+        ///
+        /// Corner slopes of the GPU detector: sums of the squared fragment_xyDerivative derivatives over the
+        /// left, top, bottom and right quadrants of the (regionSize+1)^2 window around a corner,
+        /// normalized as a vector. Vertical derivatives go to left and right, horizontal ones to top
+        /// and bottom, pixels outside the image add nothing.
+        ///
+        /// Every quadrant is four lookups of a summed-area table of both derivatives. The table is
+        /// exact in doubles and built only for the rows around corners, by bands of rows in parallel.
+        ///
+        class CornerSlopes {
+
+        public:
+
+            explicit CornerSlopes(size_t texelRadius = 2, size_t regionSize = 24):
+            _texelRadius(std::max<size_t>(texelRadius, 1)), _regionSize(regionSize) {}
+
+            ///
+            /// Fill slope of every corner, the corners may be in any order
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, std::vector<HarrisCorners::Corner> &corners) const;
+            bool apply(const ImageView<const uint16_t> &source, std::vector<HarrisCorners::Corner> &corners) const;
+            bool apply(const ImageView<const float>    &source, std::vector<HarrisCorners::Corner> &corners) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, std::vector<HarrisCorners::Corner> &corners) const;
+
+            size_t _texelRadius;
+            size_t _regionSize;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPHarrisCorners_cpu_hpp */
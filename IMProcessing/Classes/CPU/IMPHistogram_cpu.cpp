@@ -0,0 +1,200 @@
+//
+//  IMPHistogram_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPHistogram_cpu.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        const int HistogramZonesSolver::indices[12] = {0, 1, 33, 57,  72, 94, 118, 143, 169,  197, 225, 255};
+
+        //
+        // Pixel coordinates range [begin,end) which passes coordsIsInsideBox() test along one axis
+        //
+        static void insideRange(size_t size, float low, float high, size_t &begin, size_t &end) {
+            begin = size; end = size;
+            for (size_t i = 0; i < size; i++) {
+                float c = float(i)/float(size);
+                bool inside = c >= low && c < high;
+                if (inside && begin == size) begin = i;
+                if (!inside && begin != size) { end = i; break; }
+            }
+            if (begin == size) end = size;
+        }
+
+        void Histogram::clear() {
+            memset(bins, 0, sizeof(bins));
+        }
+
+        void Histogram::add(const Histogram &histogram) {
+            for (size_t c = 0; c < channels; c++)
+                for (size_t i = 0; i < size; i++)
+                    bins[c][i] += histogram.bins[c][i];
+        }
+
+        void Histogram::accumulate(const ImageView<const uint8_t> &image, const Region &region) {
+
+            if (image.empty() || image.channels < 3) return;
+
+            size_t x0, x1, y0, y1;
+            insideRange(image.width,  region.left,   1.0f - region.right, x0, x1);
+            insideRange(image.height, region.bottom, 1.0f - region.top,   y0, y1);
+
+            const size_t cn = image.channels;
+            const bool hasAlpha = cn > 3;
+
+            for (size_t y = y0; y < y1; y++) {
+                const uint8_t *p = image.row(y) + x0 * cn;
+                for (size_t x = x0; x < x1; x++, p += cn) {
+
+                    if (hasAlpha && p[3] == 0) continue;
+
+                    uint32_t r = p[0], g = p[1], b = p[2];
+
+                    //
+                    // kIMP_Y_YCbCr_factor in 16.16 fixed point, weights sum is exactly 1.0
+                    //
+                    uint32_t luma = (19595 * r + 38470 * g + 7471 * b) >> 16;
+                    if (hasAlpha) luma = luma * p[3] / 255;
+
+                    bins[0][r]++;
+                    bins[1][g]++;
+                    bins[2][b]++;
+                    bins[3][luma]++;
+                }
+            }
+        }
+
+        float Histogram::countOfBins(size_t channel) const {
+            double sum = 0;
+            for (size_t i = 0; i < size; i++) sum += bins[channel][i];
+            return float(sum);
+        }
+
+        float Histogram::meanOf(size_t channel) const {
+            double m = 0, denom = 0;
+            for (size_t i = 0; i < size; i++) {
+                m     += double(bins[channel][i]) * double(i)/double(size-1);
+                denom += double(bins[channel][i]);
+            }
+            return denom > 0 ? float(m/denom) : 0;
+        }
+
+        //
+        // vDSP_vrsum -> vDSP_vthrsc -> vDSP_nzcros sequence of IMPHistogram.search_clipping
+        //
+        bool Histogram::searchClipping(size_t channel, float clipping, size_t &position) const {
+
+            double cdf[size];
+            cdf[0] = 0;
+            for (size_t i = 1; i < size; i++) cdf[i] = cdf[i-1] + double(bins[channel][i]);
+
+            double denom = cdf[size-1];
+            if (denom > 0)
+                for (size_t i = 0; i < size; i++) cdf[i] /= denom;
+
+            bool previous = cdf[0] >= clipping;
+            for (size_t i = 1; i < size; i++) {
+                bool current = cdf[i] >= clipping;
+                if (current != previous) {
+                    position = i;
+                    return true;
+                }
+            }
+            position = 0;
+            return false;
+        }
+
+        float Histogram::lowOf(size_t channel, float clipping) const {
+            size_t low = 0;
+            if (!searchClipping(channel, clipping, low)) low = 0;
+            low = low > 0 ? low - 1 : 0;
+            return float(low)/float(size);
+        }
+
+        float Histogram::highOf(size_t channel, float clipping) const {
+            size_t high = 0;
+            if (!searchClipping(channel, 1.0f - clipping, high)) high = size;
+            high = high < size ? high + 1 : size;
+            return float(high)/float(size);
+        }
+
+        void HistogramRangeSolver::solve(const Histogram &histogram) {
+            for (size_t c = 0; c < Histogram::channels; c++) {
+                minimum[c] = histogram.lowOf(c, shadows);
+                maximum[c] = histogram.highOf(c, highlights);
+            }
+        }
+
+        void HistogramDominantColorSolver::solve(const Histogram &histogram) {
+            for (size_t c = 0; c < Histogram::channels; c++) {
+                color[c] = histogram.meanOf(c);
+            }
+        }
+
+        static void normalize(float v[3]) {
+            float l = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+            if (l <= 0) return;
+            v[0] /= l; v[1] /= l; v[2] /= l;
+        }
+
+        void HistogramZonesSolver::solve(const Histogram &histogram) {
+
+            const size_t w = Histogram::w;
+            const float  binCount = histogram.countOfBins(w);
+
+            if (binCount <= 0) {
+                *this = HistogramZonesSolver();
+                return;
+            }
+
+            for (int i = 0; i < 12; i++) {
+                int index = indices[i];
+                if (i == 0 || i == 11) {
+                    steps[i] = float(histogram(w, size_t(index)))/binCount;
+                }
+                else {
+                    double zone = 0;
+                    for (int j = index; j < indices[i+1]; j++) zone += histogram(w, size_t(j));
+                    steps[i] = float(zone)/binCount;
+                }
+            }
+
+            //
+            // Zones.line.gaussianDistribution(fi:1, mu:..., sigma:...) over 256 points of [0,1]
+            //
+            double shadows = 0, mid = 0, highlights = 0;
+            for (size_t i = 0; i < Histogram::size; i++) {
+                double x = double(i)/double(Histogram::size - 1);
+                double h = histogram(w, i);
+                shadows    += h * std::exp(-0.5 * std::pow((x - 0.0)/0.1, 2));
+                mid        += h * std::exp(-0.5 * std::pow((x - 0.5)/0.1, 2));
+                highlights += h * std::exp(-0.5 * std::pow((x - 1.0)/0.2, 2));
+            }
+
+            balance[0] = float(shadows)/binCount;
+            balance[1] = float(mid)/binCount;
+            balance[2] = float(highlights)/binCount;
+            normalize(balance);
+
+            spots[0] = steps[3];
+            spots[1] = steps[5];
+            spots[2] = steps[7];
+            normalize(spots);
+
+            range[0] = steps[1] + steps[2] + steps[3];
+            range[1] = steps[4] + steps[5] + steps[6];
+            range[2] = steps[7] + steps[8] + steps[9];
+            normalize(range);
+        }
+    }
+}
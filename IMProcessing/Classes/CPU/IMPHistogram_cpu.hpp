@@ -0,0 +1,121 @@
+//
+//  IMPHistogram_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHistogram_cpu_hpp
+#define IMPHistogram_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Same meaning as IMPRegion: idents from the image borders in normalized coordinates.
+        ///
+        struct Region {
+            float left   = 0;
+            float right  = 0;
+            float top    = 0;
+            float bottom = 0;
+        };
+
+        ///
+        /// Host-side twin of IMPHistogram: kIMP_HistogramSize bins, x,y,z - color channels, w - luma.
+        /// Binning follows kernel_partialHistogram/channel_binIndex for the RGB color space.
+        ///
+        class Histogram {
+
+        public:
+
+            static const size_t size     = 256;
+            static const size_t channels = 4;
+
+            enum ChannelNo { x = 0, y = 1, z = 2, w = 3 };
+
+            Histogram() { clear(); }
+
+            void clear();
+
+            ///
+            /// Accumulate 8-bit RGB(A) pixels inside the region. Transparent pixels are not counted.
+            ///
+            void accumulate(const ImageView<const uint8_t> &image, const Region &region = Region());
+
+            void add(const Histogram &histogram);
+
+            inline uint32_t operator()(size_t channel, size_t bin) const { return bins[channel][bin]; }
+
+            float countOfBins(size_t channel) const;
+
+            /// Normalized mean intensity, IMPHistogram.meanOf(channel:)
+            float meanOf(size_t channel) const;
+
+            /// Normalized low bound with shadows clipping, IMPHistogram.lowOf(channel:clipping:)
+            float lowOf(size_t channel, float clipping) const;
+
+            /// Normalized high bound with highlights clipping, IMPHistogram.highOf(channel:clipping:)
+            float highOf(size_t channel, float clipping) const;
+
+        private:
+
+            bool searchClipping(size_t channel, float clipping, size_t &position) const;
+
+            uint32_t bins[channels][size];
+        };
+
+        ///
+        /// IMPHistogramRangeSolver
+        ///
+        struct HistogramRangeSolver {
+
+            float shadows    = 0.1f/100.0f;
+            float highlights = 0.1f/100.0f;
+
+            float minimum[Histogram::channels] = {0,0,0,0};
+            float maximum[Histogram::channels] = {0,0,0,0};
+
+            void solve(const Histogram &histogram);
+        };
+
+        ///
+        /// IMPHistogramZonesSolver
+        ///
+        struct HistogramZonesSolver {
+
+            ///                           0  I  II  III  IV  V   VI   VII  VIII  IX   X    XI
+            static const int indices[12];
+
+            float steps[12]  = {0};
+            float balance[3] = {0,0,0};
+            float spots[3]   = {0,0,0};
+            float range[3]   = {0,0,0};
+
+            void solve(const Histogram &histogram);
+        };
+
+        ///
+        /// IMPHistogramDominantColorSolver
+        ///
+        struct HistogramDominantColorSolver {
+
+            float color[Histogram::channels] = {0,0,0,0};
+
+            void solve(const Histogram &histogram);
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPHistogram_cpu_hpp */
@@ -0,0 +1,221 @@
+//
+//  IMPHoughPeaks_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPHoughPeaks_cpu.hpp"
+#include "IMPHoughPeaks-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        constexpr size_t HoughPeaks::bandSize;
+
+        namespace {
+
+            //
+            // More votes first, equal votes in the bin order
+            //
+            inline bool stronger(const HoughPeaks::Peak &a, const HoughPeaks::Peak &b) {
+                return a.votes > b.votes || (a.votes == b.votes && a.index < b.index);
+            }
+
+            //
+            // Bounded heap of the strongest peaks, the weakest one is on the top
+            //
+            inline void keep(std::vector<HoughPeaks::Peak> &heap, const HoughPeaks::Peak &peak, size_t capacity) {
+
+                if (capacity == 0 || heap.size() < capacity) {
+                    heap.push_back(peak);
+                    if (capacity > 0) std::push_heap(heap.begin(), heap.end(), stronger);
+                    return;
+                }
+
+                if (!stronger(peak, heap.front())) return;
+
+                std::pop_heap(heap.begin(), heap.end(), stronger);
+                heap.back() = peak;
+                std::push_heap(heap.begin(), heap.end(), stronger);
+            }
+        }
+
+        size_t HoughPeaks::capacity() const {
+
+            if (_options.linesMax == 0) return 0;
+
+            //
+            // A kept peak suppresses at most the other bins of its box, so the strongest
+            // linesMax * box candidates hold linesMax survivors whenever there are so many
+            //
+            return _options.linesMax * (2 * _options.rhoRadius + 1) * (2 * _options.thetaRadius + 1);
+        }
+
+        void HoughPeaks::finish(std::vector<Peak> &candidates, size_t numrho, std::vector<Peak> &peaks) const {
+
+            std::sort(candidates.begin(), candidates.end(), stronger);
+
+            peaks.clear();
+
+            const size_t limit = _options.linesMax > 0 ? _options.linesMax : candidates.size();
+
+            if (_options.rhoRadius == 0 && _options.thetaRadius == 0) {
+                peaks.assign(candidates.begin(), candidates.begin() + std::min(limit, candidates.size()));
+                return;
+            }
+
+            const long stride = long(numrho + 2);
+            const long dr     = long(_options.rhoRadius);
+            const long dn     = long(_options.thetaRadius);
+
+            for (const auto &c: candidates) {
+
+                if (peaks.size() >= limit) break;
+
+                const long n = long(c.index) / stride;
+                const long r = long(c.index) % stride;
+
+                bool suppressed = false;
+
+                for (const auto &p: peaks) {
+                    if (std::labs(long(p.index) / stride - n) <= dn && std::labs(long(p.index) % stride - r) <= dr) {
+                        suppressed = true;
+                        break;
+                    }
+                }
+
+                if (!suppressed) peaks.push_back(c);
+            }
+        }
+
+        template<typename Bin> void HoughPeaks::scan(const Bin *accumulator, size_t numangle, size_t numrho, std::vector<Peak> &peaks) const {
+
+            const size_t stride   = numrho + 2;
+            const size_t bands    = (numangle + bandSize - 1) / bandSize;
+            const size_t bound    = capacity();
+            const Bin    minimum  = Bin(std::min<uint32_t>(_options.threshold, std::numeric_limits<Bin>::max()));
+            const bool   overflow = _options.threshold >= std::numeric_limits<Bin>::max();
+
+            std::vector<std::vector<Peak>> heaps(bands);
+
+            if (!overflow) {
+                parallelFor(bands, [&](size_t b){
+
+                    auto &heap = heaps[b];
+
+                    for (size_t n = b * bandSize; n < std::min((b + 1) * bandSize, numangle); n++) {
+
+                        const Bin *row = accumulator + (n + 1) * stride + 1;
+
+                        for (size_t r = 0; r < numrho; r++) {
+
+                            const Bin bins = row[r];
+
+                            if (bins <= minimum) continue;
+
+                            if (bins > row[r - 1] && bins >= row[r + 1] &&
+                                bins > row[r - stride] && bins >= row[r + stride]) {
+                                keep(heap, Peak{ uint32_t((n + 1) * stride + r + 1), uint32_t(bins) }, bound);
+                            }
+                        }
+                    }
+                });
+            }
+
+            std::vector<Peak> candidates;
+
+            size_t count = 0;
+            for (const auto &heap: heaps) count += heap.size();
+
+            candidates.reserve(count);
+            for (const auto &heap: heaps) candidates.insert(candidates.end(), heap.begin(), heap.end());
+
+            finish(candidates, numrho, peaks);
+        }
+
+        void HoughPeaks::peaks(const uint16_t *accumulator, size_t numangle, size_t numrho, std::vector<Peak> &peaks) const {
+            scan(accumulator, numangle, numrho, peaks);
+        }
+
+        void HoughPeaks::peaks(const uint32_t *accumulator, size_t numangle, size_t numrho, std::vector<Peak> &peaks) const {
+            scan(accumulator, numangle, numrho, peaks);
+        }
+
+        void HoughPeaks::peaks(const HoughSpace &space, std::vector<Peak> &peaks) const {
+            if (space.wide()) scan(space.bins32(), space.numangle(), space.numrho(), peaks);
+            else              scan(space.bins16(), space.numangle(), space.numrho(), peaks);
+        }
+
+        void HoughPeaks::select(const std::vector<Peak> &candidates, size_t numrho, std::vector<Peak> &peaks) const {
+
+            const size_t bound = capacity();
+
+            std::vector<Peak> heap;
+            heap.reserve(bound > 0 ? std::min(bound, candidates.size()) : candidates.size());
+
+            for (const auto &c: candidates) keep(heap, c, bound);
+
+            finish(heap, numrho, peaks);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static HoughPeaks::Options peaksOptions(const IMPHoughPeaksOptions &options) {
+    HoughPeaks::Options o;
+    o.threshold   = options.threshold;
+    o.linesMax    = options.linesMax;
+    o.rhoRadius   = options.rhoRadius;
+    o.thetaRadius = options.thetaRadius;
+    return o;
+}
+
+static size_t copyPeaks(const std::vector<HoughPeaks::Peak> &found, IMPCpuHoughPeak *peaks, size_t capacity) {
+
+    const size_t count = std::min(capacity, found.size());
+
+    for (size_t i = 0; peaks && i < count; i++) {
+        peaks[i].index = found[i].index;
+        peaks[i].votes = found[i].votes;
+    }
+
+    return found.size();
+}
+
+extern "C" {
+
+    size_t IMPHoughPeaksFind(const uint32_t *accumulator, size_t numangle, size_t numrho,
+                             IMPHoughPeaksOptions options, IMPCpuHoughPeak *peaks, size_t capacity) {
+
+        if (!accumulator) return 0;
+
+        std::vector<HoughPeaks::Peak> found;
+
+        HoughPeaks(peaksOptions(options)).peaks(accumulator, numangle, numrho, found);
+
+        return copyPeaks(found, peaks, capacity);
+    }
+
+    size_t IMPHoughPeaksSelect(const IMPCpuHoughPeak *candidates, size_t count, size_t numrho,
+                               IMPHoughPeaksOptions options, IMPCpuHoughPeak *peaks, size_t capacity) {
+
+        if (!candidates && count > 0) return 0;
+
+        std::vector<HoughPeaks::Peak> list(count), found;
+
+        for (size_t i = 0; i < count; i++) list[i] = HoughPeaks::Peak{ candidates[i].index, candidates[i].votes };
+
+        HoughPeaks(peaksOptions(options)).select(list, numrho, found);
+
+        return copyPeaks(found, peaks, capacity);
+    }
+}
@@ -0,0 +1,93 @@
+//
+//  IMPHoughPeaks_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHoughPeaks_cpu_hpp
+#define IMPHoughPeaks_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPHoughSpace_cpu.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Strongest peaks of an IMPHoughSpace accumulator: a bin is a peak when it is greater than
+        /// the threshold, strictly greater than its left and upper neighbours and not less than the
+        /// right and lower ones, the test of kernel_houghSpaceLocalMaximums.
+        ///
+        /// Bands of angle rows are scanned in parallel, each keeps its best peaks in a bounded heap,
+        /// the heaps are merged and sorted at the end: O(bins + K log K) rather than sorting the
+        /// whole accumulator. A peak may suppress weaker ones within a radius in rho and theta
+        /// bins; the heaps then keep enough candidates that suppression never starves the result.
+        ///
+        class HoughPeaks {
+
+        public:
+
+            struct Options {
+                /// Votes a peak must exceed
+                uint32_t threshold   = 0;
+                /// Strongest peaks to keep, 0 keeps all
+                size_t   linesMax    = 100;
+                /// Weaker peaks within these distance and angle bins of a kept one are dropped, 0 keeps all
+                size_t   rhoRadius   = 0;
+                size_t   thetaRadius = 0;
+            };
+
+            ///
+            /// Bin (n + 1) * (numrho + 2) + r + 1 and its votes, the uint2 of the GPU maxima
+            ///
+            struct Peak {
+                uint32_t index;
+                uint32_t votes;
+            };
+
+            /// Angle rows of a band scanned by one task
+            static constexpr size_t bandSize = 16;
+
+            explicit HoughPeaks(const Options &options): _options(options) {}
+
+            HoughPeaks(): HoughPeaks(Options()) {}
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Peaks of an accumulator of (numangle + 2) * (numrho + 2) bins, the strongest first,
+            /// equal votes in the bin order
+            ///
+            void peaks(const uint16_t *accumulator, size_t numangle, size_t numrho, std::vector<Peak> &peaks) const;
+            void peaks(const uint32_t *accumulator, size_t numangle, size_t numrho, std::vector<Peak> &peaks) const;
+            void peaks(const HoughSpace &space, std::vector<Peak> &peaks) const;
+
+            ///
+            /// Strongest of the maxima found elsewhere, e.g. by the GPU, the threshold is not applied
+            ///
+            void select(const std::vector<Peak> &candidates, size_t numrho, std::vector<Peak> &peaks) const;
+
+        private:
+
+            template<typename Bin> void scan(const Bin *accumulator, size_t numangle, size_t numrho, std::vector<Peak> &peaks) const;
+
+            /// Candidates a heap keeps, 0 is unbounded
+            size_t capacity() const;
+
+            void finish(std::vector<Peak> &candidates, size_t numrho, std::vector<Peak> &peaks) const;
+
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPHoughPeaks_cpu_hpp */
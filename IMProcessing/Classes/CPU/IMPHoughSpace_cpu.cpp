@@ -0,0 +1,466 @@
+//
+//  IMPHoughSpace_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPHoughSpace_cpu.hpp"
+#include "IMPHoughSpace-Bridging-CPU.h"
+#include "IMPSobelGradient_cpu.hpp"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        HoughSpace::HoughSpace(size_t width, size_t height, const Options &options):
+        _options(options), _width(width), _height(height) {
+
+            _numangle = size_t(std::max(std::round((options.maxTheta - options.minTheta) / options.thetaStep), 0.0f));
+            _numrho   = size_t(std::max(std::round((float(width + height) * 2.0f + 1.0f) / options.rhoStep), 0.0f));
+
+            _tabSin.resize(_numangle);
+            _tabCos.resize(_numangle);
+
+            const float irho = 1.0f / options.rhoStep;
+
+            float angle = options.minTheta;
+            for (size_t n = 0; n < _numangle; n++) {
+                _tabSin[n] = std::sin(angle) * irho;
+                _tabCos[n] = std::cos(angle) * irho;
+                angle += options.thetaStep;
+            }
+        }
+
+        template<typename Bin> void HoughSpace::vote(const std::vector<Point> &points, Bin *accumulator) const {
+
+            const size_t stride = _numrho + 2;
+            const float  offset = (float(_numrho) - 1.0f) * 0.5f;
+            const long   last   = long(_numrho);
+
+            const float *tabSin = _tabSin.data();
+            const float *tabCos = _tabCos.data();
+
+            //
+            // round() then the offset and a truncation, as IMPHoughSpace computes the bin
+            //
+            auto bin = [&](Bin *row, float rho){
+                const long r = long(std::round(rho) + offset);
+                if (r >= 0 && r < last) row[r + 1]++;
+            };
+
+            parallelStrips(_numangle, 4, [&](size_t begin, size_t end){
+
+                float rho[4];
+
+                for (const auto &p: points) {
+
+                    const Vec4f x(p.x), y(p.y);
+
+                    size_t n = begin;
+
+                    for (; n + 4 <= end; n += 4) {
+
+                        (x * Vec4f::load(tabCos + n) + y * Vec4f::load(tabSin + n)).store(rho);
+
+                        Bin *row = accumulator + (n + 1) * stride;
+
+                        bin(row,              rho[0]);
+                        bin(row + stride,     rho[1]);
+                        bin(row + 2 * stride, rho[2]);
+                        bin(row + 3 * stride, rho[3]);
+                    }
+
+                    for (; n < end; n++) bin(accumulator + (n + 1) * stride, p.x * tabCos[n] + p.y * tabSin[n]);
+                }
+            });
+        }
+
+        template<typename Bin> void HoughSpace::vote(const std::vector<OrientedPoint> &points, float spread, Bin *accumulator) const {
+
+            const long   N      = long(_numangle);
+            const long   K      = long(std::round(std::max(spread, 0.0f) / _options.thetaStep));
+            const size_t stride = _numrho + 2;
+            const float  offset = (float(_numrho) - 1.0f) * 0.5f;
+            const long   last   = long(_numrho);
+            const float  pi     = float(M_PI);
+
+            if (N == 0) return;
+
+            //
+            // Angles of a half turn wrap: theta and theta + pi are one line of the opposite rho
+            //
+            const bool circular = float(N) * _options.thetaStep >= pi - 0.5f * _options.thetaStep;
+
+            //
+            // Center angle c of a point is bucket c + K, c in [0, N) of a half turn, [-K, N + K)
+            // otherwise. Points without a direction or whose window covers all the angles go aside.
+            //
+            const size_t buckets = size_t(N + 2 * K);
+
+            std::vector<long>   center(points.size());
+            std::vector<size_t> offsets(buckets + 1, 0);
+            std::vector<size_t> everywhere;
+
+            for (size_t i = 0; i < points.size(); i++) {
+
+                const auto &p = points[i];
+
+                long c = -(K + 1);
+
+                if (p.theta < 0 || 2 * K + 1 >= N) {
+                    everywhere.push_back(i);
+                }
+                else {
+                    float t = std::fmod(p.theta - _options.minTheta, pi);
+                    if (t < 0) t += pi;
+
+                    c = long(std::round(t / _options.thetaStep));
+
+                    if (circular)       c %= N;
+                    else if (c >= N + K) c = long(std::round((t - pi) / _options.thetaStep));
+
+                    if (c >= -K && c < N + K) offsets[size_t(c + K) + 1]++;
+                    else                      c = -(K + 1);
+                }
+
+                center[i] = c;
+            }
+
+            for (size_t b = 0; b < buckets; b++) offsets[b + 1] += offsets[b];
+
+            std::vector<size_t> order(offsets[buckets]);
+            std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+
+            for (size_t i = 0; i < points.size(); i++) {
+                if (center[i] >= -K && center[i] < N + K) order[fill[size_t(center[i] + K)]++] = i;
+            }
+
+            auto bin = [&](size_t n, float x, float y, uint32_t votes){
+                const long r = long(std::round(x * _tabCos[n] + y * _tabSin[n]) + offset);
+                if (r >= 0 && r < last) accumulator[(n + 1) * stride + size_t(r) + 1] += Bin(votes);
+            };
+
+            parallelStrips(_numangle, 4, [&](size_t begin, size_t end){
+
+                //
+                // Centers u in [begin - K, end + K) reach the range, u + d of a window is the angle
+                // itself while it lands in the range
+                //
+                for (long u = long(begin) - K; u < long(end) + K; u++) {
+
+                    const long   c = circular ? (u % N + N) % N : u;
+                    const size_t b = size_t(c + K);
+
+                    if (c < -K || c >= N + K) continue;
+
+                    const size_t first = size_t(std::max(long(begin), u - K));
+                    const size_t stop  = size_t(std::min(long(end),   u + K + 1));
+
+                    for (size_t k = offsets[b]; k < offsets[b + 1]; k++) {
+                        const auto &p = points[order[k]];
+                        for (size_t n = first; n < stop; n++) bin(n, p.x, p.y, p.votes);
+                    }
+                }
+
+                for (size_t i: everywhere) {
+                    const auto &p = points[i];
+                    for (size_t n = begin; n < end; n++) bin(n, p.x, p.y, p.votes);
+                }
+            });
+        }
+
+        void HoughSpace::accumulate(const std::vector<Point> &points, size_t bound) {
+
+            _wide = bound > std::numeric_limits<uint16_t>::max();
+
+            _bins16.clear();
+            _bins32.clear();
+
+            if (_wide) {
+                _bins32.assign(size(), 0);
+                vote(points, _bins32.data());
+            }
+            else {
+                _bins16.assign(size(), 0);
+                vote(points, _bins16.data());
+            }
+        }
+
+        void HoughSpace::accumulate(const std::vector<OrientedPoint> &points, float spread) {
+
+            //
+            // A bin gets a vote of a point at most
+            //
+            uint64_t bound = 0;
+            for (const auto &p: points) bound += p.votes;
+
+            _wide = bound > std::numeric_limits<uint16_t>::max();
+
+            _bins16.clear();
+            _bins32.clear();
+
+            if (_wide) {
+                _bins32.assign(size(), 0);
+                vote(points, spread, _bins32.data());
+            }
+            else {
+                _bins16.assign(size(), 0);
+                vote(points, spread, _bins16.data());
+            }
+        }
+
+        template<typename T> void HoughSpace::compact(const ImageView<const T> &image, std::vector<Point> &points) {
+
+            points.clear();
+
+            const float level = float(PixelTraits<T>::maximum) * 0.5f;
+
+            //
+            // Edge pixels of bands of rows, the bands are concatenated in order
+            //
+            const size_t band  = 64;
+            const size_t bands = (image.height + band - 1) / band;
+
+            std::vector<std::vector<Point>> found(bands);
+
+            parallelFor(bands, [&](size_t b){
+                for (size_t y = b * band; y < std::min((b + 1) * band, image.height); y++) {
+                    const T *p = image.row(y);
+                    for (size_t x = 0; x < image.width; x++, p += image.channels) {
+                        if (float(p[0]) >= level) found[b].push_back(Point{ float(x), float(y) });
+                    }
+                }
+            });
+
+            size_t count = 0;
+            for (const auto &list: found) count += list.size();
+
+            points.reserve(count);
+            for (const auto &list: found) points.insert(points.end(), list.begin(), list.end());
+        }
+
+        template<typename T> bool HoughSpace::image(const ImageView<const T> &image) {
+
+            if (image.empty() || image.width != _width || image.height != _height) return false;
+
+            std::vector<Point> points;
+
+            compact(image, points);
+
+            //
+            // Pixels voting into one bin lie in a strip rhoStep wide across the image
+            //
+            const size_t strip = (2 * size_t(std::ceil(_options.rhoStep)) + 1) * (_width + _height);
+
+            accumulate(points, std::min(points.size(), strip));
+
+            return true;
+        }
+
+        template<typename T>
+        bool HoughSpace::image(const ImageView<const T> &edges, const ImageView<const float> &gradient, const Orientation &orientation) {
+
+            if (edges.empty() || edges.width != _width || edges.height != _height) return false;
+            if (gradient.width != _width || gradient.height != _height || gradient.channels != 2) return false;
+
+            const float level = float(PixelTraits<T>::maximum) * 0.5f;
+            const float pi    = float(M_PI);
+
+            const size_t band  = 64;
+            const size_t bands = (edges.height + band - 1) / band;
+
+            std::vector<std::vector<OrientedPoint>> found(bands);
+
+            parallelFor(bands, [&](size_t b){
+                for (size_t y = b * band; y < std::min((b + 1) * band, edges.height); y++) {
+
+                    const T     *p = edges.row(y);
+                    const float *g = gradient.row(y);
+
+                    for (size_t x = 0; x < edges.width; x++, p += edges.channels, g += 2) {
+
+                        if (float(p[0]) < level) continue;
+
+                        const float length = std::sqrt(g[0] * g[0] + g[1] * g[1]);
+
+                        float theta = -1.0f;
+
+                        if (length > 0) {
+                            theta = std::atan2(g[1], g[0]);
+                            if (theta < 0)   theta += pi;
+                            if (theta >= pi) theta -= pi;
+                        }
+
+                        const uint32_t votes = 1 + uint32_t(std::round(std::max(orientation.weight, 0.0f) * length));
+
+                        found[b].push_back(OrientedPoint{ float(x), float(y), theta, votes });
+                    }
+                }
+            });
+
+            std::vector<OrientedPoint> points;
+
+            size_t count = 0;
+            for (const auto &list: found) count += list.size();
+
+            points.reserve(count);
+            for (const auto &list: found) points.insert(points.end(), list.begin(), list.end());
+
+            accumulate(points, orientation.spread);
+
+            return true;
+        }
+
+        void HoughSpace::edges(const ImageView<const uint8_t> &image, std::vector<Point> &points) {
+            compact(image, points);
+        }
+
+        void HoughSpace::edges(const ImageView<const uint16_t> &image, std::vector<Point> &points) {
+            compact(image, points);
+        }
+
+        void HoughSpace::edges(const ImageView<const float> &image, std::vector<Point> &points) {
+            compact(image, points);
+        }
+
+        bool HoughSpace::transform(const ImageView<const uint8_t> &image) {
+            return this->image(image);
+        }
+
+        bool HoughSpace::transform(const ImageView<const uint16_t> &image) {
+            return this->image(image);
+        }
+
+        bool HoughSpace::transform(const ImageView<const float> &image) {
+            return this->image(image);
+        }
+
+        bool HoughSpace::transform(const std::vector<Point> &points) {
+            accumulate(points, points.size());
+            return true;
+        }
+
+        bool HoughSpace::transform(const ImageView<const uint8_t> &edges, const ImageView<const float> &gradient, const Orientation &orientation) {
+            return this->image(edges, gradient, orientation);
+        }
+
+        bool HoughSpace::transform(const ImageView<const uint16_t> &edges, const ImageView<const float> &gradient, const Orientation &orientation) {
+            return this->image(edges, gradient, orientation);
+        }
+
+        bool HoughSpace::transform(const ImageView<const float> &edges, const ImageView<const float> &gradient, const Orientation &orientation) {
+            return this->image(edges, gradient, orientation);
+        }
+
+        bool HoughSpace::transform(const std::vector<OrientedPoint> &points, float spread) {
+            accumulate(points, spread);
+            return true;
+        }
+
+        void HoughSpace::copy(uint32_t *accumulator) const {
+            if (_wide) std::copy(_bins32.begin(), _bins32.end(), accumulator);
+            else       std::copy(_bins16.begin(), _bins16.end(), accumulator);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static HoughSpace::Options houghOptions(const IMPHoughSpaceOptions &options) {
+    HoughSpace::Options o;
+    o.rhoStep   = options.rhoStep;
+    o.thetaStep = options.thetaStep;
+    o.minTheta  = options.minTheta;
+    o.maxTheta  = options.maxTheta;
+    return o;
+}
+
+static HoughSpace::Orientation houghOrientation(const IMPHoughOrientationOptions &options) {
+    HoughSpace::Orientation o;
+    o.spread = options.spread;
+    o.weight = options.weight;
+    return o;
+}
+
+extern "C" {
+
+    void IMPHoughSpaceDimensions(size_t width, size_t height, IMPHoughSpaceOptions options, size_t *numangle, size_t *numrho) {
+        HoughSpace space(width, height, houghOptions(options));
+        if (numangle) *numangle = space.numangle();
+        if (numrho)   *numrho   = space.numrho();
+    }
+
+    bool IMPHoughSpaceTransform(IMPCpuImage image, IMPHoughSpaceOptions options, uint32_t *accumulator, size_t count) {
+
+        HoughSpace space(image.width, image.height, houghOptions(options));
+
+        if (!accumulator || count < space.size()) return false;
+
+        bool done = false;
+
+        dispatch(image, [&](auto view){
+            done = space.transform(view.readonly());
+        });
+
+        if (done) space.copy(accumulator);
+
+        return done;
+    }
+
+    bool IMPHoughSpaceTransformOriented(IMPCpuImage edges, IMPCpuImage source, IMPHoughSpaceOptions options,
+                                        IMPHoughOrientationOptions orientation, uint32_t *accumulator, size_t count) {
+
+        HoughSpace space(edges.width, edges.height, houghOptions(options));
+
+        if (!accumulator || count < space.size()) return false;
+        if (source.width != edges.width || source.height != edges.height) return false;
+
+        Image<float> gradient;
+        gradient.resize(edges.width, edges.height, 2);
+
+        bool done = false;
+
+        dispatch(source, [&](auto view){
+            done = SobelGradient().components(view.readonly(), gradient.view());
+        });
+
+        if (!done) return false;
+
+        done = false;
+
+        dispatch(edges, [&](auto view){
+            done = space.transform(view.readonly(), gradient.view().readonly(), houghOrientation(orientation));
+        });
+
+        if (done) space.copy(accumulator);
+
+        return done;
+    }
+
+    bool IMPHoughSpaceTransformPoints(const float *points, size_t size, size_t width, size_t height,
+                                      IMPHoughSpaceOptions options, uint32_t *accumulator, size_t count) {
+
+        HoughSpace space(width, height, houghOptions(options));
+
+        if (!accumulator || count < space.size() || (!points && size > 0)) return false;
+
+        std::vector<HoughSpace::Point> list(size);
+
+        for (size_t i = 0; i < size; i++) {
+            list[i].x = points[2 * i]     * float(width);
+            list[i].y = points[2 * i + 1] * float(height);
+        }
+
+        space.transform(list);
+        space.copy(accumulator);
+
+        return true;
+    }
+}
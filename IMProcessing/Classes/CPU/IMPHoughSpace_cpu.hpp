@@ -0,0 +1,159 @@
+//
+//  IMPHoughSpace_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPHoughSpace_cpu_hpp
+#define IMPHoughSpace_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// IMPHoughSpace accumulator: (numangle + 2) * (numrho + 2) bins, angle n and distance r vote
+        /// into (n + 1) * (numrho + 2) + r + 1, tables and rounding are the ones of the Swift class.
+        ///
+        /// Edge pixels are compacted in row order first. Then every task votes all of them into its
+        /// own range of angles, so accumulator rows are never shared: no atomics and no merge. Four
+        /// angles are evaluated at once. Bins are 16 bit while no bin can overflow them, 32 bit
+        /// otherwise.
+        ///
+        /// Oriented voting takes the direction of the Sobel gradient: a pixel votes only the angles
+        /// within a spread of its edge normal. Pixels are bucketed by that angle so a task still owns
+        /// its rows and reads just the buckets its range can reach.
+        ///
+        class HoughSpace {
+
+        public:
+
+            struct Options {
+                /// Distance resolution in pixels
+                float rhoStep   = 1.0f;
+                /// Angle resolution in radians
+                float thetaStep = float(M_PI / 180.0);
+                float minTheta  = 0.0f;
+                float maxTheta  = float(M_PI);
+            };
+
+            /// Edge pixel or point in pixel coordinates
+            struct Point {
+                float x, y;
+            };
+
+            struct Orientation {
+                /// Voted angles around the edge normal, in radians on each side
+                float spread = float(M_PI / 36.0);
+                /// A pixel votes 1 + weight * gradient length rounded, 0 counts pixels
+                float weight = 0.0f;
+            };
+
+            ///
+            /// Point with the angle of its edge normal in [0, pi) and its vote, a negative angle has no
+            /// direction and votes every angle
+            ///
+            struct OrientedPoint {
+                float    x, y, theta;
+                uint32_t votes;
+            };
+
+            HoughSpace(size_t width, size_t height, const Options &options);
+
+            inline const Options &options() const { return _options; }
+
+            inline size_t width()    const { return _width; }
+            inline size_t height()   const { return _height; }
+            inline size_t numangle() const { return _numangle; }
+            inline size_t numrho()   const { return _numrho; }
+
+            /// Number of bins of the accumulator
+            inline size_t size() const { return (_numangle + 2) * (_numrho + 2); }
+
+            /// sin(theta) / rhoStep and cos(theta) / rhoStep of every angle
+            inline const std::vector<float> &tabSin() const { return _tabSin; }
+            inline const std::vector<float> &tabCos() const { return _tabCos; }
+
+            ///
+            /// Vote the pixels whose first channel is at least half of the range, the source has
+            /// the size of the space
+            ///
+            bool transform(const ImageView<const uint8_t>  &image);
+            bool transform(const ImageView<const uint16_t> &image);
+            bool transform(const ImageView<const float>    &image);
+
+            ///
+            /// Vote points in pixel coordinates, points out of the accumulator are skipped
+            ///
+            bool transform(const std::vector<Point> &points);
+
+            ///
+            /// Oriented voting of the pixels whose first channel is at least half of the range, the
+            /// gradient is the 2 channel plane of SobelGradient::components of the edges size
+            ///
+            bool transform(const ImageView<const uint8_t>  &edges, const ImageView<const float> &gradient, const Orientation &orientation);
+            bool transform(const ImageView<const uint16_t> &edges, const ImageView<const float> &gradient, const Orientation &orientation);
+            bool transform(const ImageView<const float>    &edges, const ImageView<const float> &gradient, const Orientation &orientation);
+
+            ///
+            /// Oriented voting of points in pixel coordinates within spread radians of their angles
+            ///
+            bool transform(const std::vector<OrientedPoint> &points, float spread);
+
+            ///
+            /// Pixels whose first channel is at least half of the range, in row order
+            ///
+            static void edges(const ImageView<const uint8_t>  &image, std::vector<Point> &points);
+            static void edges(const ImageView<const uint16_t> &image, std::vector<Point> &points);
+            static void edges(const ImageView<const float>    &image, std::vector<Point> &points);
+
+            /// Bins are 32 bit, otherwise 16 bit
+            inline bool wide() const { return _wide; }
+
+            /// Accumulator of the bin size in use, the other one is null
+            inline const uint16_t *bins16() const { return _wide ? nullptr : _bins16.data(); }
+            inline const uint32_t *bins32() const { return _wide ? _bins32.data() : nullptr; }
+
+            inline uint32_t bins(size_t index) const { return _wide ? _bins32[index] : _bins16[index]; }
+
+            /// Whole accumulator as 32 bit bins
+            void copy(uint32_t *accumulator) const;
+
+        private:
+
+            template<typename T> static void compact(const ImageView<const T> &image, std::vector<Point> &points);
+            template<typename T> bool image(const ImageView<const T> &image);
+            template<typename T> bool image(const ImageView<const T> &edges, const ImageView<const float> &gradient, const Orientation &orientation);
+            template<typename Bin> void vote(const std::vector<Point> &points, Bin *accumulator) const;
+            template<typename Bin> void vote(const std::vector<OrientedPoint> &points, float spread, Bin *accumulator) const;
+
+            void accumulate(const std::vector<Point> &points, size_t bound);
+            void accumulate(const std::vector<OrientedPoint> &points, float spread);
+
+            Options _options;
+            size_t  _width, _height;
+            size_t  _numangle, _numrho;
+
+            std::vector<float> _tabSin;
+            std::vector<float> _tabCos;
+
+            bool _wide = false;
+            std::vector<uint16_t> _bins16;
+            std::vector<uint32_t> _bins32;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPHoughSpace_cpu_hpp */
@@ -0,0 +1,245 @@
+//
+//  IMPImage_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPImage_cpu_hpp
+#define IMPImage_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "IMPCpuImage-Bridging-CPU.h"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Non owning view of an interleaved image plane. `bytesPerRow` is signed so
+        /// a view may walk the rows bottom-up without copying.
+        ///
+        template<typename T> struct ImageView {
+
+            T        *data        = nullptr;
+            size_t    width       = 0;
+            size_t    height      = 0;
+            size_t    channels    = 1;
+            ptrdiff_t bytesPerRow = 0;
+
+            ImageView() {}
+
+            ImageView(T *data, size_t width, size_t height, size_t channels, ptrdiff_t bytesPerRow = 0):
+            data(data), width(width), height(height), channels(channels),
+            bytesPerRow(bytesPerRow != 0 ? bytesPerRow : ptrdiff_t(width * channels * sizeof(T))) {}
+
+            inline T *row(size_t y) const {
+                typedef typename std::conditional<std::is_const<T>::value, const uint8_t, uint8_t>::type Byte;
+                return reinterpret_cast<T*>(reinterpret_cast<Byte*>(data) + ptrdiff_t(y) * bytesPerRow);
+            }
+
+            inline T *pixel(size_t x, size_t y) const {
+                return row(y) + x * channels;
+            }
+
+            inline bool empty() const { return data == nullptr || width == 0 || height == 0; }
+
+            inline size_t rowElements() const { return width * channels; }
+
+            ImageView<const T> readonly() const {
+                return ImageView<const T>(data, width, height, channels, bytesPerRow);
+            }
+
+            ///
+            /// Sub-view of rows [y, y+count).
+            ///
+            ImageView<T> rows(size_t y, size_t count) const {
+                return ImageView<T>(row(y), width, count, channels, bytesPerRow);
+            }
+
+            ///
+            /// The same pixels upside down: starts at the last row with the pitch negated.
+            ///
+            ImageView<T> flipped() const {
+                if (height == 0) return *this;
+                return ImageView<T>(row(height - 1), width, height, channels, -bytesPerRow);
+            }
+        };
+
+        ///
+        /// Minimal 64-byte aligned storage used by engines for intermediate planes.
+        /// Grows only, so reusing one buffer per worker keeps memory flat.
+        ///
+        template<typename T> class AlignedBuffer {
+
+        public:
+
+            static const size_t alignment = 64;
+
+            AlignedBuffer() {}
+
+            explicit AlignedBuffer(size_t count) { resize(count); }
+
+            ~AlignedBuffer() { release(); }
+
+            AlignedBuffer(const AlignedBuffer&) = delete;
+            AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+            AlignedBuffer(AlignedBuffer &&other): _data(other._data), _size(other._size), _capacity(other._capacity) {
+                other._data = nullptr; other._size = other._capacity = 0;
+            }
+
+            AlignedBuffer& operator=(AlignedBuffer &&other) {
+                if (this != &other) {
+                    release();
+                    _data = other._data; _size = other._size; _capacity = other._capacity;
+                    other._data = nullptr; other._size = other._capacity = 0;
+                }
+                return *this;
+            }
+
+            void resize(size_t count) {
+                if (count > _capacity) {
+                    release();
+                    size_t bytes = (count * sizeof(T) + alignment - 1) / alignment * alignment;
+                    void *p = nullptr;
+                    if (posix_memalign(&p, alignment, bytes) != 0) throw std::bad_alloc();
+                    _data = static_cast<T*>(p);
+                    _capacity = count;
+                }
+                _size = count;
+            }
+
+            void zero() { if (_data) memset(_data, 0, _size * sizeof(T)); }
+
+            inline T       *data()       { return _data; }
+            inline const T *data() const { return _data; }
+            inline size_t   size() const { return _size; }
+
+            inline T       &operator[](size_t i)       { return _data[i]; }
+            inline const T &operator[](size_t i) const { return _data[i]; }
+
+        private:
+
+            void release() {
+                free(_data);
+                _data = nullptr; _size = _capacity = 0;
+            }
+
+            T      *_data     = nullptr;
+            size_t  _size     = 0;
+            size_t  _capacity = 0;
+        };
+
+        ///
+        /// Owning interleaved image with 64-byte aligned rows.
+        ///
+        template<typename T> class Image {
+
+        public:
+
+            Image() {}
+
+            Image(size_t width, size_t height, size_t channels) { resize(width, height, channels); }
+
+            void resize(size_t width, size_t height, size_t channels) {
+                size_t rowElements = (width * channels * sizeof(T) + AlignedBuffer<T>::alignment - 1)
+                / AlignedBuffer<T>::alignment * AlignedBuffer<T>::alignment / sizeof(T);
+                _buffer.resize(rowElements * height);
+                _view = ImageView<T>(_buffer.data(), width, height, channels, ptrdiff_t(rowElements * sizeof(T)));
+            }
+
+            inline const ImageView<T> &view() const { return _view; }
+
+            inline size_t width()    const { return _view.width; }
+            inline size_t height()   const { return _view.height; }
+            inline size_t channels() const { return _view.channels; }
+
+            inline T *row(size_t y) const { return _view.row(y); }
+
+        private:
+            AlignedBuffer<T> _buffer;
+            ImageView<T>     _view;
+        };
+
+        ///
+        /// Storage type conversions. Integral samples are processed in their own scale
+        /// as floats and rounded with saturation when stored back.
+        ///
+        template<typename T> struct PixelTraits;
+
+        template<> struct PixelTraits<uint8_t> {
+            static constexpr float maximum = 255.0f;
+            static inline float   toFloat(uint8_t v) { return float(v); }
+            static inline uint8_t fromFloat(float v) {
+                return v <= 0.0f ? 0 : v >= maximum ? 255 : uint8_t(v + 0.5f);
+            }
+        };
+
+        template<> struct PixelTraits<uint16_t> {
+            static constexpr float maximum = 65535.0f;
+            static inline float    toFloat(uint16_t v) { return float(v); }
+            static inline uint16_t fromFloat(float v) {
+                return v <= 0.0f ? 0 : v >= maximum ? 65535 : uint16_t(v + 0.5f);
+            }
+        };
+
+        template<> struct PixelTraits<float> {
+            static constexpr float maximum = 1.0f;
+            static inline float toFloat(float v)   { return v; }
+            static inline float fromFloat(float v) { return v; }
+        };
+
+        template<typename T, typename S> inline void loadRow(const T *src, S *dst, size_t count) {
+            for (size_t i = 0; i < count; i++) dst[i] = S(PixelTraits<T>::toFloat(src[i]));
+        }
+
+        template<typename S, typename T> inline void storeRow(const S *src, T *dst, size_t count) {
+            for (size_t i = 0; i < count; i++) dst[i] = PixelTraits<T>::fromFloat(float(src[i]));
+        }
+
+        ///
+        /// Call fn(ImageView<T>) with the storage type of a bridged IMPCpuImage.
+        /// Returns false for unknown formats or empty images.
+        ///
+        template<typename F> bool dispatch(const IMPCpuImage &image, F &&fn) {
+
+            if (!image.data || image.width == 0 || image.height == 0) return false;
+
+            switch (image.format) {
+                case IMPCpuPixelFormatR8:
+                    fn(ImageView<uint8_t>(static_cast<uint8_t*>(image.data), image.width, image.height, 1, image.bytesPerRow));
+                    return true;
+                case IMPCpuPixelFormatRGBA8:
+                    fn(ImageView<uint8_t>(static_cast<uint8_t*>(image.data), image.width, image.height, 4, image.bytesPerRow));
+                    return true;
+                case IMPCpuPixelFormatR16:
+                    fn(ImageView<uint16_t>(static_cast<uint16_t*>(image.data), image.width, image.height, 1, image.bytesPerRow));
+                    return true;
+                case IMPCpuPixelFormatRGBA16:
+                    fn(ImageView<uint16_t>(static_cast<uint16_t*>(image.data), image.width, image.height, 4, image.bytesPerRow));
+                    return true;
+                case IMPCpuPixelFormatR32F:
+                    fn(ImageView<float>(static_cast<float*>(image.data), image.width, image.height, 1, image.bytesPerRow));
+                    return true;
+                case IMPCpuPixelFormatRGBA32F:
+                    fn(ImageView<float>(static_cast<float*>(image.data), image.width, image.height, 4, image.bytesPerRow));
+                    return true;
+            }
+            return false;
+        }
+    }
+}
+
+#endif
+
+#endif /* IMPImage_cpu_hpp */
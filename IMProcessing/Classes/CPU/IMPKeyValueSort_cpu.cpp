@@ -0,0 +1,396 @@
+//
+//  IMPKeyValueSort_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPKeyValueSort_cpu.hpp"
+#include "IMPKeyValueSort-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        constexpr size_t KeyValueSort::blockSize;
+        constexpr size_t KeyValueSort::radixSize;
+        constexpr size_t KeyValueSort::chunkSize;
+
+        namespace {
+
+            const size_t blockSize = KeyValueSort::blockSize;
+
+            //
+            // Output words a merge part writes at least
+            //
+            const size_t mergeGrain = 1 << 14;
+
+            inline uint32_t keyOf(uint64_t word) { return uint32_t(word >> 32); }
+
+            //
+            // Bitonic network of a block: stage k builds sorted runs of k words, alternately
+            // ascending and descending, pass j compares the words j apart
+            //
+            void network(uint64_t *a) {
+                for (size_t k = 2; k <= blockSize; k <<= 1) {
+                    for (size_t j = k >> 1; j > 0; j >>= 1) {
+                        for (size_t i = 0; i < blockSize; i++) {
+                            const size_t l = i ^ j;
+                            if (l < i) continue;
+                            const bool ascending = (i & k) == 0;
+                            if ((a[i] > a[l]) == ascending) std::swap(a[i], a[l]);
+                        }
+                    }
+                }
+            }
+
+#if IMP_CPU_AVX2_DISPATCH
+            //
+            // Unsigned a < b of 64-bit lanes, AVX2 compares signed ones only
+            //
+            IMP_CPU_TARGET_AVX2 inline __m256i less(__m256i a, __m256i b) {
+                const __m256i bias = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+                return _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+            }
+
+            //
+            // Lane-wise minimum to lo, maximum to hi
+            //
+            IMP_CPU_TARGET_AVX2 inline void exchange(__m256i &lo, __m256i &hi) {
+                const __m256i swap = less(hi, lo);
+                const __m256i l = _mm256_blendv_epi8(lo, hi, swap);
+                hi = _mm256_blendv_epi8(hi, lo, swap);
+                lo = l;
+            }
+
+            //
+            // Words 1 (0xB1) or 2 (0x4E) apart in a register, lanes of upper set take the maximum
+            //
+            template<int shuffle> IMP_CPU_TARGET_AVX2 inline __m256i exchange(__m256i v, __m256i upper) {
+                const __m256i p  = _mm256_permute4x64_epi64(v, shuffle);
+                const __m256i lt = less(v, p);
+                const __m256i lo = _mm256_blendv_epi8(p, v, lt);
+                const __m256i hi = _mm256_blendv_epi8(v, p, lt);
+                return _mm256_blendv_epi8(lo, hi, upper);
+            }
+
+            //
+            // The network of a block in four registers, word i is lane i % 4 of register i / 4:
+            // passes of 4 and 8 exchange whole registers, passes of 1 and 2 permute lanes. The
+            // masks select the lanes taking the maximum, descending runs invert them
+            //
+            IMP_CPU_TARGET_AVX2 void networkAVX2(uint64_t *a) {
+
+                __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+                __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 4));
+                __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 8));
+                __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 12));
+
+                const __m256i up1 = _mm256_setr_epi64x(0, -1, 0, -1), down1 = _mm256_setr_epi64x(-1, 0, -1, 0);
+                const __m256i up2 = _mm256_setr_epi64x(0, 0, -1, -1), down2 = _mm256_setr_epi64x(-1, -1, 0, 0);
+                const __m256i pairs = _mm256_setr_epi64x(0, -1, -1, 0);
+
+                //
+                // Runs of 2
+                //
+                v0 = exchange<0xB1>(v0, pairs); v1 = exchange<0xB1>(v1, pairs);
+                v2 = exchange<0xB1>(v2, pairs); v3 = exchange<0xB1>(v3, pairs);
+
+                //
+                // Runs of 4, odd registers descending
+                //
+                v0 = exchange<0x4E>(v0, up2); v1 = exchange<0x4E>(v1, down2);
+                v2 = exchange<0x4E>(v2, up2); v3 = exchange<0x4E>(v3, down2);
+                v0 = exchange<0xB1>(v0, up1); v1 = exchange<0xB1>(v1, down1);
+                v2 = exchange<0xB1>(v2, up1); v3 = exchange<0xB1>(v3, down1);
+
+                //
+                // Runs of 8, the second half descending
+                //
+                exchange(v0, v1); exchange(v3, v2);
+                v0 = exchange<0x4E>(v0, up2);   v1 = exchange<0x4E>(v1, up2);
+                v2 = exchange<0x4E>(v2, down2); v3 = exchange<0x4E>(v3, down2);
+                v0 = exchange<0xB1>(v0, up1);   v1 = exchange<0xB1>(v1, up1);
+                v2 = exchange<0xB1>(v2, down1); v3 = exchange<0xB1>(v3, down1);
+
+                //
+                // The block
+                //
+                exchange(v0, v2); exchange(v1, v3);
+                exchange(v0, v1); exchange(v2, v3);
+                v0 = exchange<0x4E>(v0, up2); v1 = exchange<0x4E>(v1, up2);
+                v2 = exchange<0x4E>(v2, up2); v3 = exchange<0x4E>(v3, up2);
+                v0 = exchange<0xB1>(v0, up1); v1 = exchange<0xB1>(v1, up1);
+                v2 = exchange<0xB1>(v2, up1); v3 = exchange<0xB1>(v3, up1);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a),      v0);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + 4),  v1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + 8),  v2);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + 12), v3);
+            }
+#endif
+
+            //
+            // Any block: the tail is padded by the greatest word, which sorts after it
+            //
+            void sortBlock(uint64_t *words, size_t count) {
+
+                uint64_t padded[blockSize];
+                uint64_t *a = words;
+
+                if (count < blockSize) {
+                    std::copy(words, words + count, padded);
+                    std::fill(padded + count, padded + blockSize, std::numeric_limits<uint64_t>::max());
+                    a = padded;
+                }
+
+#if IMP_CPU_AVX2_DISPATCH
+                if (hasAVX2()) networkAVX2(a);
+                else           network(a);
+#else
+                network(a);
+#endif
+
+                if (a != words) std::copy(padded, padded + count, words);
+            }
+
+            //
+            // Stable block by insertion
+            //
+            void insertBlock(uint64_t *words, size_t count) {
+                for (size_t i = 1; i < count; i++) {
+                    const uint64_t w = words[i];
+                    size_t j = i;
+                    for (; j > 0 && keyOf(words[j - 1]) > keyOf(w); j--) words[j] = words[j - 1];
+                    words[j] = w;
+                }
+            }
+
+            //
+            // Stable merge by key: a word of a goes first on equal keys
+            //
+            void merge(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *out) {
+
+                size_t i = 0, j = 0;
+
+                while (i < na && j < nb) {
+                    const uint64_t x = a[i], y = b[j];
+                    const bool right = keyOf(y) < keyOf(x);
+                    *out++ = right ? y : x;
+                    j += right;
+                    i += !right;
+                }
+
+                out = std::copy(a + i, a + na, out);
+                std::copy(b + j, b + nb, out);
+            }
+
+            //
+            // Words of a among the first d of the merge of a and b
+            //
+            size_t split(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, size_t d) {
+
+                size_t lo = d > nb ? d - nb : 0;
+                size_t hi = std::min(d, na);
+
+                while (lo < hi) {
+                    const size_t i = (lo + hi) / 2;
+                    if (keyOf(b[d - i - 1]) < keyOf(a[i])) hi = i;
+                    else lo = i + 1;
+                }
+
+                return lo;
+            }
+
+            void parallelMerge(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *out) {
+
+                const size_t total = na + nb;
+                const size_t parts = std::max<size_t>(std::min(concurrency() * 4, total / mergeGrain), 1);
+
+                if (parts == 1) {
+                    merge(a, na, b, nb, out);
+                    return;
+                }
+
+                parallelFor(parts, [&](size_t p){
+
+                    const size_t d0 = total * p / parts;
+                    const size_t d1 = total * (p + 1) / parts;
+                    const size_t i0 = split(a, na, b, nb, d0);
+                    const size_t i1 = split(a, na, b, nb, d1);
+
+                    merge(a + i0, i1 - i0, b + (d0 - i0), (d1 - i1) - (d0 - i0), out + d0);
+                });
+            }
+
+            //
+            // LSD radix sort of the key bytes, stable, the words end up back in words
+            //
+            void radix(uint64_t *words, uint64_t *buffer, size_t count) {
+
+                size_t counts[4][256] = {};
+
+                for (size_t i = 0; i < count; i++) {
+                    const uint32_t k = keyOf(words[i]);
+                    counts[0][k & 0xff]++;
+                    counts[1][(k >> 8) & 0xff]++;
+                    counts[2][(k >> 16) & 0xff]++;
+                    counts[3][k >> 24]++;
+                }
+
+                uint64_t *src = words, *dst = buffer;
+
+                for (int pass = 0; pass < 4; pass++) {
+
+                    const int shift = 32 + 8 * pass;
+
+                    //
+                    // A byte equal in all the keys keeps the order
+                    //
+                    if (counts[pass][(src[0] >> shift) & 0xff] == count) continue;
+
+                    size_t offsets[256];
+                    size_t sum = 0;
+                    for (size_t d = 0; d < 256; d++) { offsets[d] = sum; sum += counts[pass][d]; }
+
+                    for (size_t i = 0; i < count; i++) {
+                        const uint64_t w = src[i];
+                        dst[offsets[(w >> shift) & 0xff]++] = w;
+                    }
+
+                    std::swap(src, dst);
+                }
+
+                if (src != words) std::copy(src, src + count, words);
+            }
+
+            //
+            // Blocks, then merges of doubling runs between words and buffer
+            //
+            void blocks(uint64_t *words, uint64_t *buffer, size_t count, bool stable) {
+
+                for (size_t b = 0; b < count; b += blockSize) {
+                    const size_t n = std::min(blockSize, count - b);
+                    if (stable) insertBlock(words + b, n);
+                    else        sortBlock(words + b, n);
+                }
+
+                uint64_t *src = words, *dst = buffer;
+
+                for (size_t width = blockSize; width < count; width *= 2) {
+
+                    for (size_t b = 0; b < count; b += 2 * width) {
+                        const size_t m = std::min(b + width, count);
+                        const size_t e = std::min(b + 2 * width, count);
+                        merge(src + b, m - b, src + m, e - m, dst + b);
+                    }
+
+                    std::swap(src, dst);
+                }
+
+                if (src != words) std::copy(src, src + count, words);
+            }
+
+            void chunk(uint64_t *words, uint64_t *buffer, size_t count, bool stable) {
+                if (count < KeyValueSort::radixSize) blocks(words, buffer, count, stable);
+                else radix(words, buffer, count);
+            }
+        }
+
+        void KeyValueSort::sort(uint64_t *words, size_t count) const {
+
+            if (!words || count < 2) return;
+
+            std::vector<uint64_t> buffer(count);
+
+            const size_t chunks = count < 2 * chunkSize ? 1 : std::max<size_t>(std::min(concurrency(), count / chunkSize), 1);
+
+            if (chunks == 1) {
+                chunk(words, buffer.data(), count, _options.stable);
+                return;
+            }
+
+            std::vector<size_t> bounds(chunks + 1);
+            for (size_t c = 0; c <= chunks; c++) bounds[c] = count * c / chunks;
+
+            parallelFor(chunks, [&](size_t c){
+                chunk(words + bounds[c], buffer.data() + bounds[c], bounds[c + 1] - bounds[c], _options.stable);
+            });
+
+            //
+            // Neighbour runs merged pairwise, the left one first on equal keys
+            //
+            uint64_t *src = words, *dst = buffer.data();
+
+            while (bounds.size() > 2) {
+
+                std::vector<size_t> next;
+
+                for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+
+                    next.push_back(bounds[r]);
+
+                    if (r + 2 < bounds.size()) {
+                        const size_t b = bounds[r], m = bounds[r + 1], e = bounds[r + 2];
+                        parallelMerge(src + b, m - b, src + m, e - m, dst + b);
+                    }
+                    else {
+                        std::copy(src + bounds[r], src + bounds[r + 1], dst + bounds[r]);
+                    }
+                }
+
+                next.push_back(count);
+                bounds.swap(next);
+
+                std::swap(src, dst);
+            }
+
+            if (src != words) std::copy(src, src + count, words);
+        }
+
+        void KeyValueSort::sort(Pair *pairs, size_t count) const {
+
+            if (!pairs || count < 2) return;
+
+            //
+            // Descending order sorts the complements of the keys
+            //
+            const uint32_t flip = _options.descending ? 0xffffffffu : 0u;
+
+            std::vector<uint64_t> words(count);
+
+            for (size_t i = 0; i < count; i++) words[i] = uint64_t(pairs[i].key ^ flip) << 32 | pairs[i].value;
+
+            sort(words.data(), count);
+
+            for (size_t i = 0; i < count; i++) {
+                pairs[i].value = uint32_t(words[i]);
+                pairs[i].key   = keyOf(words[i]) ^ flip;
+            }
+        }
+
+        void KeyValueSort::sort(std::vector<Pair> &pairs) const {
+            sort(pairs.data(), pairs.size());
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    void IMPKeyValueSortUInt2(uint32_t *pairs, size_t count, IMPKeyValueSortOptions options) {
+
+        KeyValueSort::Options o;
+        o.descending = options.descending;
+        o.stable     = options.stable;
+
+        KeyValueSort(o).sort(reinterpret_cast<KeyValueSort::Pair*>(pairs), count);
+    }
+}
@@ -0,0 +1,85 @@
+//
+//  IMPKeyValueSort_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPKeyValueSort_cpu_hpp
+#define IMPKeyValueSort_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Sorts uint2 (value, key) pairs by the 32-bit key, the (index, bins) lists of Hough maxima,
+        /// corner responses or histogram peaks. Keys compare as integers at any length, the CPU
+        /// counterpart of kernel_bitonicSortUInt2.
+        ///
+        /// A pair is one 64-bit word with the key in the high half. Blocks of blockSize words are
+        /// sorted by a bitonic network, 4 words a register on AVX2, and merged; arrays of radixSize
+        /// and more take an LSD radix sort of the key bytes, skipping the bytes equal in all keys.
+        /// Large arrays are split into chunks sorted in parallel and merged pairwise, each merge
+        /// split into parts along its merge path.
+        ///
+        /// The stable mode keeps equal keys in their input order and never takes the network,
+        /// otherwise equal keys come in any order.
+        ///
+        class KeyValueSort {
+
+        public:
+
+            ///
+            /// Layout of uint2: x is the value, y the key
+            ///
+            struct Pair {
+                uint32_t value;
+                uint32_t key;
+            };
+
+            struct Options {
+                /// The greatest key first
+                bool descending = false;
+                /// Equal keys keep their order
+                bool stable     = false;
+            };
+
+            /// Words of a network block
+            static constexpr size_t blockSize = 16;
+            /// Shorter chunks are sorted by blocks and merges
+            static constexpr size_t radixSize = 64;
+            /// Smallest chunk sorted by one thread: arrays shorter than 2 * chunkSize are not split between threads
+            static constexpr size_t chunkSize = 1 << 16;
+
+            explicit KeyValueSort(const Options &options): _options(options) {}
+
+            KeyValueSort(): KeyValueSort(Options()) {}
+
+            inline const Options &options() const { return _options; }
+
+            void sort(Pair *pairs, size_t count) const;
+            void sort(std::vector<Pair> &pairs) const;
+
+            ///
+            /// Words key << 32 | value sorted ascending in place, the engine of sort()
+            ///
+            void sort(uint64_t *words, size_t count) const;
+
+        private:
+
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPKeyValueSort_cpu_hpp */
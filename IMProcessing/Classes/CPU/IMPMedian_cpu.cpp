@@ -0,0 +1,540 @@
+//
+//  IMPMedian_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPMedian_cpu.hpp"
+#include "IMPMedian-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        constexpr size_t ConstantTimeMedian::minimumBits;
+        constexpr size_t ConstantTimeMedian::maximumBits;
+
+        ConstantTimeMedian::ConstantTimeMedian(size_t radius, Mode mode, size_t bits):
+        _radius(radius), _mode(mode), _bits(std::min(std::max(bits, minimumBits), maximumBits)) {}
+
+        bool ConstantTimeMedian::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination, 8);
+        }
+
+        bool ConstantTimeMedian::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination, _bits);
+        }
+
+        bool ConstantTimeMedian::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination, _bits);
+        }
+
+        namespace {
+
+            //
+            // Maps samples of the native scale to histogram levels and back
+            //
+            template<typename T> struct Quantizer {
+
+                Quantizer(size_t levels):
+                _top(uint16_t(levels - 1)),
+                _toLevel(float(levels - 1) / PixelTraits<T>::maximum),
+                _fromLevel(PixelTraits<T>::maximum / float(levels - 1)) {}
+
+                inline uint16_t level(float v) const {
+                    v *= _toLevel;
+                    return v <= 0.0f ? 0 : v >= float(_top) ? _top : uint16_t(v + 0.5f);
+                }
+
+                inline T value(size_t level) const { return PixelTraits<T>::fromFloat(float(level) * _fromLevel); }
+
+            private:
+                uint16_t _top;
+                float    _toLevel;
+                float    _fromLevel;
+            };
+
+            //
+            // Median of the columns [begin, end) of the image. Column histograms cover the strip and
+            // radius clamped columns on both sides.
+            //
+            template<typename T> class MedianStrip {
+
+                //
+                // Colour sums of the luma mode are exact for the integral formats
+                //
+                typedef typename std::conditional<std::is_integral<T>::value, uint32_t, float>::type  ColumnSum;
+                typedef typename std::conditional<std::is_integral<T>::value, uint64_t, double>::type KernelSum;
+
+                struct Histogram {
+                    AlignedBuffer<uint16_t>  columnCoarse;
+                    AlignedBuffer<uint16_t>  columnFine;
+                    AlignedBuffer<ColumnSum> columnSums;
+                    AlignedBuffer<uint32_t>  coarse;
+                    AlignedBuffer<uint32_t>  fine;
+                    AlignedBuffer<KernelSum> sums;
+                    std::vector<long>        stamp;
+                };
+
+            public:
+
+                MedianStrip(const ImageView<const T> &source, const ImageView<T> &destination,
+                            size_t radius, bool luma, size_t bits, size_t begin, size_t end):
+                _source(source), _destination(destination), _radius(radius), _luma(luma),
+                _fineBits(bits / 2),
+                _coarse(size_t(1) << (bits - bits / 2)),
+                _fine(size_t(1) << (bits / 2)),
+                _levels(size_t(1) << bits),
+                _quantizer(size_t(1) << bits),
+                _begin(begin), _end(end),
+                _columns(end - begin + 2 * radius),
+                _sumChannels(luma ? (source.channels == 4 ? 3 : source.channels) : 0),
+                _histograms(luma ? 1 : source.channels)
+                {
+                    for (auto &h: _histograms) {
+                        h.columnCoarse.resize(_columns * _coarse); h.columnCoarse.zero();
+                        h.columnFine.resize(_columns * _levels);   h.columnFine.zero();
+                        h.coarse.resize(_coarse);
+                        h.fine.resize(_levels);
+                        h.stamp.resize(_coarse);
+                        if (_sumChannels > 0) {
+                            h.columnSums.resize(_columns * _levels * _sumChannels); h.columnSums.zero();
+                            h.sums.resize(_levels * _sumChannels);
+                        }
+                    }
+                }
+
+                void run() {
+
+                    const long height = long(_source.height);
+                    const long radius = long(_radius);
+
+                    for (long y = 0; y < height; y++) {
+
+                        if (y == 0) {
+                            for (size_t c = 0; c < _columns; c++)
+                                for (long j = -radius; j <= radius; j++) update(c, j, 1);
+                        }
+                        else {
+                            long out = y - radius - 1, in = y + radius;
+                            if (clampRow(out) != clampRow(in)) {
+                                for (size_t c = 0; c < _columns; c++) {
+                                    update(c, out, -1);
+                                    update(c, in,   1);
+                                }
+                            }
+                        }
+
+                        for (size_t k = 0; k < _histograms.size(); k++) sweep(k, size_t(y));
+                    }
+                }
+
+            private:
+
+                inline size_t clampRow(long y) const {
+                    return size_t(std::min(std::max(y, 0L), long(_source.height) - 1));
+                }
+
+                inline const T *sample(size_t column, long y) const {
+                    long x = long(_begin) + long(column) - long(_radius);
+                    x = std::min(std::max(x, 0L), long(_source.width) - 1);
+                    return _source.pixel(size_t(x), clampRow(y));
+                }
+
+                inline uint16_t level(const T *p, size_t k) const {
+                    if (!_luma || _source.channels < 3)
+                        return _quantizer.level(PixelTraits<T>::toFloat(p[k]));
+                    return _quantizer.level(0.299f * PixelTraits<T>::toFloat(p[0]) +
+                                            0.587f * PixelTraits<T>::toFloat(p[1]) +
+                                            0.114f * PixelTraits<T>::toFloat(p[2]));
+                }
+
+                //
+                // Add (delta = 1) or remove (delta = -1) the sample of row y to the column histograms
+                //
+                inline void update(size_t column, long y, int delta) {
+
+                    const T *p = sample(column, y);
+
+                    for (size_t k = 0; k < _histograms.size(); k++) {
+
+                        Histogram &h = _histograms[k];
+                        size_t     l = level(p, k);
+
+                        h.columnCoarse[column * _coarse + (l >> _fineBits)] += uint16_t(delta);
+                        h.columnFine[column * _levels + l]                 += uint16_t(delta);
+
+                        ColumnSum *sums = h.columnSums.data() + (column * _levels + l) * _sumChannels;
+                        for (size_t i = 0; i < _sumChannels; i++) {
+                            ColumnSum v = ColumnSum(p[i]);
+                            if (delta > 0) sums[i] += v; else sums[i] -= v;
+                        }
+                    }
+                }
+
+                //
+                // Add or subtract the fine bins of one coarse bin of a column to the window
+                //
+                inline void accumulate(Histogram &h, size_t bin, size_t column, bool add) {
+
+                    const uint16_t *counts = h.columnFine.data() + column * _levels + bin * _fine;
+                    uint32_t       *fine   = h.fine.data() + bin * _fine;
+
+                    if (add) for (size_t i = 0; i < _fine; i++) fine[i] += counts[i];
+                    else     for (size_t i = 0; i < _fine; i++) fine[i] -= counts[i];
+
+                    if (_sumChannels == 0) return;
+
+                    size_t           count  = _fine * _sumChannels;
+                    const ColumnSum *values = h.columnSums.data() + (column * _levels + bin * _fine) * _sumChannels;
+                    KernelSum       *sums   = h.sums.data() + bin * _fine * _sumChannels;
+
+                    if (add) for (size_t i = 0; i < count; i++) sums[i] += KernelSum(values[i]);
+                    else     for (size_t i = 0; i < count; i++) sums[i] -= KernelSum(values[i]);
+                }
+
+                //
+                // Bring the fine bins of a coarse bin to the window which starts at column x.
+                // The bins are either moved from the window they were last used with or built anew
+                // if the windows don't overlap.
+                //
+                inline void refresh(Histogram &h, size_t bin, size_t x) {
+
+                    long   last = h.stamp[bin];
+                    size_t size = 2 * _radius + 1;
+
+                    if (last < 0 || x - size_t(last) >= size) {
+                        std::fill(h.fine.data() + bin * _fine, h.fine.data() + (bin + 1) * _fine, 0);
+                        if (_sumChannels > 0)
+                            std::fill(h.sums.data() + bin * _fine * _sumChannels,
+                                      h.sums.data() + (bin + 1) * _fine * _sumChannels, KernelSum(0));
+                        for (size_t c = x; c < x + size; c++) accumulate(h, bin, c, true);
+                    }
+                    else {
+                        for (size_t c = size_t(last); c < x; c++) {
+                            accumulate(h, bin, c + size, true);
+                            accumulate(h, bin, c, false);
+                        }
+                    }
+
+                    h.stamp[bin] = long(x);
+                }
+
+                void sweep(size_t k, size_t y) {
+
+                    Histogram &h    = _histograms[k];
+                    size_t     size = 2 * _radius + 1;
+                    uint32_t   rank = uint32_t(size * size / 2);
+
+                    std::fill(h.coarse.data(), h.coarse.data() + _coarse, 0);
+                    for (size_t c = 0; c < size; c++) {
+                        const uint16_t *counts = h.columnCoarse.data() + c * _coarse;
+                        for (size_t i = 0; i < _coarse; i++) h.coarse[i] += counts[i];
+                    }
+
+                    //
+                    // Column histograms have moved down a row, all the fine bins are stale
+                    //
+                    std::fill(h.stamp.begin(), h.stamp.end(), -1L);
+
+                    T *out = _destination.row(y) + _begin * _destination.channels;
+
+                    for (size_t x = 0; x < _end - _begin; x++, out += _destination.channels) {
+
+                        if (x > 0) {
+                            const uint16_t *in  = h.columnCoarse.data() + (x + size - 1) * _coarse;
+                            const uint16_t *old = h.columnCoarse.data() + (x - 1) * _coarse;
+                            for (size_t i = 0; i < _coarse; i++) h.coarse[i] += uint32_t(in[i]) - uint32_t(old[i]);
+                        }
+
+                        uint32_t accumulated = 0;
+                        size_t   bin = 0;
+
+                        while (accumulated + h.coarse[bin] <= rank) accumulated += h.coarse[bin++];
+
+                        refresh(h, bin, x);
+
+                        size_t l = bin * _fine;
+                        while (accumulated + h.fine[l] <= rank) accumulated += h.fine[l++];
+
+                        if (_sumChannels == 0) {
+                            out[k] = _quantizer.value(l);
+                            continue;
+                        }
+
+                        const KernelSum *sums  = h.sums.data() + l * _sumChannels;
+                        double           count = double(h.fine[l]);
+
+                        for (size_t i = 0; i < _sumChannels; i++)
+                            out[i] = PixelTraits<T>::fromFloat(float(double(sums[i]) / count));
+
+                        for (size_t i = _sumChannels; i < _destination.channels; i++)
+                            out[i] = _source.pixel(_begin + x, y)[i];
+                    }
+                }
+
+                const ImageView<const T> &_source;
+                const ImageView<T>       &_destination;
+
+                size_t _radius;
+                bool   _luma;
+                size_t _fineBits;
+                size_t _coarse;
+                size_t _fine;
+                size_t _levels;
+
+                Quantizer<T> _quantizer;
+
+                size_t _begin;
+                size_t _end;
+                size_t _columns;
+                size_t _sumChannels;
+
+                std::vector<Histogram> _histograms;
+            };
+        }
+
+        template<typename T> bool ConstantTimeMedian::run(const ImageView<const T> &source, const ImageView<T> &destination, size_t bits) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+
+            //
+            // Column histograms count 2*radius+1 samples in 16 bits
+            //
+            if (_radius > 32766) return false;
+
+            //
+            // Strips read the columns of their neighbours and rows behind the output, so in place
+            // filtering needs a copy of the source
+            //
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == destination.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            if (_radius == 0) {
+                for (size_t y = 0; y < input.height; y++)
+                    std::copy(input.row(y), input.row(y) + input.rowElements(), destination.row(y));
+                return true;
+            }
+
+            //
+            // Every strip builds histograms of 2*radius extra columns, wide strips keep the overhead low
+            //
+            size_t grain = std::max<size_t>(64, 4 * _radius);
+
+            parallelStrips(input.width, grain, [&](size_t begin, size_t end){
+                MedianStrip<T>(input, destination, _radius, _mode == luma, bits, begin, end).run();
+            });
+
+            return true;
+        }
+
+        namespace {
+
+            //
+            // The exchanges of kernel_median3x3 over scalars or lanes
+            //
+            template<typename V> inline void s2(V &a, V &b) { V t = min(a, b); b = max(a, b); a = t; }
+
+            template<typename V> inline void mnmx3(V &a, V &b, V &c) { s2(b, c); s2(a, c); s2(a, b); }
+
+            template<typename V> inline V med3(V a, V b, V c) { return max(min(a, b), min(max(a, b), c)); }
+
+            template<typename V> inline V median9(const V lo[3], const V mid[3], const V hi[3]) {
+                return med3(max(max(lo[0], lo[1]), lo[2]), med3(mid[0], mid[1], mid[2]), min(min(hi[0], hi[1]), hi[2]));
+            }
+
+            template<typename T> void medianRow(const T *const rows[3], T *out, size_t width, size_t channels, T *scratch) {
+
+                typedef typename RankLanes<T>::type V;
+                const size_t lanes = RankLanes<T>::count;
+
+                const size_t n = width * channels;
+
+                T *lo  = scratch;
+                T *mid = scratch + n;
+                T *hi  = scratch + 2 * n;
+
+                //
+                // Sorted columns
+                //
+                size_t e = 0;
+
+                for (; e + lanes <= n; e += lanes) {
+                    V a = V::load(rows[0] + e), b = V::load(rows[1] + e), c = V::load(rows[2] + e);
+                    mnmx3(a, b, c);
+                    a.store(lo + e); b.store(mid + e); c.store(hi + e);
+                }
+
+                for (; e < n; e++) {
+                    T a = rows[0][e], b = rows[1][e], c = rows[2][e];
+                    mnmx3(a, b, c);
+                    lo[e] = a; mid[e] = b; hi[e] = c;
+                }
+
+                //
+                // Inner pixels take the columns on the left and right of their own
+                //
+                if (width > 2) {
+
+                    e = channels;
+
+                    for (; e + lanes <= n - channels; e += lanes) {
+                        V l[3] = { V::load(lo  + e - channels), V::load(lo  + e), V::load(lo  + e + channels) };
+                        V m[3] = { V::load(mid + e - channels), V::load(mid + e), V::load(mid + e + channels) };
+                        V h[3] = { V::load(hi  + e - channels), V::load(hi  + e), V::load(hi  + e + channels) };
+                        median9(l, m, h).store(out + e);
+                    }
+
+                    for (; e < n - channels; e++) {
+                        T l[3] = { lo[e - channels],  lo[e],  lo[e + channels]  };
+                        T m[3] = { mid[e - channels], mid[e], mid[e + channels] };
+                        T h[3] = { hi[e - channels],  hi[e],  hi[e + channels]  };
+                        out[e] = median9(l, m, h);
+                    }
+                }
+
+                //
+                // Edge pixels repeat their own column
+                //
+                const size_t edges[2] = { 0, width - 1 };
+
+                for (size_t i = 0; i < (width > 1 ? 2 : 1); i++) {
+
+                    size_t x = edges[i];
+                    size_t a = (x > 0 ? x - 1 : 0) * channels;
+                    size_t b = x * channels;
+                    size_t c = (x + 1 < width ? x + 1 : x) * channels;
+
+                    for (size_t k = 0; k < channels; k++) {
+                        T l[3] = { lo[a + k],  lo[b + k],  lo[c + k]  };
+                        T m[3] = { mid[a + k], mid[b + k], mid[c + k] };
+                        T h[3] = { hi[a + k],  hi[b + k],  hi[c + k]  };
+                        out[b + k] = median9(l, m, h);
+                    }
+                }
+            }
+        }
+
+        void median3x3Row(const uint8_t *const rows[3], uint8_t *out, size_t width, size_t channels, uint8_t *scratch) {
+            medianRow(rows, out, width, channels, scratch);
+        }
+
+        void median3x3Row(const uint16_t *const rows[3], uint16_t *out, size_t width, size_t channels, uint16_t *scratch) {
+            medianRow(rows, out, width, channels, scratch);
+        }
+
+        void median3x3Row(const float *const rows[3], float *out, size_t width, size_t channels, float *scratch) {
+            medianRow(rows, out, width, channels, scratch);
+        }
+
+        bool Median3x3::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool Median3x3::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool Median3x3::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+
+        template<typename T> bool Median3x3::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+
+            //
+            // Rows read their neighbours, in place filtering needs a copy of the source
+            //
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == destination.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            const size_t height = input.height;
+
+            parallelStrips(height, 16, [&](size_t begin, size_t end){
+
+                AlignedBuffer<T> scratch(3 * input.rowElements());
+
+                for (size_t y = begin; y < end; y++) {
+                    const T *const rows[3] = {
+                        input.row(y > 0 ? y - 1 : 0),
+                        input.row(y),
+                        input.row(y + 1 < height ? y + 1 : y)
+                    };
+                    medianRow(rows, destination.row(y), input.width, input.channels, scratch.data());
+                }
+            });
+
+            return true;
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPConstantTimeMedian(IMPCpuImage source, IMPCpuImage destination,
+                               uint32_t radius, IMPMedianMode mode, uint32_t bits) {
+
+        if (source.format != destination.format) return false;
+
+        ConstantTimeMedian median(radius,
+                                  mode == IMPMedianModeLuma ? ConstantTimeMedian::luma : ConstantTimeMedian::perChannel,
+                                  bits > 0 ? bits : ConstantTimeMedian::maximumBits);
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = median.apply(view, target);
+        });
+
+        return done;
+    }
+
+    bool IMPMedian3x3(IMPCpuImage source, IMPCpuImage destination) {
+
+        if (source.format != destination.format) return false;
+
+        Median3x3 median;
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = median.apply(view, target);
+        });
+
+        return done;
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  IMPMedian_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPMedian_cpu_hpp
+#define IMPMedian_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Square (2*radius+1) x (2*radius+1) median with the Perreault - Hébert algorithm.
+        /// Every column keeps a histogram of its 2*radius+1 samples which is updated by one sample
+        /// in and one out when the window moves down a row, the window histogram is updated by one
+        /// column in and one out when it moves right. Histograms are two level: coarse bins are
+        /// updated on every step, fine bins of a coarse bin only when the median falls into it,
+        /// so the per-pixel cost does not depend on radius.
+        ///
+        /// Samples are quantized to 2^bits levels, 8-bit images always use 256 levels.
+        /// The image is split into column strips processed in parallel, edges are clamped.
+        ///
+        class ConstantTimeMedian {
+
+        public:
+
+            enum Mode {
+                /// Every channel is filtered independently
+                perChannel,
+                ///
+                /// Vector median keyed by luma, the same as kernel_median does: the output is the
+                /// colour of the window pixels whose luma is the median. Pixels which share the
+                /// median luma level are averaged, alpha is kept from the centre pixel.
+                ///
+                luma
+            };
+
+            static constexpr size_t minimumBits = 8;
+            static constexpr size_t maximumBits = 12;
+
+            ///
+            /// @param bits quantization of 16-bit and float samples, 8 - 12
+            ///
+            ConstantTimeMedian(size_t radius, Mode mode = perChannel, size_t bits = maximumBits);
+
+            inline size_t radius() const { return _radius; }
+            inline Mode   mode()   const { return _mode; }
+            inline size_t bits()   const { return _bits; }
+
+            ///
+            /// Filter source into destination, both must have the same size and channels.
+            /// Source and destination may be the same image. Returns false if the layouts don't match
+            /// or radius is more than 32766.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination, size_t bits) const;
+
+            size_t _radius;
+            Mode   _mode;
+            size_t _bits;
+        };
+
+        ///
+        /// 3x3 median of one row of interleaved samples. Columns of three rows are sorted once by
+        /// the mnmx3 network of kernel_median3x3 and shared by the three pixels which overlap them,
+        /// the median is med3(max of the minimums, med3 of the middles, min of the maximums).
+        /// Every step is a lane wise min/max over 16 (8-bit), 8 (16-bit) or 4 (float) samples, so the
+        /// channels of packed RGBA are independent lanes as well. Edge pixels are clamped.
+        ///
+        /// @param rows    rows y-1, y and y+1
+        /// @param scratch 3 * width * channels samples
+        ///
+        void median3x3Row(const uint8_t  *const rows[3], uint8_t  *out, size_t width, size_t channels, uint8_t  *scratch);
+        void median3x3Row(const uint16_t *const rows[3], uint16_t *out, size_t width, size_t channels, uint16_t *scratch);
+        void median3x3Row(const float    *const rows[3], float    *out, size_t width, size_t channels, float    *scratch);
+
+        ///
+        /// 3x3 median of every channel processed by rows in parallel, see median3x3Row
+        ///
+        class Median3x3 {
+
+        public:
+
+            ///
+            /// Filter source into destination, both must have the same size and channels.
+            /// Source and destination may be the same image.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPMedian_cpu_hpp */
@@ -0,0 +1,549 @@
+//
+//  IMPMorphology_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPMorphology_cpu.hpp"
+#include "IMPMorphology-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        Morphology::Morphology(Shape shape, size_t radiusX, size_t radiusY) {
+
+            switch (shape) {
+
+                case rectangle:
+                    if (radiusX > 0) _segments.push_back({ Segment::horizontal, radiusX });
+                    if (radiusY > 0) _segments.push_back({ Segment::vertical,   radiusY });
+                    break;
+
+                case diamond: {
+                    //
+                    // Two diagonal segments of radius a make the even points of the diamond of radius 2a,
+                    // a cross adds the odd points up to 2a + 1 and one more cross an even radius
+                    //
+                    if (radiusX == 0) break;
+                    size_t a = (radiusX - 1) / 2;
+                    if (a > 0) {
+                        _segments.push_back({ Segment::diagonal,     a });
+                        _segments.push_back({ Segment::antidiagonal, a });
+                    }
+                    _segments.push_back({ Segment::cross, 1 });
+                    if (radiusX % 2 == 0) _segments.push_back({ Segment::cross, 1 });
+                    break;
+                }
+
+                case disk: {
+                    //
+                    // Octagon of a square with half side a and a diamond of diagonals b: a + 2b is
+                    // the radius along the axes and a + b along the diagonals, the regular one has
+                    // b = (1 - 1/sqrt(2)) * radius. The diagonals alone reach every other point only,
+                    // so the square keeps a >= 1: where it would vanish, radius 2, one diagonal pair
+                    // gives way to a 3x3 cross, which adds one to both the axis reach a + 2b and the
+                    // |x| + |y| reach 2a + 2b
+                    //
+                    size_t b = size_t(std::floor(0.29289322f * float(radiusX) + 0.5f));
+                    size_t a = radiusX - 2 * b;
+                    const bool cross = b > 0 && a == 0;
+                    if (cross) { a = 1; b -= 1; }
+                    if (a > 0) {
+                        _segments.push_back({ Segment::horizontal, a });
+                        _segments.push_back({ Segment::vertical,   a });
+                    }
+                    if (b > 0) {
+                        _segments.push_back({ Segment::diagonal,     b });
+                        _segments.push_back({ Segment::antidiagonal, b });
+                    }
+                    if (cross) _segments.push_back({ Segment::cross, 1 });
+                    break;
+                }
+            }
+        }
+
+        size_t Morphology::reach() const {
+            size_t rows = 0;
+            for (auto &s: _segments) if (s.direction != Segment::horizontal) rows += s.radius;
+            return rows;
+        }
+
+        bool Morphology::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination, Operation operation) const {
+            return run(source, destination, operation);
+        }
+
+        bool Morphology::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination, Operation operation) const {
+            return run(source, destination, operation);
+        }
+
+        bool Morphology::apply(const ImageView<const float> &source, const ImageView<float> &destination, Operation operation) const {
+            return run(source, destination, operation);
+        }
+
+        namespace {
+
+            typedef Morphology::Segment Segment;
+
+            template<typename T> struct Erode {
+                static inline T identity() {
+                    return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+                }
+                template<typename V> inline V operator()(V a, V b) const { return min(a, b); }
+            };
+
+            template<typename T> struct Dilate {
+                static inline T identity() {
+                    return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+                }
+                template<typename V> inline V operator()(V a, V b) const { return max(a, b); }
+            };
+
+            //
+            // Rows of interleaved samples, rows start on 64 byte boundaries
+            //
+            template<typename T> struct Plane {
+
+                AlignedBuffer<T> buffer;
+                size_t rows     = 0;
+                size_t width    = 0;
+                size_t channels = 1;
+                size_t stride   = 0;
+
+                void resize(size_t rows, size_t width, size_t channels) {
+                    this->rows     = rows;
+                    this->width    = width;
+                    this->channels = channels;
+                    this->stride   = (width * channels * sizeof(T) + 63) / 64 * 64 / sizeof(T);
+                    buffer.resize(stride * rows);
+                }
+
+                inline T       *row(size_t y)       { return buffer.data() + y * stride; }
+                inline const T *row(size_t y) const { return buffer.data() + y * stride; }
+
+                inline size_t elements() const { return width * channels; }
+            };
+
+            template<typename T> struct Workspace {
+                Plane<T> swap;
+                Plane<T> padded;
+                Plane<T> forward;
+                Plane<T> backward;
+            };
+
+            //
+            // dst[j] = op(a[j], b[j])
+            //
+            template<typename T, typename Op> inline void combine(const T *a, const T *b, T *dst, size_t n, const Op &op) {
+
+                typedef typename RankLanes<T>::type V;
+                const size_t lanes = RankLanes<T>::count;
+
+                size_t j = 0;
+                for (; j + lanes <= n; j += lanes) op(V::load(a + j), V::load(b + j)).store(dst + j);
+                for (; j < n; j++) dst[j] = op(a[j], b[j]);
+            }
+
+            //
+            // dst[j] = op(previous[j - shift], current[j]), current[j] where the previous row has no sample
+            //
+            template<typename T, typename Op> inline void combineShifted(const T *previous, const T *current, T *dst,
+                                                                         size_t n, ptrdiff_t shift, const Op &op) {
+                size_t begin = shift > 0 ? size_t(shift) : 0;
+                size_t end   = shift < 0 ? n - size_t(-shift) : n;
+
+                std::copy(current, current + begin, dst);
+                std::copy(current + end, current + n, dst + end);
+
+                combine(previous + (ptrdiff_t(begin) - shift), current + begin, dst + begin, end - begin, op);
+            }
+
+            //
+            // van Herk - Gil-Werman min/max over the line segment of pixels (x + slope * t, y + t), |t| <= radius.
+            // Lines are cut into blocks of 2 * radius + 1 rows, forward holds the running extremum from the start
+            // of a block and backward the one to its end, any window of a block length spans two blocks at most:
+            // out = op(backward[window start], forward[window end]). Rows and columns outside the plane are the
+            // identity of op.
+            //
+            template<typename T, typename Op> void linePass(const Plane<T> &in, Plane<T> &out,
+                                                            size_t radius, int slope, const Op &op, Workspace<T> &w) {
+
+                const size_t    channels = in.channels;
+                const size_t    length   = 2 * radius + 1;
+                const size_t    pad      = slope != 0 ? radius : 0;
+                const size_t    rows     = in.rows + 2 * radius;
+                const size_t    width    = in.width + 2 * pad;
+                const size_t    n        = width * channels;
+                const ptrdiff_t shift    = ptrdiff_t(slope) * ptrdiff_t(channels);
+                const T         identity = Op::identity();
+
+                w.padded.resize(rows, width, channels);
+                w.forward.resize(rows, width, channels);
+                w.backward.resize(rows, width, channels);
+                out.resize(in.rows, in.width, channels);
+
+                for (size_t e = 0; e < rows; e++) {
+                    T   *p = w.padded.row(e);
+                    long y = long(e) - long(radius);
+                    if (y < 0 || y >= long(in.rows)) {
+                        std::fill(p, p + n, identity);
+                    }
+                    else {
+                        std::fill(p, p + pad * channels, identity);
+                        std::copy(in.row(size_t(y)), in.row(size_t(y)) + in.elements(), p + pad * channels);
+                        std::fill(p + pad * channels + in.elements(), p + n, identity);
+                    }
+                }
+
+                for (size_t e = 0; e < rows; e++) {
+                    if (e % length == 0)
+                        std::copy(w.padded.row(e), w.padded.row(e) + n, w.forward.row(e));
+                    else
+                        combineShifted(w.forward.row(e - 1), w.padded.row(e), w.forward.row(e), n, shift, op);
+                }
+
+                for (size_t e = rows; e-- > 0;) {
+                    if (e % length == length - 1 || e == rows - 1)
+                        std::copy(w.padded.row(e), w.padded.row(e) + n, w.backward.row(e));
+                    else
+                        combineShifted(w.backward.row(e + 1), w.padded.row(e), w.backward.row(e), n, -shift, op);
+                }
+
+                const ptrdiff_t first = (ptrdiff_t(pad) - slope * ptrdiff_t(radius)) * ptrdiff_t(channels);
+                const ptrdiff_t last  = (ptrdiff_t(pad) + slope * ptrdiff_t(radius)) * ptrdiff_t(channels);
+
+                for (size_t y = 0; y < in.rows; y++)
+                    combine(w.backward.row(y) + first, w.forward.row(y + 2 * radius) + last, out.row(y), in.elements(), op);
+            }
+
+            //
+            // Min/max over the pixel and its 4 neighbours
+            //
+            template<typename T, typename Op> void crossPass(const Plane<T> &in, Plane<T> &out, const Op &op) {
+
+                typedef typename RankLanes<T>::type V;
+                const size_t lanes = RankLanes<T>::count;
+
+                const size_t c = in.channels;
+                const size_t n = in.elements();
+
+                out.resize(in.rows, in.width, c);
+
+                for (size_t y = 0; y < in.rows; y++) {
+
+                    //
+                    // A missing neighbour is replaced by the pixel itself, which does not change min/max
+                    //
+                    const T *up      = in.row(y > 0 ? y - 1 : y);
+                    const T *current = in.row(y);
+                    const T *down    = in.row(y + 1 < in.rows ? y + 1 : y);
+
+                    T *o = out.row(y);
+
+                    combine(up, down, o, n, op);
+                    combine(o, current, o, n, op);
+
+                    if (in.width < 2) continue;
+
+                    size_t j = c;
+                    for (; j + lanes <= n - c; j += lanes)
+                        op(V::load(o + j), op(V::load(current + j - c), V::load(current + j + c))).store(o + j);
+                    for (; j < n - c; j++)
+                        o[j] = op(o[j], op(current[j - c], current[j + c]));
+
+                    for (size_t k = 0; k < c; k++) {
+                        o[k]         = op(o[k], current[k + c]);
+                        o[n - c + k] = op(o[n - c + k], current[n - 2 * c + k]);
+                    }
+                }
+            }
+
+            template<typename T> void transpose(const Plane<T> &in, Plane<T> &out) {
+
+                const size_t block = 32;
+                const size_t c     = in.channels;
+
+                out.resize(in.width, in.rows, c);
+
+                for (size_t y0 = 0; y0 < in.rows; y0 += block) {
+                    for (size_t x0 = 0; x0 < in.width; x0 += block) {
+                        size_t y1 = std::min(in.rows, y0 + block);
+                        size_t x1 = std::min(in.width, x0 + block);
+                        for (size_t y = y0; y < y1; y++) {
+                            const T *src = in.row(y);
+                            for (size_t x = x0; x < x1; x++)
+                                for (size_t k = 0; k < c; k++) out.row(x)[y * c + k] = src[x * c + k];
+                        }
+                    }
+                }
+            }
+
+            template<typename T, typename Op> void pass(Plane<T> &image, const Segment &segment, const Op &op, Workspace<T> &w) {
+
+                switch (segment.direction) {
+                    case Segment::horizontal:
+                    case Segment::vertical:
+                        linePass(image, w.swap, segment.radius, 0, op, w);
+                        break;
+                    case Segment::diagonal:
+                        linePass(image, w.swap, segment.radius, 1, op, w);
+                        break;
+                    case Segment::antidiagonal:
+                        linePass(image, w.swap, segment.radius, -1, op, w);
+                        break;
+                    case Segment::cross:
+                        crossPass(image, w.swap, op);
+                        break;
+                }
+
+                std::swap(image, w.swap);
+            }
+
+            //
+            // Erosion or dilation by the sum of the segments. Segments along the columns of the current
+            // layout go first, the rest after the plane is transposed, so composite operations transpose
+            // every plane once per operation at most.
+            //
+            template<typename T, typename Op> void morph(Plane<T> &image, bool &transposed,
+                                                         const std::vector<Segment> &segments, const Op &op, Workspace<T> &w) {
+
+                std::vector<const Segment*> later;
+
+                for (auto &s: segments) {
+                    bool across = (s.direction == Segment::horizontal && !transposed) || (s.direction == Segment::vertical && transposed);
+                    if (across) later.push_back(&s);
+                    else        pass(image, s, op, w);
+                }
+
+                if (later.empty()) return;
+
+                transpose(image, w.swap);
+                std::swap(image, w.swap);
+                transposed = !transposed;
+
+                for (auto s: later) pass(image, *s, op, w);
+            }
+
+            template<typename T> struct Band {
+                Plane<T>     image;
+                Plane<T>     other;
+                Workspace<T> workspace;
+            };
+
+            //
+            // Band rows [begin - halo, end + halo) with margin columns on both sides. Lines of the segments
+            // pass outside the image between the passes, so the margins and the rows beyond the image are
+            // filled with the identity of the first operation and stay in the band.
+            //
+            struct BandGeometry {
+                long   top;
+                size_t rows;
+                size_t margin;
+                size_t width;
+                size_t height;
+
+                inline bool insideRow(size_t r)    const { long y = top + long(r); return y >= 0 && y < long(height); }
+                inline bool insideColumn(size_t i) const { return i >= margin && i < margin + width; }
+            };
+
+            template<typename T> void load(const ImageView<const T> &source, const BandGeometry &g, Plane<T> &plane, T identity) {
+
+                const size_t c = source.channels;
+
+                plane.resize(g.rows, g.width + 2 * g.margin, c);
+
+                for (size_t r = 0; r < g.rows; r++) {
+                    T *p = plane.row(r);
+                    if (!g.insideRow(r)) {
+                        std::fill(p, p + plane.elements(), identity);
+                        continue;
+                    }
+                    std::fill(p, p + g.margin * c, identity);
+                    std::copy(source.row(size_t(g.top + long(r))), source.row(size_t(g.top + long(r))) + source.rowElements(), p + g.margin * c);
+                    std::fill(p + (g.margin + g.width) * c, p + plane.elements(), identity);
+                }
+            }
+
+            //
+            // Reset the samples outside the image to the identity of the next operation of a composite
+            //
+            template<typename T> void isolate(Plane<T> &plane, bool transposed, const BandGeometry &g, T identity) {
+
+                const size_t c = plane.channels;
+
+                for (size_t r = 0; r < plane.rows; r++) {
+
+                    T *p = plane.row(r);
+
+                    if (transposed ? !g.insideColumn(r) : !g.insideRow(r)) {
+                        std::fill(p, p + plane.elements(), identity);
+                        continue;
+                    }
+
+                    for (size_t i = 0; i < plane.width; i++)
+                        if (transposed ? !g.insideRow(i) : !g.insideColumn(i))
+                            std::fill(p + i * c, p + (i + 1) * c, identity);
+                }
+            }
+
+            template<typename T> void processBand(const ImageView<const T> &source, const ImageView<T> &destination,
+                                                  const std::vector<Segment> &segments, Morphology::Operation operation,
+                                                  size_t halo, size_t margin, size_t begin, size_t end, Band<T> &band) {
+
+                const BandGeometry g = { long(begin) - long(halo), end - begin + 2 * halo, margin, source.width, source.height };
+
+                Erode<T>  erode;
+                Dilate<T> dilate;
+
+                bool transposed = false;
+
+                Workspace<T> &w = band.workspace;
+
+                switch (operation) {
+                    case Morphology::erode:
+                        load(source, g, band.image, erode.identity());
+                        morph(band.image, transposed, segments, erode, w);
+                        break;
+                    case Morphology::dilate:
+                        load(source, g, band.image, dilate.identity());
+                        morph(band.image, transposed, segments, dilate, w);
+                        break;
+                    case Morphology::open:
+                    case Morphology::topHat:
+                        load(source, g, band.image, erode.identity());
+                        morph(band.image, transposed, segments, erode, w);
+                        isolate(band.image, transposed, g, dilate.identity());
+                        morph(band.image, transposed, segments, dilate, w);
+                        break;
+                    case Morphology::close:
+                    case Morphology::blackHat:
+                        load(source, g, band.image, dilate.identity());
+                        morph(band.image, transposed, segments, dilate, w);
+                        isolate(band.image, transposed, g, erode.identity());
+                        morph(band.image, transposed, segments, erode, w);
+                        break;
+                    case Morphology::gradient: {
+                        bool otherTransposed = false;
+                        load(source, g, band.image, dilate.identity());
+                        load(source, g, band.other, erode.identity());
+                        morph(band.image, transposed, segments, dilate, w);
+                        morph(band.other, otherTransposed, segments, erode, w);
+                        break;
+                    }
+                }
+
+                if (transposed) {
+                    transpose(band.image, w.swap);
+                    std::swap(band.image, w.swap);
+                    if (operation == Morphology::gradient) {
+                        transpose(band.other, w.swap);
+                        std::swap(band.other, w.swap);
+                    }
+                }
+
+                const size_t n = source.rowElements();
+                const size_t offset = margin * source.channels;
+
+                for (size_t y = begin; y < end; y++) {
+
+                    const T *result = band.image.row(y - begin + halo) + offset;
+                    const T *input  = source.row(y);
+                    T       *out    = destination.row(y);
+
+                    switch (operation) {
+                        case Morphology::topHat:
+                            for (size_t j = 0; j < n; j++) out[j] = T(input[j] - result[j]);
+                            break;
+                        case Morphology::blackHat:
+                            for (size_t j = 0; j < n; j++) out[j] = T(result[j] - input[j]);
+                            break;
+                        case Morphology::gradient: {
+                            const T *eroded = band.other.row(y - begin + halo) + offset;
+                            for (size_t j = 0; j < n; j++) out[j] = T(result[j] - eroded[j]);
+                            break;
+                        }
+                        default:
+                            std::copy(result, result + n, out);
+                            break;
+                    }
+                }
+            }
+        }
+
+        template<typename T> bool Morphology::run(const ImageView<const T> &source, const ImageView<T> &destination, Operation operation) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+
+            //
+            // Bands read the rows of their neighbours, in place filtering needs a copy of the source
+            //
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == destination.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            bool composite = operation == open || operation == close || operation == topHat || operation == blackHat;
+
+            size_t columns = 0;
+            for (auto &s: _segments) if (s.direction != Segment::vertical) columns += s.radius;
+
+            size_t halo   = reach()  * (composite ? 2 : 1);
+            size_t margin = columns * (composite ? 2 : 1);
+
+            //
+            // Bands several halos high keep the recomputed halo rows a fraction of the work
+            //
+            size_t rows   = std::max<size_t>(64, 4 * halo);
+
+            parallelStrips(input.height, rows, [&](size_t begin, size_t end){
+                Band<T> band;
+                for (size_t y = begin; y < end; y += rows)
+                    processBand(input, destination, _segments, operation, halo, margin, y, std::min(end, y + rows), band);
+            });
+
+            return true;
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPMorphologyApply(IMPCpuImage source, IMPCpuImage destination,
+                            IMPMorphologyOperation operation, IMPMorphologyShape shape,
+                            uint32_t radiusX, uint32_t radiusY) {
+
+        if (source.format != destination.format) return false;
+        if (operation < IMPMorphologyErode || operation > IMPMorphologyGradient) return false;
+        if (shape < IMPMorphologyRectangle || shape > IMPMorphologyDisk) return false;
+
+        Morphology morphology(Morphology::Shape(shape), radiusX, radiusY);
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = morphology.apply(view, target, Morphology::Operation(operation));
+        });
+
+        return done;
+    }
+}
@@ -0,0 +1,99 @@
+//
+//  IMPMorphology_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPMorphology_cpu_hpp
+#define IMPMorphology_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Grey scale morphology with flat symmetric structuring elements decomposed into line
+        /// segments. Every segment is a van Herk - Gil-Werman running min/max: three min/max per
+        /// sample whatever the segment length is. Lines are filtered along the columns, so every step
+        /// is a lane wise min/max over a row; horizontal segments run on a transposed band.
+        ///
+        /// The image is processed by bands of rows with a halo in parallel, composite operations
+        /// keep their intermediates in the band buffers only. Samples outside the image don't take
+        /// part in the min/max, the same as clamp_to_edge sampling does for a flat element.
+        ///
+        class Morphology {
+
+        public:
+
+            enum Shape {
+                /// (2*radiusX+1) x (2*radiusY+1) rectangle
+                rectangle,
+                /// |x| + |y| <= radius, exact: two diagonal segments and one or two 3x3 crosses
+                diamond,
+                /// Regular octagon of the radius as the disk approximation: horizontal, vertical and
+                /// two diagonal segments, a 3x3 cross for a diagonal pair at radius 2
+                disk
+            };
+
+            enum Operation {
+                erode,
+                dilate,
+                /// Dilation of the erosion
+                open,
+                /// Erosion of the dilation
+                close,
+                /// Source minus opening
+                topHat,
+                /// Closing minus source
+                blackHat,
+                /// Dilation minus erosion
+                gradient
+            };
+
+            ///
+            /// Diamond and disk use radiusX only
+            ///
+            Morphology(Shape shape, size_t radiusX, size_t radiusY);
+
+            explicit Morphology(Shape shape, size_t radius): Morphology(shape, radius, radius) {}
+
+            ///
+            /// Filter source into destination, both must have the same size and channels.
+            /// Source and destination may be the same image.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination, Operation operation) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination, Operation operation) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination, Operation operation) const;
+
+            struct Segment {
+                enum Direction { horizontal, vertical, diagonal, antidiagonal, cross };
+                Direction direction;
+                size_t    radius;
+            };
+
+            /// Line segments whose Minkowski sum is the structuring element
+            inline const std::vector<Segment> &segments() const { return _segments; }
+
+            /// Rows above and below a pixel the structuring element reaches
+            size_t reach() const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination, Operation operation) const;
+
+            std::vector<Segment> _segments;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPMorphology_cpu_hpp */
@@ -0,0 +1,259 @@
+//
+//  IMPNonMaximumSuppression_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPNonMaximumSuppression_cpu.hpp"
+#include "IMPNonMaximumSuppression-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        constexpr size_t NonMaximumSuppression::tileSize;
+
+        template<typename T> bool NonMaximumSuppression::run(const ImageView<const T> &response, std::vector<Maximum> &maxima) const {
+
+            maxima.clear();
+
+            if (response.empty()) return false;
+
+            const size_t width  = response.width;
+            const size_t height = response.height;
+            const size_t stride = width + 2;
+            const float  scale  = 1.0f / PixelTraits<T>::maximum;
+
+            const size_t bands = (height + tileSize - 1) / tileSize;
+
+            std::vector<std::vector<Maximum>> found(bands);
+
+            parallelFor(bands, [&](size_t band){
+
+                const long y0 = long(band * tileSize), y1 = std::min(y0 + long(tileSize), long(height));
+
+                //
+                // Rows of the band and one more on each side, columns padded by one; the outside is
+                // replicated as clamp_to_edge samples it
+                //
+                AlignedBuffer<float> rows(size_t(y1 - y0 + 2) * stride);
+
+                for (long y = y0 - 1; y <= y1; y++) {
+                    const T *p = response.row(size_t(std::min(std::max(y, 0L), long(height) - 1)));
+                    float   *r = rows.data() + size_t(y - y0 + 1) * stride + 1;
+                    for (size_t x = 0; x < width; x++, p += response.channels) r[x] = float(p[0]) * scale;
+                    r[-1] = r[0];
+                    r[width] = r[width - 1];
+                }
+
+                suppress([&](long y){ return static_cast<const float*>(rows.data() + size_t(y - y0 + 1) * stride + 1); },
+                         0, long(width), y0, y1, _options.threshold, found[band]);
+            });
+
+            compact(found, 1, maxima);
+
+            return true;
+        }
+
+        void NonMaximumSuppression::compact(const std::vector<std::vector<Maximum>> &tiles, size_t columns, std::vector<Maximum> &maxima) const {
+
+            maxima.clear();
+
+            if (columns == 0 || tiles.empty()) return;
+
+            const size_t rows = (tiles.size() + columns - 1) / columns;
+
+            //
+            // Prefix sum of the counts of the tile rows gives every row its place in the list
+            //
+            std::vector<size_t> offsets(rows + 1, 0);
+
+            for (size_t r = 0; r < rows; r++) {
+                size_t count = 0;
+                for (size_t i = r * columns; i < std::min((r + 1) * columns, tiles.size()); i++) count += tiles[i].size();
+                offsets[r + 1] = offsets[r] + count;
+            }
+
+            maxima.resize(offsets[rows]);
+
+            //
+            // Tiles of a row cover the same image rows, their lists interleave image row by image row
+            //
+            parallelFor(rows, [&](size_t r){
+
+                const size_t first = r * columns, last = std::min(first + columns, tiles.size());
+
+                Maximum *out = maxima.data() + offsets[r];
+
+                if (last - first == 1) {
+                    std::copy(tiles[first].begin(), tiles[first].end(), out);
+                    return;
+                }
+
+                std::vector<size_t> cursor(last - first, 0);
+
+                for (;;) {
+
+                    uint32_t y = UINT32_MAX;
+
+                    for (size_t i = first; i < last; i++) {
+                        const size_t c = cursor[i - first];
+                        if (c < tiles[i].size()) y = std::min(y, tiles[i][c].y);
+                    }
+
+                    if (y == UINT32_MAX) break;
+
+                    for (size_t i = first; i < last; i++) {
+                        const auto &list = tiles[i];
+                        size_t &c = cursor[i - first];
+                        while (c < list.size() && list[c].y == y) *out++ = list[c++];
+                    }
+                }
+            });
+
+            select(maxima);
+        }
+
+        void NonMaximumSuppression::select(std::vector<Maximum> &maxima) const {
+
+            const size_t topK     = _options.topK;
+            const float  distance = _options.minDistance;
+
+            //
+            // Distinct pixels are never closer than 1
+            //
+            if (!(distance > 1.0f)) {
+
+                if (topK == 0 || maxima.size() <= topK) return;
+
+                //
+                // Response of the k-th strongest: the stronger ones stay, ties are taken in raster order
+                //
+                std::vector<float> responses(maxima.size());
+                for (size_t i = 0; i < maxima.size(); i++) responses[i] = maxima[i].response;
+
+                std::nth_element(responses.begin(), responses.begin() + long(topK - 1), responses.end(), std::greater<float>());
+
+                const float kth = responses[topK - 1];
+
+                size_t ties = topK;
+                for (const auto &m: maxima) if (m.response > kth) ties--;
+
+                size_t count = 0;
+                for (const auto &m: maxima) {
+                    if (m.response > kth || (m.response == kth && ties > 0 && ties--)) maxima[count++] = m;
+                }
+                maxima.resize(count);
+
+                return;
+            }
+
+            //
+            // Greedy from the strongest: a maximum stays when no kept one lies closer than the
+            // distance. Kept maxima are linked into grid cells of at least the distance, so only the
+            // 3x3 cells around a candidate are visited.
+            //
+            std::vector<uint32_t> order(maxima.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b){ return maxima[a].response > maxima[b].response; });
+
+            const float cell = std::max(distance, 16.0f);
+
+            uint32_t right = 0, bottom = 0;
+            for (const auto &m: maxima) { right = std::max(right, m.x); bottom = std::max(bottom, m.y); }
+
+            const long columns = long(float(right) / cell) + 1;
+            const long rows    = long(float(bottom) / cell) + 1;
+
+            std::vector<long>    head(size_t(columns * rows), -1);
+            std::vector<long>    next(maxima.size(), -1);
+            std::vector<uint8_t> kept(maxima.size(), 0);
+
+            const float limit = distance * distance;
+            size_t count = 0;
+
+            for (uint32_t index: order) {
+
+                if (topK > 0 && count == topK) break;
+
+                const Maximum &m = maxima[index];
+
+                const long cx = long(float(m.x) / cell), cy = long(float(m.y) / cell);
+
+                bool near = false;
+
+                for (long v = std::max(cy - 1, 0L); v <= std::min(cy + 1, rows - 1) && !near; v++) {
+                    for (long u = std::max(cx - 1, 0L); u <= std::min(cx + 1, columns - 1) && !near; u++) {
+                        for (long k = head[size_t(v * columns + u)]; k >= 0; k = next[size_t(k)]) {
+                            const float dx = float(maxima[size_t(k)].x) - float(m.x);
+                            const float dy = float(maxima[size_t(k)].y) - float(m.y);
+                            if (dx * dx + dy * dy < limit) { near = true; break; }
+                        }
+                    }
+                }
+
+                if (near) continue;
+
+                const size_t c = size_t(cy * columns + cx);
+                next[index] = head[c];
+                head[c] = long(index);
+                kept[index] = 1;
+                count++;
+            }
+
+            size_t j = 0;
+            for (size_t i = 0; i < maxima.size(); i++) if (kept[i]) maxima[j++] = maxima[i];
+            maxima.resize(j);
+        }
+
+        bool NonMaximumSuppression::maxima(const ImageView<const uint8_t> &response, std::vector<Maximum> &maxima) const {
+            return run(response, maxima);
+        }
+
+        bool NonMaximumSuppression::maxima(const ImageView<const uint16_t> &response, std::vector<Maximum> &maxima) const {
+            return run(response, maxima);
+        }
+
+        bool NonMaximumSuppression::maxima(const ImageView<const float> &response, std::vector<Maximum> &maxima) const {
+            return run(response, maxima);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    size_t IMPNonMaximumSuppressionMaxima(IMPCpuImage response, IMPCpuMaximum *maxima, size_t capacity, IMPNonMaximumSuppressionOptions options) {
+
+        NonMaximumSuppression::Options o;
+        o.threshold   = options.threshold;
+        o.topK        = options.topK;
+        o.minDistance = options.minDistance;
+
+        NonMaximumSuppression suppression(o);
+
+        std::vector<NonMaximumSuppression::Maximum> found;
+
+        dispatch(response, [&](auto view){
+            suppression.maxima(view.readonly(), found);
+        });
+
+        const size_t count = std::min(capacity, found.size());
+
+        for (size_t i = 0; maxima && i < count; i++) {
+            maxima[i].point[0] = float(found[i].x) / float(response.width);
+            maxima[i].point[1] = float(found[i].y) / float(response.height);
+            maxima[i].response = found[i].response;
+        }
+
+        return found.size();
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  IMPNonMaximumSuppression_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPNonMaximumSuppression_cpu_hpp
+#define IMPNonMaximumSuppression_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// fragment_nonMaximumSuppression that emits the maxima instead of a mask: a pixel is a
+        /// maximum when it is strictly greater than its top, top left, left and bottom left
+        /// neighbours, not less than the rest and not less than the threshold.
+        ///
+        /// Tiles collect their maxima in local lists, the lists are compacted by prefix sums of
+        /// their counts into one list in raster order. The strongest maxima and a minimal
+        /// distance between them are selected on the compacted list, which keeps raster order.
+        ///
+        class NonMaximumSuppression {
+
+        public:
+
+            struct Options {
+                /// Minimal response, IMPNonMaximumSuppression.defaultThreshold
+                float  threshold   = 0.2f;
+                /// Keep the strongest maxima only, 0 keeps all
+                size_t topK        = 0;
+                /// Drop maxima closer than that to a stronger kept one, in pixels; 0 keeps all
+                float  minDistance = 0;
+            };
+
+            struct Maximum {
+                uint32_t x, y;
+                float    response;
+            };
+
+            /// Rows of a band of the response plane processed by one task
+            static constexpr size_t tileSize = 64;
+
+            explicit NonMaximumSuppression(const Options &options): _options(options) {}
+
+            NonMaximumSuppression(): NonMaximumSuppression(Options()) {}
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Maxima of the first channel of a response, replaces the content of maxima
+            ///
+            bool maxima(const ImageView<const uint8_t>  &response, std::vector<Maximum> &maxima) const;
+            bool maxima(const ImageView<const uint16_t> &response, std::vector<Maximum> &maxima) const;
+            bool maxima(const ImageView<const float>    &response, std::vector<Maximum> &maxima) const;
+
+            ///
+            /// Maxima of rows [y0, y1) and columns [x0, x1) appended in raster order. row(y) returns
+            /// a pointer indexed by image columns, readable at x0 - 1 ... x1 for rows y0 - 1 ... y1,
+            /// so fused detectors suppress their own tiles without a response plane.
+            ///
+            template<typename Row> static void suppress(Row &&row, long x0, long x1, long y0, long y1,
+                                                        float threshold, std::vector<Maximum> &maxima) {
+                for (long y = y0; y < y1; y++) {
+
+                    const float *top    = row(y - 1);
+                    const float *mid    = row(y);
+                    const float *bottom = row(y + 1);
+
+                    for (long x = x0; x < x1; x++) {
+
+                        const float c = mid[x];
+
+                        if (!(c >= threshold)) continue;
+
+                        if (!(c > top[x] && c > top[x - 1] && c > mid[x - 1] && c > bottom[x - 1])) continue;
+                        if (!(c >= bottom[x] && c >= bottom[x + 1] && c >= mid[x + 1] && c >= top[x + 1])) continue;
+
+                        maxima.push_back(Maximum{ uint32_t(x), uint32_t(y), c });
+                    }
+                }
+            }
+
+            ///
+            /// Compact the lists of a grid of tiles, columns tiles a row, every list in raster
+            /// order, into one list in raster order and select the strongest as the options say
+            ///
+            void compact(const std::vector<std::vector<Maximum>> &tiles, size_t columns, std::vector<Maximum> &maxima) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &response, std::vector<Maximum> &maxima) const;
+
+            void select(std::vector<Maximum> &maxima) const;
+
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPNonMaximumSuppression_cpu_hpp */
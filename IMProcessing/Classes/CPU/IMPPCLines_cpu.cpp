@@ -0,0 +1,220 @@
+//
+//  IMPPCLines_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPPCLines_cpu.hpp"
+#include "IMPPCLines-Bridging-CPU.h"
+#include "IMPNonMaximumSuppression_cpu.hpp"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        PCLines::PCLines(size_t width, size_t height, const Options &options):
+        _options(options), _width(width), _height(height) {
+            _options.resolution = std::max<size_t>(_options.resolution, 1);
+            _cx    = (float(width)  - 1.0f) * 0.5f;
+            _cy    = (float(height) - 1.0f) * 0.5f;
+            _scale = std::max(std::max(_cx, _cy), 0.5f);
+        }
+
+        bool PCLines::transform(const std::vector<HoughSpace::Point> &points) {
+
+            const size_t n = size();
+            const long   R = long(_options.resolution);
+
+            _bins.assign(n * n, 0);
+
+            //
+            // Points in accumulator units: v * resolution of the column c = u * resolution is
+            // x + (x + y) * c / resolution in T and x + (y - x) * c / resolution in S
+            //
+            std::vector<HoughSpace::Point> normalized(points.size());
+
+            const float k = float(R) / _scale;
+
+            for (size_t i = 0; i < points.size(); i++) {
+                normalized[i].x = (points[i].x - _cx) * k;
+                normalized[i].y = (points[i].y - _cy) * k;
+            }
+
+            std::vector<float> columns(n + 3);
+            for (size_t i = 0; i < columns.size(); i++) columns[i] = float(long(i) - R) / float(R);
+
+            uint32_t *bins = _bins.data();
+
+            parallelStrips(n, 16, [&](size_t begin, size_t end){
+
+                float rows[4];
+
+                //
+                // Columns [first, last) of a segment through x at u = 0 with the given slope, rows
+                // are biased by resolution + 0.5 so a truncation rounds them
+                //
+                auto segment = [&](float x, float slope, size_t first, size_t last){
+
+                    const Vec4f base(x + float(R) + 0.5f), step(slope);
+
+                    size_t i = first;
+
+                    for (; i + 4 <= last; i += 4) {
+                        (base + step * Vec4f::load(columns.data() + i)).store(rows);
+                        for (size_t j = 0; j < 4; j++) {
+                            const long r = std::min(std::max(long(rows[j]), 0L), 2 * R);
+                            bins[size_t(r) * n + i + j]++;
+                        }
+                    }
+                    for (; i < last; i++) {
+                        const long r = std::min(std::max(long(x + float(R) + 0.5f + slope * columns[i]), 0L), 2 * R);
+                        bins[size_t(r) * n + i]++;
+                    }
+                };
+
+                const size_t middle = size_t(R);
+
+                for (const auto &p: normalized) {
+                    if (begin < middle) segment(p.x, p.x + p.y, begin, std::min(end, middle));
+                    if (end > middle)   segment(p.x, p.y - p.x, std::max(begin, middle), end);
+                }
+            });
+
+            return true;
+        }
+
+        template<typename T> bool PCLines::image(const ImageView<const T> &image) {
+
+            if (image.empty() || image.width != _width || image.height != _height) return false;
+
+            std::vector<HoughSpace::Point> points;
+
+            HoughSpace::edges(image, points);
+
+            return transform(points);
+        }
+
+        bool PCLines::transform(const ImageView<const uint8_t> &image) {
+            return this->image(image);
+        }
+
+        bool PCLines::transform(const ImageView<const uint16_t> &image) {
+            return this->image(image);
+        }
+
+        bool PCLines::transform(const ImageView<const float> &image) {
+            return this->image(image);
+        }
+
+        void PCLines::lines(std::vector<Line> &lines) const {
+
+            lines.clear();
+
+            const size_t n = size();
+
+            if (_bins.size() != n * n) return;
+
+            Image<float> plane;
+            plane.resize(n, n, 1);
+
+            for (size_t y = 0; y < n; y++) {
+                const uint32_t *b = _bins.data() + y * n;
+                float          *p = plane.row(y);
+                for (size_t x = 0; x < n; x++) p[x] = float(b[x]);
+            }
+
+            NonMaximumSuppression::Options o;
+            o.threshold   = float(_options.threshold);
+            o.topK        = _options.linesMax;
+            o.minDistance = _options.minDistance;
+
+            std::vector<NonMaximumSuppression::Maximum> maxima;
+
+            NonMaximumSuppression(o).maxima(plane.view().readonly(), maxima);
+
+            std::stable_sort(maxima.begin(), maxima.end(), [](const NonMaximumSuppression::Maximum &a, const NonMaximumSuppression::Maximum &b){
+                return a.response > b.response;
+            });
+
+            const float R = float(_options.resolution);
+
+            for (const auto &m: maxima) {
+
+                //
+                // Sub-bin position: centroid of the 3x3 neighbourhood
+                //
+                double sum = 0, su = 0, sv = 0;
+
+                for (long v = std::max(long(m.y) - 1, 0L); v <= std::min(long(m.y) + 1, long(n) - 1); v++) {
+                    for (long u = std::max(long(m.x) - 1, 0L); u <= std::min(long(m.x) + 1, long(n) - 1); u++) {
+                        const double w = _bins[size_t(v) * n + size_t(u)];
+                        sum += w; su += w * double(u); sv += w * double(v);
+                    }
+                }
+
+                const float u = (float(su / sum) - R) / R;
+                const float v = (float(sv / sum) - R) / R;
+
+                //
+                // S: (u - 1) x - u y + v = 0, T: (u + 1) x + u y - v = 0 in normalized coordinates
+                //
+                const float a = u >= 0 ? u - 1.0f : u + 1.0f;
+                const float b = u >= 0 ? -u : u;
+                const float c = u >= 0 ? v : -v;
+
+                //
+                // Back to pixels, then to the normal form
+                //
+                const float C      = c * _scale - a * _cx - b * _cy;
+                const float length = std::sqrt(a * a + b * b);
+
+                float theta = std::atan2(b, a);
+                float rho   = -C / length;
+
+                if (theta < 0)                { theta += float(M_PI); rho = -rho; }
+                if (theta >= float(M_PI))     { theta -= float(M_PI); rho = -rho; }
+
+                lines.push_back(Line{ rho, theta, uint32_t(m.response) });
+            }
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    size_t IMPPCLinesDetect(IMPCpuImage image, IMPCpuPolarLine *lines, size_t capacity, IMPPCLinesOptions options) {
+
+        PCLines::Options o;
+        o.resolution  = options.resolution;
+        o.threshold   = options.threshold;
+        o.linesMax    = options.linesMax;
+        o.minDistance = options.minDistance;
+
+        PCLines pclines(image.width, image.height, o);
+
+        std::vector<PCLines::Line> found;
+
+        dispatch(image, [&](auto view){
+            if (pclines.transform(view.readonly())) pclines.lines(found);
+        });
+
+        const size_t count = std::min(capacity, found.size());
+
+        for (size_t i = 0; lines && i < count; i++) {
+            lines[i].rho   = found[i].rho;
+            lines[i].theta = found[i].theta;
+            lines[i].votes = found[i].votes;
+        }
+
+        return found.size();
+    }
+}
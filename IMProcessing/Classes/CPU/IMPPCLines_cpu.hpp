@@ -0,0 +1,103 @@
+//
+//  IMPPCLines_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPPCLines_cpu_hpp
+#define IMPPCLines_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+#include "IMPHoughSpace_cpu.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// PCLines: lines in the parallel coordinates TS space (Dubska et al., Real-Time Line
+        /// Detection Using PC and OpenGL, see Theory). Image coordinates are normalized to [-1, 1],
+        /// a point x, y becomes the segment from (-1, -y) to (0, x) of the twisted space and the one
+        /// from (0, x) to (1, y) of the straight space. Segments of the points of a line meet in one
+        /// point: lines of negative slope in S, of positive slope in T.
+        ///
+        /// The accumulator has 2 * resolution + 1 columns and rows over u, v in [-1, 1], a point
+        /// votes once a column. Columns are split between tasks, consecutive votes of a point hit
+        /// neighbour bins of a row band so the accumulator is walked in cache order. Maxima are
+        /// found by NonMaximumSuppression and refined by the centroid of their 3x3 neighbourhood.
+        ///
+        class PCLines {
+
+        public:
+
+            struct Options {
+                /// Columns of each of the T and S spaces
+                size_t   resolution  = 256;
+                /// Minimal votes of a line
+                uint32_t threshold   = 32;
+                /// Strongest lines to keep, 0 keeps all
+                size_t   linesMax    = 100;
+                /// Minimal distance of two maxima in accumulator bins
+                float    minDistance = 2.0f;
+            };
+
+            ///
+            /// IMPPolarLine of the image pixels: x * cos(theta) + y * sin(theta) = rho, theta in [0, pi)
+            ///
+            struct Line {
+                float    rho, theta;
+                uint32_t votes;
+            };
+
+            PCLines(size_t width, size_t height, const Options &options);
+
+            inline const Options &options() const { return _options; }
+
+            /// Columns and rows of the accumulator
+            inline size_t size() const { return 2 * _options.resolution + 1; }
+
+            /// Row major accumulator, column resolution is u = 0
+            inline const uint32_t *accumulator() const { return _bins.data(); }
+
+            ///
+            /// Vote the pixels whose first channel is at least half of the range
+            ///
+            bool transform(const ImageView<const uint8_t>  &image);
+            bool transform(const ImageView<const uint16_t> &image);
+            bool transform(const ImageView<const float>    &image);
+
+            ///
+            /// Vote points in pixel coordinates
+            ///
+            bool transform(const std::vector<HoughSpace::Point> &points);
+
+            ///
+            /// Lines of the accumulator maxima, the strongest first
+            ///
+            void lines(std::vector<Line> &lines) const;
+
+        private:
+
+            template<typename T> bool image(const ImageView<const T> &image);
+
+            Options _options;
+            size_t  _width, _height;
+
+            /// Pixel coordinates to [-1, 1]
+            float _cx, _cy, _scale;
+
+            std::vector<uint32_t> _bins;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPPCLines_cpu_hpp */
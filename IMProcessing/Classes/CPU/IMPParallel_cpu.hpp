@@ -0,0 +1,108 @@
+//
+//  IMPParallel_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPParallel_cpu_hpp
+#define IMPParallel_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef __APPLE__
+#include <dispatch/dispatch.h>
+#endif
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Number of hardware threads available for the CPU engines.
+        ///
+        inline size_t concurrency() {
+            size_t n = std::thread::hardware_concurrency();
+            return n > 0 ? n : 1;
+        }
+
+        namespace detail {
+            template<typename F> struct ApplyContext {
+                F *function;
+            };
+
+            template<typename F> void applyTrampoline(void *context, size_t index) {
+                (*static_cast<ApplyContext<F>*>(context)->function)(index);
+            }
+        }
+
+        ///
+        /// Run fn(index) for index in [0, count). On Apple platforms the work is scheduled
+        /// by GCD the same way the Swift side does it with DispatchQueue.concurrentPerform,
+        /// elsewhere it falls back to a set of short living std::threads.
+        ///
+        template<typename F> void parallelFor(size_t count, F &&fn) {
+
+            if (count == 0) return;
+
+            if (count == 1 || concurrency() == 1) {
+                for (size_t i = 0; i < count; i++) fn(i);
+                return;
+            }
+
+#ifdef __APPLE__
+            typedef typename std::remove_reference<F>::type Function;
+            detail::ApplyContext<Function> context = { &fn };
+            dispatch_apply_f(count,
+                             dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                             &context,
+                             detail::applyTrampoline<Function>);
+#else
+            size_t workers = std::min(count, concurrency());
+            std::vector<std::thread> threads;
+            threads.reserve(workers);
+            for (size_t w = 0; w < workers; w++) {
+                threads.emplace_back([&fn, w, workers, count]{
+                    for (size_t i = w; i < count; i += workers) fn(i);
+                });
+            }
+            for (auto &t: threads) t.join();
+#endif
+        }
+
+        ///
+        /// Split [0, total) into contiguous strips of at least `grain` items and run
+        /// fn(begin, end) for every strip in parallel. Strips are a few times more than
+        /// the number of cores to let the scheduler balance uneven rows.
+        ///
+        template<typename F> void parallelStrips(size_t total, size_t grain, F &&fn) {
+
+            if (total == 0) return;
+
+            grain = std::max<size_t>(grain, 1);
+
+            size_t strips = std::min((total + grain - 1) / grain, concurrency() * 4);
+            strips = std::max<size_t>(strips, 1);
+
+            size_t step = (total + strips - 1) / strips;
+            strips = (total + step - 1) / step;
+
+            parallelFor(strips, [&](size_t s){
+                size_t begin = s * step;
+                size_t end   = std::min(total, begin + step);
+                fn(begin, end);
+            });
+        }
+    }
+}
+
+#endif
+
+#endif /* IMPParallel_cpu_hpp */
@@ -0,0 +1,295 @@
+//
+//  IMPPerspectiveWarp_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPPerspectiveWarp_cpu.hpp"
+#include "IMPPerspectiveWarp-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSampler_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            void multiply(const double a[9], const double b[9], double c[9]) {
+                for (int r = 0; r < 3; r++)
+                    for (int k = 0; k < 3; k++)
+                        c[r * 3 + k] = a[r * 3] * b[k] + a[r * 3 + 1] * b[3 + k] + a[r * 3 + 2] * b[6 + k];
+            }
+
+            bool invert(const double m[9], double inverse[9]) {
+
+                const double c0 = m[4] * m[8] - m[5] * m[7];
+                const double c1 = m[5] * m[6] - m[3] * m[8];
+                const double c2 = m[3] * m[7] - m[4] * m[6];
+                const double det = m[0] * c0 + m[1] * c1 + m[2] * c2;
+
+                if (!(std::fabs(det) > std::numeric_limits<double>::epsilon())) return false;
+
+                const double s = 1.0 / det;
+
+                inverse[0] = c0 * s;
+                inverse[1] = (m[2] * m[7] - m[1] * m[8]) * s;
+                inverse[2] = (m[1] * m[5] - m[2] * m[4]) * s;
+                inverse[3] = c1 * s;
+                inverse[4] = (m[0] * m[8] - m[2] * m[6]) * s;
+                inverse[5] = (m[2] * m[3] - m[0] * m[5]) * s;
+                inverse[6] = c2 * s;
+                inverse[7] = (m[1] * m[6] - m[0] * m[7]) * s;
+                inverse[8] = (m[0] * m[4] - m[1] * m[3]) * s;
+
+                return true;
+            }
+
+            //
+            // x of a row with alpha + beta x >= 0, narrows [lo, hi]
+            //
+            inline void halfLine(double alpha, double beta, double &lo, double &hi) {
+                if (beta > 0)      lo = std::max(lo, -alpha / beta);
+                else if (beta < 0) hi = std::min(hi, -alpha / beta);
+                else if (alpha < 0) { lo = 1; hi = 0; }
+            }
+        }
+
+        PerspectiveWarp::PerspectiveWarp(const float matrix[9], const Options &options): _options(options) {
+            for (int i = 0; i < 9; i++) _matrix[i] = matrix[i];
+            _options.span     = std::max<size_t>(_options.span, 1);
+            _options.tileSize = std::max<size_t>(_options.tileSize, 8);
+        }
+
+        bool PerspectiveWarp::matrix(const float model[16],
+                                     size_t sourceWidth, size_t sourceHeight,
+                                     size_t destinationWidth, size_t destinationHeight,
+                                     float matrix[9]) {
+
+            if (sourceWidth == 0 || sourceHeight == 0 || destinationWidth == 0 || destinationHeight == 0) return false;
+
+            //
+            // The plane z = 0 of the model: rows and columns x, y and w of the column major matrix
+            //
+            const int axes[3] = { 0, 1, 3 };
+
+            double plane[9], inverse[9];
+            for (int r = 0; r < 3; r++)
+                for (int c = 0; c < 3; c++)
+                    plane[r * 3 + c] = model[axes[c] * 4 + axes[r]];
+
+            if (!invert(plane, inverse)) return false;
+
+            //
+            // Destination pixels to clip space, clip space to source pixels
+            //
+            const double dw = double(destinationWidth), dh = double(destinationHeight);
+            const double sw = double(sourceWidth),      sh = double(sourceHeight);
+
+            const double toClip[9] = {
+                2.0 / dw, 0,         1.0 / dw - 1.0,
+                0,        -2.0 / dh, 1.0 - 1.0 / dh,
+                0,        0,         1
+            };
+
+            const double toPixels[9] = {
+                sw * 0.5, 0,         sw * 0.5 - 0.5,
+                0,        -sh * 0.5, sh * 0.5 - 0.5,
+                0,        0,         1
+            };
+
+            double t[9], m[9];
+            multiply(inverse, toClip, t);
+            multiply(toPixels, t, m);
+
+            for (int i = 0; i < 9; i++) matrix[i] = float(m[i]);
+
+            return true;
+        }
+
+        template<typename T, typename Sampler> void PerspectiveWarp::warp(const Sampler &sampler, const ImageView<T> &destination) const {
+
+            const ImageView<const T> &source = sampler.image();
+
+            const size_t channels = destination.channels;
+            const size_t tile     = _options.tileSize;
+            const size_t columns  = (destination.width  + tile - 1) / tile;
+            const size_t rows     = (destination.height + tile - 1) / tile;
+
+            const double *m   = _matrix;
+            const double  maxX = double(source.width)  - 0.5;
+            const double  maxY = double(source.height) - 0.5;
+
+            const float maximum = PixelTraits<T>::maximum;
+            const Vec4f background(_options.background[0] * maximum, _options.background[1] * maximum,
+                                   _options.background[2] * maximum, _options.background[3] * maximum);
+            const T     fill = PixelTraits<T>::fromFloat(_options.background[0] * maximum);
+
+            const double c         = std::fabs(m[6]);
+            const double tolerance = 4.0 * double(_options.tolerance);
+            const size_t span      = _options.span;
+
+            auto put = [&](T *out, size_t x, float sx, float sy) {
+                if (channels == 4) storePixel(sampler.rgba(sx, sy), out + x * 4);
+                else               out[x] = PixelTraits<T>::fromFloat(sampler.gray(sx, sy));
+            };
+
+            auto clear = [&](T *out, size_t begin, size_t end) {
+                if (channels == 4) for (size_t x = begin; x < end; x++) storePixel(background, out + x * 4);
+                else               std::fill(out + begin, out + end, fill);
+            };
+
+            parallelFor(columns * rows, [&](size_t index){
+
+                const size_t x0 = (index % columns) * tile, x1 = std::min(x0 + tile, destination.width);
+                const size_t y0 = (index / columns) * tile, y1 = std::min(y0 + tile, destination.height);
+
+                for (size_t y = y0; y < y1; y++) {
+
+                    T *out = destination.row(y);
+
+                    const double X0 = m[1] * double(y) + m[2];
+                    const double Y0 = m[4] * double(y) + m[5];
+                    const double W0 = m[7] * double(y) + m[8];
+
+                    //
+                    // Pixels in front of the projection and inside the source edges
+                    //
+                    double lo = double(x0), hi = double(x1) - 1.0;
+                    halfLine(W0 - 1e-12, m[6], lo, hi);
+                    halfLine(X0 + 0.5 * W0,         m[0] + 0.5 * m[6],         lo, hi);
+                    halfLine(maxX * W0 - X0,        maxX * m[6] - m[0],        lo, hi);
+                    halfLine(Y0 + 0.5 * W0,         m[3] + 0.5 * m[6],         lo, hi);
+                    halfLine(maxY * W0 - Y0,        maxY * m[6] - m[3],        lo, hi);
+
+                    if (!(lo <= hi)) {
+                        clear(out, x0, x1);
+                        continue;
+                    }
+
+                    const size_t begin = size_t(std::ceil(lo));
+                    const size_t end   = std::min(size_t(std::floor(hi)) + 1, x1);
+
+                    clear(out, x0, begin);
+                    clear(out, end, x1);
+
+                    //
+                    // |b w - a c| of each coordinate does not change along the row
+                    //
+                    const double K = std::max(std::fabs(m[0] * W0 - X0 * m[6]), std::fabs(m[3] * W0 - Y0 * m[6]));
+
+                    for (size_t x = begin; x < end;) {
+
+                        const size_t n = std::min(span, end - x);
+                        const double L = double(n - 1);
+
+                        double X = X0 + m[0] * double(x);
+                        double Y = Y0 + m[3] * double(x);
+                        double W = W0 + m[6] * double(x);
+
+                        const double Xe = X + m[0] * L, Ye = Y + m[3] * L, We = W + m[6] * L;
+                        const double w  = std::min(W, We);
+
+                        if (n > 2 && L * L * c * K <= tolerance * w * w * w) {
+
+                            const double sx = X / W, sy = Y / W;
+                            const double dx = (Xe / We - sx) / L, dy = (Ye / We - sy) / L;
+
+                            for (size_t i = 0; i < n; i++)
+                                put(out, x + i, float(sx + dx * double(i)), float(sy + dy * double(i)));
+                        }
+                        else {
+                            for (size_t i = 0; i < n; i++) {
+                                const double inverse = 1.0 / W;
+                                put(out, x + i, float(X * inverse), float(Y * inverse));
+                                X += m[0];
+                                Y += m[3];
+                                W += m[6];
+                            }
+                        }
+
+                        x += n;
+                    }
+                }
+            });
+        }
+
+        template<typename T> bool PerspectiveWarp::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.channels != destination.channels) return false;
+            if (source.channels != 1 && source.channels != 4) return false;
+
+            if (_options.filter == Filter::bicubic) warp(BicubicSampler<T>(source), destination);
+            else                                    warp(BilinearSampler<T>(source), destination);
+
+            return true;
+        }
+
+        bool PerspectiveWarp::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool PerspectiveWarp::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool PerspectiveWarp::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static PerspectiveWarp::Options warpOptions(const IMPPerspectiveWarpOptions &options) {
+    PerspectiveWarp::Options o;
+    o.filter    = options.filter == IMPPerspectiveWarpBicubic ? PerspectiveWarp::Filter::bicubic : PerspectiveWarp::Filter::bilinear;
+    o.span      = options.span;
+    o.tolerance = options.tolerance;
+    for (int c = 0; c < 4; c++) o.background[c] = options.background[c];
+    return o;
+}
+
+static bool applyWarp(const PerspectiveWarp &warp, const IMPCpuImage &source, const IMPCpuImage &destination) {
+
+    if (source.format != destination.format) return false;
+
+    bool done = false;
+
+    dispatch(destination, [&](auto target){
+        typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+        ImageView<const T> view(static_cast<const T*>(source.data),
+                                source.width, source.height, target.channels, source.bytesPerRow);
+        done = warp.apply(view, target);
+    });
+
+    return done;
+}
+
+extern "C" {
+
+    bool IMPPerspectiveWarpMatrix(IMPCpuImage source, IMPCpuImage destination, const float *matrix,
+                                  IMPPerspectiveWarpOptions options) {
+        if (!matrix) return false;
+        return applyWarp(PerspectiveWarp(matrix, warpOptions(options)), source, destination);
+    }
+
+    bool IMPPerspectiveWarpModel(IMPCpuImage source, IMPCpuImage destination, const float *model,
+                                 IMPPerspectiveWarpOptions options) {
+
+        float matrix[9];
+
+        if (!model || !PerspectiveWarp::matrix(model, source.width, source.height,
+                                               destination.width, destination.height, matrix)) return false;
+
+        return applyWarp(PerspectiveWarp(matrix, warpOptions(options)), source, destination);
+    }
+}
@@ -0,0 +1,97 @@
+//
+//  IMPPerspectiveWarp_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPPerspectiveWarp_cpu_hpp
+#define IMPPerspectiveWarp_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Homography warp, the CPU counterpart of vertex_warpTransformation: every destination pixel
+        /// samples the source at H (x, y, 1), the inverse map in pixels with the texel centres at
+        /// integers. Pixels mapping outside the source, or behind the projection, take the background.
+        ///
+        /// Along a row H (x, y, 1) changes by its first column, so the homogeneous point is stepped
+        /// by three adds. Rows are cut into spans: a span is interpolated linearly between its
+        /// exactly divided ends when the bound of the projective error over it, L^2 |c| K / 4 w^3
+        /// for the perspective term c, the row constant K and the least w, is within the tolerance,
+        /// otherwise every pixel is divided. The pixels mapping inside the source form one interval
+        /// of a row, found from the half planes of the source edges, the rest is filled without
+        /// sampling. Tiles of the destination are warped in parallel.
+        ///
+        class PerspectiveWarp {
+
+        public:
+
+            enum class Filter {
+                /// Bilinear, the baseSampler of the shaders
+                bilinear,
+                /// Catmull-Rom bicubic
+                bicubic
+            };
+
+            struct Options {
+                Filter filter    = Filter::bilinear;
+                /// Pixels interpolated between two divides, 1 divides every pixel
+                size_t span      = 16;
+                /// Largest position error of an interpolated span in source pixels
+                float  tolerance = 1.0f / 16.0f;
+                /// RGBA in [0, 1] of the pixel range outside the source
+                float  background[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                /// Side of the destination tiles
+                size_t tileSize  = 64;
+            };
+
+            ///
+            /// Row major 3 x 3 map of destination pixels to homogeneous source pixels
+            ///
+            PerspectiveWarp(const float matrix[9], const Options &options);
+
+            explicit PerspectiveWarp(const float matrix[9]): PerspectiveWarp(matrix, Options()) {}
+
+            ///
+            /// The pixel map of a vertex_warpTransformation model: the column major float4x4 moving
+            /// the full frame quad of the source, (-1, -1) - (1, 1) with the top at y = 1, in clip
+            /// space. Returns false if the model is singular on the plane.
+            ///
+            static bool matrix(const float model[16],
+                               size_t sourceWidth, size_t sourceHeight,
+                               size_t destinationWidth, size_t destinationHeight,
+                               float matrix[9]);
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Warp source into destination of any size, both have the same channels (1 or 4) and
+            /// must not overlap. Returns false if the layouts don't match.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            template<typename T, typename Sampler> void warp(const Sampler &sampler, const ImageView<T> &destination) const;
+
+            double  _matrix[9];
+            Options _options;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPPerspectiveWarp_cpu_hpp */
@@ -0,0 +1,312 @@
+//
+//  IMPProbabilisticHough_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPProbabilisticHough_cpu.hpp"
+#include "IMPProbabilisticHough-Bridging-CPU.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        namespace {
+
+            HoughSpace::Options spaceOptions(const ProbabilisticHough::Options &options) {
+                HoughSpace::Options o;
+                o.rhoStep   = options.rhoStep;
+                o.thetaStep = options.thetaStep;
+                return o;
+            }
+
+            //
+            // Edge map states: a pixel is off, on or on and voted
+            //
+            enum : uint8_t { off = 0, present = 1, voted = 2 };
+        }
+
+        ProbabilisticHough::ProbabilisticHough(size_t width, size_t height, const Options &options):
+        _options(options), _width(width), _height(height), _space(width, height, spaceOptions(options)) {}
+
+        template<typename T> bool ProbabilisticHough::run(const ImageView<const T> &edges, std::vector<Segment> &segments) const {
+
+            segments.clear();
+
+            if (edges.empty() || edges.width != _width || edges.height != _height) return false;
+
+            const size_t numangle = _space.numangle();
+            const size_t numrho   = _space.numrho();
+            const size_t stride   = numrho + 2;
+            const float  offset   = (float(numrho) - 1.0f) * 0.5f;
+            const long   last     = long(numrho);
+            const long   width    = long(_width);
+            const long   height   = long(_height);
+
+            const float *tabSin = _space.tabSin().data();
+            const float *tabCos = _space.tabCos().data();
+
+            std::vector<HoughSpace::Point> points;
+            HoughSpace::edges(edges, points);
+
+            std::vector<uint8_t> mask(_width * _height, off);
+            for (const auto &p: points) mask[size_t(p.y) * _width + size_t(p.x)] = present;
+
+            std::vector<uint32_t> accumulator(_space.size(), 0);
+
+            //
+            // Bins of IMPHoughSpace: round() then the offset and a truncation
+            //
+            auto bin = [&](size_t n, long x, long y) -> long {
+                const long r = long(std::round(float(x) * tabCos[n] + float(y) * tabSin[n]) + offset);
+                return r >= 0 && r < last ? long((n + 1) * stride) + r + 1 : -1;
+            };
+
+            auto unvote = [&](long x, long y){
+                for (size_t n = 0; n < numangle; n++) {
+                    const long b = bin(n, x, y);
+                    if (b >= 0) accumulator[size_t(b)]--;
+                }
+            };
+
+            const long   gap     = long(std::max(_options.maxLineGap, 0.0f));
+            const float  length  = _options.minLineLength;
+            const size_t samples = _options.samplesMax > 0 ? std::min(_options.samplesMax, points.size()) : points.size();
+
+            std::mt19937 random(_options.seed);
+
+            std::vector<std::array<long, 2>> path[2];
+
+            size_t remaining = points.size();
+
+            for (size_t sample = 0; sample < samples && remaining > 0; sample++) {
+
+                //
+                // Random pixel of the rest, its slot takes the last one
+                //
+                const size_t k = size_t(random() % remaining);
+                const long   x = long(points[k].x);
+                const long   y = long(points[k].y);
+
+                points[k] = points[--remaining];
+
+                uint8_t &state = mask[size_t(y) * _width + size_t(x)];
+
+                //
+                // Taken by a segment already
+                //
+                if (state == off) continue;
+
+                state = voted;
+
+                uint32_t votes = 0;
+                size_t   best  = 0;
+
+                for (size_t n = 0; n < numangle; n++) {
+                    const long b = bin(n, x, y);
+                    if (b < 0) continue;
+                    const uint32_t v = ++accumulator[size_t(b)];
+                    if (v > votes) { votes = v; best = n; }
+                }
+
+                if (votes < _options.threshold) continue;
+
+                //
+                // Walk the corridor along the line direction in 16.16 fixed point across the
+                // minor axis, one pixel a step along the major one. The walk centre is the line of
+                // the bin, the centre of its rho range, plus a drift: a pixel next to the centre
+                // across the minor axis re-centres it, so the walk follows a digital edge between
+                // the quantized angles, but the drift is bounded to half a rho bin and never adds
+                // up to another line or into the noise along the corridor. Pixels are taken one
+                // pixel around that band at most.
+                //
+                const int   shift = 16;
+                const long  one   = 1L << shift;
+                const float a = -tabSin[best], b = tabCos[best];
+
+                //
+                // Rho of the bin in units of rhoStep, tabs are scaled by 1/rhoStep
+                //
+                const float rho = std::round(float(x) * tabCos[best] + float(y) * tabSin[best]);
+
+                const bool xmajor = std::fabs(a) > std::fabs(b);
+
+                long  major0, dmajor, dminor;
+                float ideal, across;
+
+                if (xmajor) {
+                    major0 = x;
+                    dmajor = a > 0 ? 1 : -1;
+                    dminor = std::lround(b * float(one) / std::fabs(a));
+                    ideal  = (rho - float(x) * tabCos[best]) / tabSin[best];
+                    across = std::fabs(tabSin[best]);
+                }
+                else {
+                    major0 = y;
+                    dmajor = b > 0 ? 1 : -1;
+                    dminor = std::lround(a * float(one) / std::fabs(b));
+                    ideal  = (rho - float(y) * tabSin[best]) / tabCos[best];
+                    across = std::fabs(tabCos[best]);
+                }
+
+                //
+                // Minor coordinates are kept + 1/2 so the shift rounds them, the drift stays below
+                // half a bin so a centre on a pixel boundary does not round past it
+                //
+                const long minor0   = std::lround(ideal * float(one)) + one / 2;
+                const long maxDrift = std::lround(0.5f / across * float(one)) - 1;
+                const long drift0   = std::min(std::max(((xmajor ? y : x) << shift) + one / 2 - minor0, -maxDrift), maxDrift);
+
+                auto on = [&](long col, long row){
+                    return col >= 0 && col < width && row >= 0 && row < height && mask[size_t(row) * _width + size_t(col)] != off;
+                };
+
+                long ends[2][2] = { { x, y }, { x, y } };
+
+                for (int side = 0; side < 2; side++) {
+
+                    const long step  = side ? -dmajor : dmajor;
+                    const long slope = side ? -dminor : dminor;
+
+                    auto &steps = path[side];
+                    steps.clear();
+
+                    size_t used    = 0;
+                    long   missing = 0;
+                    long   drift   = drift0;
+
+                    for (long major = major0, minor = minor0;; major += step, minor += slope) {
+
+                        const long centre = (minor + drift) >> shift;
+
+                        long col = xmajor ? major : centre;
+                        long row = xmajor ? centre : major;
+
+                        if (col < 0 || col >= width || row < 0 || row >= height) break;
+
+                        long d = 2;
+
+                        for (long t: { 0L, -1L, 1L }) {
+                            const long distance = ((centre + t) << shift) + one / 2 - minor;
+                            if (std::labs(distance) > maxDrift + one) continue;
+                            if (on(xmajor ? col : col + t, xmajor ? row + t : row)) { d = t; break; }
+                        }
+
+                        if (d < 2) {
+                            if (xmajor) row += d;
+                            else        col += d;
+
+                            drift = std::min(std::max(drift + d * one, -maxDrift), maxDrift);
+
+                            steps.push_back({ col, row });
+                            used    = steps.size();
+                            missing = 0;
+
+                            ends[side][0] = col;
+                            ends[side][1] = row;
+                        }
+                        else {
+                            steps.push_back({ col, row });
+                            if (++missing > gap) break;
+                        }
+                    }
+
+                    steps.resize(used);
+                }
+
+                const bool good = std::labs(ends[1][0] - ends[0][0]) >= length ||
+                                  std::labs(ends[1][1] - ends[0][1]) >= length;
+
+                //
+                // The corridor pixels leave the map, voted ones take their votes back
+                //
+                for (int side = 0; side < 2; side++) {
+                    for (const auto &step: path[side]) {
+                        for (long d = -1; d <= 1; d++) {
+
+                            const long col = xmajor ? step[0] : step[0] + d;
+                            const long row = xmajor ? step[1] + d : step[1];
+
+                            if (!on(col, row)) continue;
+
+                            uint8_t &s = mask[size_t(row) * _width + size_t(col)];
+
+                            if (s == voted) unvote(col, row);
+                            s = off;
+                        }
+                    }
+                }
+
+                if (!good) continue;
+
+                segments.push_back(Segment{ float(ends[0][0]), float(ends[0][1]), float(ends[1][0]), float(ends[1][1]), votes });
+
+                if (_options.linesMax > 0 && segments.size() >= _options.linesMax) break;
+            }
+
+            return true;
+        }
+
+        bool ProbabilisticHough::segments(const ImageView<const uint8_t> &edges, std::vector<Segment> &segments) const {
+            return run(edges, segments);
+        }
+
+        bool ProbabilisticHough::segments(const ImageView<const uint16_t> &edges, std::vector<Segment> &segments) const {
+            return run(edges, segments);
+        }
+
+        bool ProbabilisticHough::segments(const ImageView<const float> &edges, std::vector<Segment> &segments) const {
+            return run(edges, segments);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    size_t IMPProbabilisticHoughSegments(IMPCpuImage edges, IMPCpuLineSegment *segments, size_t capacity,
+                                         IMPProbabilisticHoughOptions options) {
+
+        ProbabilisticHough::Options o;
+        o.rhoStep       = options.rhoStep;
+        o.thetaStep     = options.thetaStep;
+        o.threshold     = options.threshold;
+        o.minLineLength = options.minLineLength;
+        o.maxLineGap    = options.maxLineGap;
+        o.linesMax      = options.linesMax;
+        o.samplesMax    = options.samplesMax;
+        o.seed          = options.seed;
+
+        ProbabilisticHough hough(edges.width, edges.height, o);
+
+        std::vector<ProbabilisticHough::Segment> found;
+
+        dispatch(edges, [&](auto view){
+            hough.segments(view.readonly(), found);
+        });
+
+        const size_t count = std::min(capacity, found.size());
+
+        const float sx = edges.width  > 0 ? 1.0f / float(edges.width)  : 0.0f;
+        const float sy = edges.height > 0 ? 1.0f / float(edges.height) : 0.0f;
+
+        for (size_t i = 0; segments && i < count; i++) {
+            segments[i].p0[0] = found[i].x0 * sx;
+            segments[i].p0[1] = found[i].y0 * sy;
+            segments[i].p1[0] = found[i].x1 * sx;
+            segments[i].p1[1] = found[i].y1 * sy;
+            segments[i].votes = found[i].votes;
+        }
+
+        return found.size();
+    }
+}
@@ -0,0 +1,91 @@
+//
+//  IMPProbabilisticHough_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPProbabilisticHough_cpu_hpp
+#define IMPProbabilisticHough_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+#include "IMPHoughSpace_cpu.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Progressive probabilistic Hough transform (Matas et al.) returning segments. Edge pixels
+        /// are taken in random order and vote one at a time into an IMPHoughSpace accumulator. As
+        /// soon as a bin of the voting pixel reaches the threshold, the corridor of that line is
+        /// walked from the pixel both ways until a gap longer than maxLineGap: the ends are the
+        /// segment, the corridor pixels leave the edge map and their votes leave the accumulator.
+        ///
+        /// The accumulator stays sparse, so it stops after linesMax segments or samplesMax voting
+        /// pixels to bound the latency of dense edge maps. Voting is sequential by design, the
+        /// random order is seeded so the same edges give the same segments.
+        ///
+        class ProbabilisticHough {
+
+        public:
+
+            struct Options {
+                /// Distance resolution in pixels
+                float    rhoStep       = 1.0f;
+                /// Angle resolution in radians
+                float    thetaStep     = float(M_PI / 180.0);
+                /// Votes a line needs to be walked
+                uint32_t threshold     = 50;
+                /// Shorter segments are dropped, in pixels along x or y
+                float    minLineLength = 30.0f;
+                /// Longest run of missing pixels a segment may bridge
+                float    maxLineGap    = 10.0f;
+                /// Stop after so many segments, 0 does not stop
+                size_t   linesMax      = 100;
+                /// Stop after so many drawn edge pixels, 0 draws all of them
+                size_t   samplesMax    = 0;
+                /// Seed of the pixel order
+                uint32_t seed          = 0x2545F491;
+            };
+
+            ///
+            /// Segment ends in pixels and the votes of its line when it was found
+            ///
+            struct Segment {
+                float    x0, y0, x1, y1;
+                uint32_t votes;
+            };
+
+            ProbabilisticHough(size_t width, size_t height, const Options &options);
+
+            inline const Options &options() const { return _options; }
+
+            ///
+            /// Segments of the pixels whose first channel is at least half of the range, in the order
+            /// they are found, replaces the content of segments
+            ///
+            bool segments(const ImageView<const uint8_t>  &edges, std::vector<Segment> &segments) const;
+            bool segments(const ImageView<const uint16_t> &edges, std::vector<Segment> &segments) const;
+            bool segments(const ImageView<const float>    &edges, std::vector<Segment> &segments) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &edges, std::vector<Segment> &segments) const;
+
+            Options    _options;
+            size_t     _width, _height;
+            HoughSpace _space;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPProbabilisticHough_cpu_hpp */
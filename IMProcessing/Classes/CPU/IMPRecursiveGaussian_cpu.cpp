@@ -0,0 +1,384 @@
+//
+//  IMPRecursiveGaussian_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPRecursiveGaussian_cpu.hpp"
+#include "IMPRecursiveGaussian-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        typedef RecursiveGaussian::Coefficients Coefficients;
+
+        //
+        // Columns of the vertical pass handled by one strip, in floats
+        //
+        static const size_t verticalStrip = 256;
+
+        //
+        // Young - van Vliet poles m0 and m1 +- i m2 of the unit scale filter. The published polynomials
+        // in q round them differently per term, which leaves q^2 and q^3 residuals in the sum of the
+        // feedback coefficients and widens the response more and more as sigma grows, so the
+        // coefficients are expanded from the poles here.
+        //
+        static const double pole0 = 1.16680, pole1 = 1.10783, pole2 = 1.40586;
+
+        static void feedback(double q, double a[3]) {
+            const double mm = pole1 * pole1 + pole2 * pole2;
+            const double b0 = (pole0 + q) * (mm + 2.0 * pole1 * q + q * q);
+            a[0] = q * (2.0 * pole0 * pole1 + mm + (2.0 * pole0 + 4.0 * pole1) * q + 3.0 * q * q) / b0;
+            a[1] = -q * q * (pole0 + 2.0 * pole1 + 3.0 * q) / b0;
+            a[2] = q * q * q / b0;
+        }
+
+        //
+        // Variance of the causal pass followed by the anticausal one. The cumulants of b / (1 - sum a[k] z^-k)
+        // give the mean sum k a[k] / b and the variance sum k^2 a[k] / b + mean^2 of one pass, b = m0 (m1^2 + m2^2) / b0
+        // computed without the cancellation of 1 - sum a[k].
+        //
+        static double variance(double q) {
+            double a[3];
+            feedback(q, a);
+            const double mm = pole1 * pole1 + pole2 * pole2;
+            const double b  = pole0 * mm / ((pole0 + q) * (mm + 2.0 * pole1 * q + q * q));
+            const double mean = (a[0] + 2.0 * a[1] + 3.0 * a[2]) / b;
+            return 2.0 * ((a[0] + 4.0 * a[1] + 9.0 * a[2]) / b + mean * mean);
+        }
+
+        RecursiveGaussian::RecursiveGaussian(float sigma): _sigma(sigma) {
+
+            //
+            // The q(sigma) fit of Young - van Vliet leaves the standard deviation of the response 7 - 24% above
+            // sigma. The variance grows monotonically with q, so q is bisected until it matches sigma^2.
+            //
+            const double target = double(sigma) * double(sigma);
+
+            double q = 0.0;
+
+            if (sigma > 0) {
+                double low = 0.0, high = double(sigma) + 1.0;
+                for (int i = 0; i < 64; i++) {
+                    q = 0.5 * (low + high);
+                    if (variance(q) < target) low = q; else high = q;
+                }
+            }
+
+            feedback(q, _coefficients.a);
+            _coefficients.b = 1.0 - (_coefficients.a[0] + _coefficients.a[1] + _coefficients.a[2]);
+
+            const double  b = _coefficients.b;
+            const double *a = _coefficients.a;
+
+            //
+            // Triggs - Sdika: with the signal replicated past the right edge, the backward pass initial
+            // state is a linear function of the last three forward deviations from the edge value.
+            // Run the homogeneous continuation for every basis deviation until it vanishes.
+            //
+            size_t length = size_t(std::max(64.0, 50.0 * std::max(double(sigma), 0.0)));
+
+            std::vector<double> forward(length), backward(length + 3);
+
+            for (int k = 0; k < 3; k++) {
+
+                double w1 = k == 0, w2 = k == 1, w3 = k == 2;
+
+                for (size_t n = 0; n < length; n++) {
+                    double w = a[0] * w1 + a[1] * w2 + a[2] * w3;
+                    forward[n] = w;
+                    w3 = w2; w2 = w1; w1 = w;
+                }
+
+                std::fill(backward.begin(), backward.end(), 0.0);
+
+                for (size_t n = length; n-- > 0;) {
+                    backward[n] = b * forward[n] + a[0] * backward[n + 1] + a[1] * backward[n + 2] + a[2] * backward[n + 3];
+                }
+
+                for (int j = 0; j < 3; j++) _coefficients.m[j][k] = backward[j];
+            }
+        }
+
+        //
+        // Coefficients in the precision of the filter state. The gain is derived from the rounded
+        // feedback coefficients, so a constant signal passes through exactly.
+        //
+        template<typename S> struct Kernel {
+
+            S b, a0, a1, a2, m[3][3];
+
+            Kernel(const Coefficients &c):
+            a0(S(c.a[0])), a1(S(c.a[1])), a2(S(c.a[2])) {
+                b = S(1) - (a0 + a1 + a2);
+                for (int j = 0; j < 3; j++)
+                    for (int k = 0; k < 3; k++) m[j][k] = S(c.m[j][k]);
+            }
+
+            template<typename V> inline V edge(int j, V u, V d0, V d1, V d2) const {
+                return u + V(m[j][0]) * d0 + V(m[j][1]) * d1 + V(m[j][2]) * d2;
+            }
+        };
+
+        template<typename S> struct Lanes;
+        template<> struct Lanes<float>  { typedef Vec4f Type; };
+        template<> struct Lanes<double> { typedef Vec4d Type; };
+
+        //
+        // Causal and anticausal passes over `count` four lane elements: RGBA pixels or four packed rows.
+        //
+        template<typename S> static void filterLine(S *line, size_t count, const Kernel<S> &k) {
+
+            typedef typename Lanes<S>::Type V;
+
+            V b(k.b), a0(k.a0), a1(k.a1), a2(k.a2);
+
+            V first = V::load(line);
+            V last  = V::load(line + (count - 1) * 4);
+
+            V w1 = first, w2 = first, w3 = first;
+
+            for (size_t i = 0; i < count; i++) {
+                V w = madd(b, V::load(line + i * 4), madd(a0, w1, madd(a1, w2, a2 * w3)));
+                w.store(line + i * 4);
+                w3 = w2; w2 = w1; w1 = w;
+            }
+
+            V d0 = w1 - last, d1 = w2 - last, d2 = w3 - last;
+
+            V y1 = k.edge(0, last, d0, d1, d2);
+            V y2 = k.edge(1, last, d0, d1, d2);
+            V y3 = k.edge(2, last, d0, d1, d2);
+
+            for (size_t i = count; i-- > 0;) {
+                V y = madd(b, V::load(line + i * 4), madd(a0, y1, madd(a1, y2, a2 * y3)));
+                y.store(line + i * 4);
+                y3 = y2; y2 = y1; y1 = y;
+            }
+        }
+
+        //
+        // Horizontal pass: rows are independent, RGBA keeps a pixel in one vector,
+        // one channel planes pack four rows into the lanes.
+        //
+        template<typename S, typename T> static void horizontal(const ImageView<const T> &source,
+                                                                const ImageView<float> &destination,
+                                                                const Kernel<S> &k) {
+
+            size_t width  = source.width;
+            size_t height = source.height;
+
+            if (source.channels == 4) {
+                parallelStrips(height, 16, [&](size_t begin, size_t end){
+                    AlignedBuffer<S> line(width * 4);
+                    for (size_t y = begin; y < end; y++) {
+                        loadRow(source.row(y), line.data(), width * 4);
+                        filterLine(line.data(), width, k);
+                        float *out = destination.row(y);
+                        for (size_t i = 0; i < width * 4; i++) out[i] = float(line[i]);
+                    }
+                });
+                return;
+            }
+
+            size_t quads = (height + 3) / 4;
+
+            parallelStrips(quads, 4, [&](size_t begin, size_t end){
+                AlignedBuffer<S> line(width * 4);
+                AlignedBuffer<S> row(width);
+                for (size_t q = begin; q < end; q++) {
+
+                    size_t y0 = q * 4;
+
+                    for (size_t lane = 0; lane < 4; lane++) {
+                        size_t y = std::min(y0 + lane, height - 1);
+                        loadRow(source.row(y), row.data(), width);
+                        for (size_t x = 0; x < width; x++) line[x * 4 + lane] = row[x];
+                    }
+
+                    filterLine(line.data(), width, k);
+
+                    for (size_t lane = 0; lane < 4 && y0 + lane < height; lane++) {
+                        float *out = destination.row(y0 + lane);
+                        for (size_t x = 0; x < width; x++) out[x] = float(line[x * 4 + lane]);
+                    }
+                }
+            });
+        }
+
+        //
+        // Vertical pass in place: rows stream through, every column strip keeps its own
+        // filter states so the passes stay vectorized across columns.
+        //
+        template<typename S> static void vertical(const ImageView<float> &plane, const Kernel<S> &k) {
+
+            typedef typename Lanes<S>::Type V;
+
+            size_t elements = plane.rowElements();
+            size_t height   = plane.height;
+            size_t groups   = (elements + verticalStrip - 1) / verticalStrip;
+
+            V b(k.b), a0(k.a0), a1(k.a1), a2(k.a2);
+
+            parallelFor(groups, [&](size_t g){
+
+                size_t begin = g * verticalStrip;
+                size_t count = std::min(elements, begin + verticalStrip) - begin;
+                size_t vectorized = count & ~size_t(3);
+
+                S s1[verticalStrip], s2[verticalStrip], s3[verticalStrip], last[verticalStrip];
+
+                const float *top    = plane.row(0) + begin;
+                const float *bottom = plane.row(height - 1) + begin;
+
+                for (size_t i = 0; i < count; i++) {
+                    s1[i] = s2[i] = s3[i] = top[i];
+                    last[i] = bottom[i];
+                }
+
+                for (size_t y = 0; y < height; y++) {
+                    float *p = plane.row(y) + begin;
+                    size_t i = 0;
+                    for (; i < vectorized; i += 4) {
+                        V w1 = V::load(s1 + i), w2 = V::load(s2 + i), w3 = V::load(s3 + i);
+                        V w  = madd(b, V::load(p + i), madd(a0, w1, madd(a1, w2, a2 * w3)));
+                        w.store(p + i);
+                        w2.store(s3 + i); w1.store(s2 + i); w.store(s1 + i);
+                    }
+                    for (; i < count; i++) {
+                        S w = k.b * p[i] + k.a0 * s1[i] + k.a1 * s2[i] + k.a2 * s3[i];
+                        p[i] = float(w);
+                        s3[i] = s2[i]; s2[i] = s1[i]; s1[i] = w;
+                    }
+                }
+
+                for (size_t i = 0; i < count; i++) {
+                    S u  = last[i];
+                    S d0 = s1[i] - u, d1 = s2[i] - u, d2 = s3[i] - u;
+                    s1[i] = k.edge(0, u, d0, d1, d2);
+                    s2[i] = k.edge(1, u, d0, d1, d2);
+                    s3[i] = k.edge(2, u, d0, d1, d2);
+                }
+
+                for (size_t y = height; y-- > 0;) {
+                    float *p = plane.row(y) + begin;
+                    size_t i = 0;
+                    for (; i < vectorized; i += 4) {
+                        V y1 = V::load(s1 + i), y2 = V::load(s2 + i), y3 = V::load(s3 + i);
+                        V v  = madd(b, V::load(p + i), madd(a0, y1, madd(a1, y2, a2 * y3)));
+                        v.store(p + i);
+                        y2.store(s3 + i); y1.store(s2 + i); v.store(s1 + i);
+                    }
+                    for (; i < count; i++) {
+                        S v = k.b * p[i] + k.a0 * s1[i] + k.a1 * s2[i] + k.a2 * s3[i];
+                        p[i] = float(v);
+                        s3[i] = s2[i]; s2[i] = s1[i]; s1[i] = v;
+                    }
+                }
+            });
+        }
+
+        template<typename S, typename T> static void separable(const ImageView<const T> &source,
+                                                               const ImageView<float> &plane,
+                                                               const Coefficients &c) {
+            Kernel<S> k(c);
+            horizontal(source, plane, k);
+            vertical(plane, k);
+        }
+
+        template<typename T> static void separable(const ImageView<const T> &source,
+                                                   const ImageView<float> &plane,
+                                                   const Coefficients &c, float sigma) {
+            if (sigma > RecursiveGaussian::doublePrecisionSigma)
+                separable<double>(source, plane, c);
+            else
+                separable<float>(source, plane, c);
+        }
+
+        static inline ImageView<float> floatPlane(const ImageView<float> &view) { return view; }
+
+        template<typename T> static inline ImageView<float> floatPlane(const ImageView<T> &) { return ImageView<float>(); }
+
+        template<typename T> bool RecursiveGaussian::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+            if (source.channels != 1 && source.channels != 4) return false;
+
+            if (!(_sigma > 0)) {
+                if (static_cast<const void*>(source.data) != destination.data) {
+                    for (size_t y = 0; y < source.height; y++)
+                        std::copy(source.row(y), source.row(y) + source.rowElements(), destination.row(y));
+                }
+                return true;
+            }
+
+            //
+            // Float destination holds the intermediate plane itself, the horizontal pass
+            // buffers every row so it can run in place as well.
+            //
+            ImageView<float> plane = floatPlane(destination);
+
+            if (!plane.empty()) {
+                separable(source, plane, _coefficients, _sigma);
+                return true;
+            }
+
+            Image<float> buffer(source.width, source.height, source.channels);
+
+            separable(source, buffer.view(), _coefficients, _sigma);
+
+            parallelStrips(source.height, 16, [&](size_t begin, size_t end){
+                for (size_t y = begin; y < end; y++)
+                    storeRow(buffer.row(y), destination.row(y), destination.rowElements());
+            });
+
+            return true;
+        }
+
+        bool RecursiveGaussian::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool RecursiveGaussian::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool RecursiveGaussian::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPRecursiveGaussianBlur(IMPCpuImage source, IMPCpuImage destination, float sigma) {
+
+        if (source.format != destination.format) return false;
+
+        RecursiveGaussian gaussian(sigma);
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = gaussian.apply(view, target);
+        });
+
+        return done;
+    }
+}
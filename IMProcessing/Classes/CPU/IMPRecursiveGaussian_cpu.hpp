@@ -0,0 +1,70 @@
+//
+//  IMPRecursiveGaussian_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPRecursiveGaussian_cpu_hpp
+#define IMPRecursiveGaussian_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Young - van Vliet recursive gaussian, the poles of IMPMatlab/tests/iirGaussianKernelAsFIR.m with the scale
+        /// chosen so the impulse response has the standard deviation sigma. Its tails are heavier than a gaussian's,
+        /// so the best fitting gaussian is narrower: by 21% at sigma 1, 11% at 2 and 8% from 5 on. Every axis is a causal third order pass followed by an anticausal one, so the cost per pixel
+        /// does not depend on sigma. The left edge starts from the replicated first sample, the right edge
+        /// uses the Triggs - Sdika initialization so a constant border stays constant.
+        ///
+        class RecursiveGaussian {
+
+        public:
+
+            explicit RecursiveGaussian(float sigma);
+
+            ///
+            /// Forward pass w[n] = b*x[n] + a[0]*w[n-1] + a[1]*w[n-2] + a[2]*w[n-3], the backward pass mirrors it.
+            ///
+            struct Coefficients {
+                double b;
+                double a[3];
+                /// Triggs - Sdika right edge matrix
+                double m[3][3];
+            };
+
+            /// Above this sigma the feedback poles are too close to 1 for float states
+            static constexpr float doublePrecisionSigma = 16.0f;
+
+            inline float sigma() const { return _sigma; }
+
+            inline const Coefficients &coefficients() const { return _coefficients; }
+
+            ///
+            /// Blur source into destination, both must have the same size and channels (1 or 4).
+            /// Source and destination may be the same image. Returns false if the layouts don't match.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            float        _sigma;
+            Coefficients _coefficients;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPRecursiveGaussian_cpu_hpp */
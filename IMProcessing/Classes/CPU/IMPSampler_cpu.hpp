@@ -0,0 +1,227 @@
+//
+//  IMPSampler_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPSampler_cpu_hpp
+#define IMPSampler_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// RGBA texel in the scale of its storage type
+        ///
+        template<typename T> inline Vec4f texel(const T *p) {
+            return Vec4f(float(p[0]), float(p[1]), float(p[2]), float(p[3]));
+        }
+
+        template<> inline Vec4f texel<float>(const float *p) {
+            return Vec4f::load(p);
+        }
+
+#if IMP_CPU_SSE2
+        template<> inline Vec4f texel<uint8_t>(const uint8_t *p) {
+            int32_t word;
+            std::memcpy(&word, p, 4);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(word), zero), zero);
+            return _mm_cvtepi32_ps(v);
+        }
+#elif IMP_CPU_NEON
+        template<> inline Vec4f texel<uint8_t>(const uint8_t *p) {
+            uint32_t word;
+            std::memcpy(&word, p, 4);
+            const uint16x4_t v = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(word))));
+            return vcvtq_f32_u32(vmovl_u16(v));
+        }
+#endif
+
+        ///
+        /// Store an RGBA pixel with the rounding and saturation of PixelTraits
+        ///
+        template<typename T> inline void storePixel(const Vec4f &v, T *p) {
+            float t[4];
+            v.store(t);
+            for (int c = 0; c < 4; c++) p[c] = PixelTraits<T>::fromFloat(t[c]);
+        }
+
+        template<> inline void storePixel<float>(const Vec4f &v, float *p) {
+            v.store(p);
+        }
+
+#if IMP_CPU_SSE2
+        //
+        // Clamped, then +0.5 truncated as PixelTraits<uint8_t>::fromFloat
+        //
+        template<> inline void storePixel<uint8_t>(const Vec4f &v, uint8_t *p) {
+            const __m128  c = _mm_min_ps(_mm_max_ps(v.v, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+            const __m128i i = _mm_cvttps_epi32(_mm_add_ps(c, _mm_set1_ps(0.5f)));
+            const __m128i b = _mm_packus_epi16(_mm_packs_epi32(i, i), _mm_setzero_si128());
+            const int32_t word = _mm_cvtsi128_si32(b);
+            std::memcpy(p, &word, 4);
+        }
+#endif
+
+        ///
+        /// Bilinear sampling clamped to the edge, the baseSampler of the shaders. Coordinates are
+        /// in texels with the centre of pixel x at x, normalized u maps to u * width - 0.5.
+        ///
+        template<typename T> class BilinearSampler {
+
+        public:
+
+            explicit BilinearSampler(const ImageView<const T> &image): _image(image),
+            _lastX(long(image.width) - 1), _lastY(long(image.height) - 1) {}
+
+            inline const ImageView<const T> &image() const { return _image; }
+
+            /// RGBA pixel, the image has 4 channels
+            inline Vec4f rgba(float x, float y) const {
+
+                long x0, x1, y0, y1;
+                float fx, fy;
+                taps(x, _lastX, x0, x1, fx);
+                taps(y, _lastY, y0, y1, fy);
+
+                const T *r0 = _image.row(size_t(y0));
+                const T *r1 = _image.row(size_t(y1));
+
+                const Vec4f a = texel(r0 + x0 * 4), b = texel(r0 + x1 * 4);
+                const Vec4f c = texel(r1 + x0 * 4), d = texel(r1 + x1 * 4);
+
+                const Vec4f wx(fx), wy(fy);
+                const Vec4f top    = madd(wx, b - a, a);
+                const Vec4f bottom = madd(wx, d - c, c);
+
+                return madd(wy, bottom - top, top);
+            }
+
+            /// First channel of a one channel image
+            inline float gray(float x, float y) const {
+
+                long x0, x1, y0, y1;
+                float fx, fy;
+                taps(x, _lastX, x0, x1, fx);
+                taps(y, _lastY, y0, y1, fy);
+
+                const T *r0 = _image.row(size_t(y0));
+                const T *r1 = _image.row(size_t(y1));
+
+                const float top    = float(r0[x0]) + fx * (float(r0[x1]) - float(r0[x0]));
+                const float bottom = float(r1[x0]) + fx * (float(r1[x1]) - float(r1[x0]));
+
+                return top + fy * (bottom - top);
+            }
+
+        private:
+
+            //
+            // Far outside coordinates sample the edge as well, clamping them first, NaN too, keeps
+            // the conversion defined
+            //
+            static inline void taps(float t, long last, long &t0, long &t1, float &f) {
+                t = t > -1.0f ? std::min(t, float(last) + 1.0f) : -1.0f;
+                const float base = std::floor(t);
+                f  = t - base;
+                t0 = long(base);
+                t1 = std::min(std::max(t0 + 1, 0L), last);
+                t0 = std::min(std::max(t0, 0L), last);
+            }
+
+            ImageView<const T> _image;
+            long               _lastX, _lastY;
+        };
+
+        ///
+        /// Catmull-Rom bicubic sampling of 4 x 4 texels clamped to the edge, the coordinates of
+        /// BilinearSampler. Results may overshoot the range, integral stores saturate them.
+        ///
+        template<typename T> class BicubicSampler {
+
+        public:
+
+            explicit BicubicSampler(const ImageView<const T> &image): _image(image),
+            _lastX(long(image.width) - 1), _lastY(long(image.height) - 1) {}
+
+            inline const ImageView<const T> &image() const { return _image; }
+
+            /// RGBA pixel, the image has 4 channels
+            inline Vec4f rgba(float x, float y) const {
+
+                long  xs[4], ys[4];
+                float wx[4], wy[4];
+                taps(x, _lastX, xs, wx);
+                taps(y, _lastY, ys, wy);
+
+                Vec4f sum(0.0f);
+
+                for (int j = 0; j < 4; j++) {
+                    const T *row = _image.row(size_t(ys[j]));
+                    Vec4f line = Vec4f(wx[0]) * texel(row + xs[0] * 4);
+                    for (int i = 1; i < 4; i++) line = madd(Vec4f(wx[i]), texel(row + xs[i] * 4), line);
+                    sum = madd(Vec4f(wy[j]), line, sum);
+                }
+
+                return sum;
+            }
+
+            /// First channel of a one channel image
+            inline float gray(float x, float y) const {
+
+                long  xs[4], ys[4];
+                float wx[4], wy[4];
+                taps(x, _lastX, xs, wx);
+                taps(y, _lastY, ys, wy);
+
+                float sum = 0.0f;
+
+                for (int j = 0; j < 4; j++) {
+                    const T *row = _image.row(size_t(ys[j]));
+                    float line = 0.0f;
+                    for (int i = 0; i < 4; i++) line += wx[i] * float(row[xs[i]]);
+                    sum += wy[j] * line;
+                }
+
+                return sum;
+            }
+
+        private:
+
+            static inline void taps(float t, long last, long ts[4], float w[4]) {
+
+                t = t > -1.0f ? std::min(t, float(last) + 1.0f) : -1.0f;
+
+                const float base = std::floor(t);
+                const float f    = t - base;
+                const long  t1   = long(base);
+
+                w[0] = f * (-0.5f + f * (1.0f - 0.5f * f));
+                w[1] = 1.0f + f * f * (-2.5f + 1.5f * f);
+                w[2] = f * (0.5f + f * (2.0f - 1.5f * f));
+                w[3] = f * f * (-0.5f + 0.5f * f);
+
+                for (int i = 0; i < 4; i++) ts[i] = std::min(std::max(t1 - 1 + i, 0L), last);
+            }
+
+            ImageView<const T> _image;
+            long               _lastX, _lastY;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPSampler_cpu_hpp */
@@ -0,0 +1,311 @@
+//
+//  IMPSeparableConvolution_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPSeparableConvolution_cpu.hpp"
+#include "IMPSeparableConvolution-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        //
+        // Working set of one tile: transposed rows with the halo and the vertical result
+        //
+        static const size_t tileBytes = 256 * 1024;
+
+        static size_t tileSide(size_t channels, size_t radius) {
+            size_t side = 256;
+            while (side > 16 && side * (2 * side + 2 * radius) * channels * sizeof(float) > tileBytes) side /= 2;
+            return side;
+        }
+
+        struct Taps {
+
+            const float *k;
+            size_t       radius;
+            bool         symmetric;
+
+            Taps(const std::vector<float> &kernel): k(kernel.data()), radius(kernel.size() / 2), symmetric(true) {
+                for (size_t j = 1; j <= radius; j++)
+                    if (k[radius + j] != k[radius - j]) symmetric = false;
+            }
+        };
+
+#if IMP_CPU_AVX2_DISPATCH
+        //
+        // Eight outputs a step with fused multiply-add, returns the number of processed elements
+        //
+        IMP_CPU_TARGET_AVX2 static size_t convolveLineAVX2(const float *in, float *out, size_t count, size_t stride, const Taps &t) {
+
+            size_t i = 0;
+            ptrdiff_t r = ptrdiff_t(t.radius);
+
+            if (t.symmetric) {
+                for (; i + 8 <= count; i += 8) {
+                    const float *p = in + i;
+                    __m256 acc = _mm256_mul_ps(_mm256_set1_ps(t.k[r]), _mm256_loadu_ps(p));
+                    for (ptrdiff_t j = 1; j <= r; j++) {
+                        __m256 pair = _mm256_add_ps(_mm256_loadu_ps(p + j * ptrdiff_t(stride)),
+                                                    _mm256_loadu_ps(p - j * ptrdiff_t(stride)));
+                        acc = _mm256_fmadd_ps(_mm256_set1_ps(t.k[r + j]), pair, acc);
+                    }
+                    _mm256_storeu_ps(out + i, acc);
+                }
+            }
+            else {
+                for (; i + 8 <= count; i += 8) {
+                    const float *p = in + i;
+                    __m256 acc = _mm256_setzero_ps();
+                    for (ptrdiff_t j = -r; j <= r; j++) {
+                        acc = _mm256_fmadd_ps(_mm256_set1_ps(t.k[r + j]), _mm256_loadu_ps(p + j * ptrdiff_t(stride)), acc);
+                    }
+                    _mm256_storeu_ps(out + i, acc);
+                }
+            }
+
+            return i;
+        }
+#endif
+
+        //
+        // out[e] = sum k[j] * in[e + (j - radius) * stride], `in` has radius * stride valid elements on both sides
+        //
+        static void convolveLine(const float *in, float *out, size_t count, size_t stride, const Taps &t) {
+
+            size_t i = 0;
+            ptrdiff_t r = ptrdiff_t(t.radius);
+            ptrdiff_t s = ptrdiff_t(stride);
+
+#if IMP_CPU_AVX2_DISPATCH
+            if (hasAVX2()) i = convolveLineAVX2(in, out, count, stride, t);
+#endif
+
+            if (t.symmetric) {
+                Vec4f centre(t.k[r]);
+                for (; i + 4 <= count; i += 4) {
+                    const float *p = in + i;
+                    Vec4f acc = centre * Vec4f::load(p);
+                    for (ptrdiff_t j = 1; j <= r; j++)
+                        acc = madd(Vec4f(t.k[r + j]), Vec4f::load(p + j * s) + Vec4f::load(p - j * s), acc);
+                    acc.store(out + i);
+                }
+                for (; i < count; i++) {
+                    const float *p = in + i;
+                    float acc = t.k[r] * p[0];
+                    for (ptrdiff_t j = 1; j <= r; j++) acc += t.k[r + j] * (p[j * s] + p[-j * s]);
+                    out[i] = acc;
+                }
+            }
+            else {
+                for (; i + 4 <= count; i += 4) {
+                    const float *p = in + i;
+                    Vec4f acc(0.0f);
+                    for (ptrdiff_t j = -r; j <= r; j++)
+                        acc = madd(Vec4f(t.k[r + j]), Vec4f::load(p + j * s), acc);
+                    acc.store(out + i);
+                }
+                for (; i < count; i++) {
+                    const float *p = in + i;
+                    float acc = 0;
+                    for (ptrdiff_t j = -r; j <= r; j++) acc += t.k[r + j] * p[j * s];
+                    out[i] = acc;
+                }
+            }
+        }
+
+        void convolveLine(const float *in, float *out, size_t count, size_t stride, const std::vector<float> &kernel) {
+            convolveLine(in, out, count, stride, Taps(kernel));
+        }
+
+        SeparableConvolution::SeparableConvolution(const std::vector<float> &horizontal, const std::vector<float> &vertical):
+        _horizontal(horizontal), _vertical(vertical) {}
+
+        std::vector<float> SeparableConvolution::expand(const float *weights, const float *offsets, size_t count) {
+
+            if (count == 0) return std::vector<float>(1, 1.0f);
+
+            size_t radius = 0;
+            for (size_t i = 1; i < count; i++)
+                radius = std::max(radius, size_t(std::ceil(std::fabs(offsets[i]))));
+
+            std::vector<float> kernel(2 * radius + 1, 0.0f);
+
+            kernel[radius] = weights[0];
+
+            for (size_t i = 1; i < count; i++) {
+
+                float  offset = std::fabs(offsets[i]);
+                size_t near   = size_t(std::floor(offset));
+                float  far    = offset - float(near);
+                float  w      = weights[i];
+
+                kernel[radius + near] += w * (1 - far);
+                kernel[radius - near] += w * (1 - far);
+
+                if (far > 0) {
+                    kernel[radius + near + 1] += w * far;
+                    kernel[radius - near - 1] += w * far;
+                }
+            }
+
+            return kernel;
+        }
+
+        template<typename T> bool SeparableConvolution::run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (source.channels != destination.channels) return false;
+            if (_horizontal.size() % 2 == 0 || _vertical.size() % 2 == 0) return false;
+
+            //
+            // Tiles read their halo from the neighbours, so in place convolution needs a copy of the source
+            //
+            Image<T> copy;
+            ImageView<const T> input = source;
+
+            if (static_cast<const void*>(source.data) == destination.data) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                input = copy.view().readonly();
+            }
+
+            const Taps   kx(_horizontal), ky(_vertical);
+            const size_t rx = kx.radius, ry = ky.radius;
+
+            const size_t width    = input.width;
+            const size_t height   = input.height;
+            const size_t channels = input.channels;
+
+            const size_t side    = tileSide(channels, std::max(rx, ry));
+            const size_t columns = (width + side - 1) / side;
+            const size_t rows    = (height + side - 1) / side;
+
+            parallelStrips(columns * rows, 1, [&](size_t begin, size_t end){
+
+                AlignedBuffer<float> padded((side + 2 * rx) * channels);
+                AlignedBuffer<float> filtered(side * channels);
+                AlignedBuffer<float> transposed(side * (side + 2 * ry) * channels);
+                AlignedBuffer<float> column(side * channels);
+                AlignedBuffer<float> tile(side * side * channels);
+
+                for (size_t index = begin; index < end; index++) {
+
+                    size_t x0 = (index % columns) * side;
+                    size_t y0 = (index / columns) * side;
+                    size_t tw = std::min(side, width - x0);
+                    size_t th = std::min(side, height - y0);
+                    size_t tr = th + 2 * ry;
+
+                    //
+                    // Horizontal pass over the tile rows and the vertical halo, stored transposed
+                    //
+                    for (size_t r = 0; r < tr; r++) {
+
+                        long y = std::min(std::max(long(y0) + long(r) - long(ry), 0L), long(height) - 1);
+
+                        const T *src = input.row(size_t(y));
+
+                        for (size_t i = 0; i < tw + 2 * rx; i++) {
+                            long x = std::min(std::max(long(x0) + long(i) - long(rx), 0L), long(width) - 1);
+                            loadRow(src + size_t(x) * channels, padded.data() + i * channels, channels);
+                        }
+
+                        convolveLine(padded.data() + rx * channels, filtered.data(), tw * channels, channels, kx);
+
+                        for (size_t x = 0; x < tw; x++) {
+                            std::copy(filtered.data() + x * channels,
+                                      filtered.data() + (x + 1) * channels,
+                                      transposed.data() + (x * tr + r) * channels);
+                        }
+                    }
+
+                    //
+                    // Vertical pass along the transposed rows, transposed back into the tile
+                    //
+                    for (size_t x = 0; x < tw; x++) {
+
+                        convolveLine(transposed.data() + (x * tr + ry) * channels, column.data(), th * channels, channels, ky);
+
+                        for (size_t y = 0; y < th; y++) {
+                            std::copy(column.data() + y * channels,
+                                      column.data() + (y + 1) * channels,
+                                      tile.data() + (y * tw + x) * channels);
+                        }
+                    }
+
+                    for (size_t y = 0; y < th; y++)
+                        storeRow(tile.data() + y * tw * channels, destination.row(y0 + y) + x0 * channels, tw * channels);
+                }
+            });
+
+            return true;
+        }
+
+        bool SeparableConvolution::apply(const ImageView<const uint8_t> &source, const ImageView<uint8_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool SeparableConvolution::apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const {
+            return run(source, destination);
+        }
+
+        bool SeparableConvolution::apply(const ImageView<const float> &source, const ImageView<float> &destination) const {
+            return run(source, destination);
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+static bool applyConvolution(const SeparableConvolution &convolution, const IMPCpuImage &source, const IMPCpuImage &destination) {
+
+    if (source.format != destination.format) return false;
+
+    bool done = false;
+
+    dispatch(destination, [&](auto target){
+        typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+        ImageView<const T> view(static_cast<const T*>(source.data),
+                                source.width, source.height, target.channels, source.bytesPerRow);
+        done = convolution.apply(view, target);
+    });
+
+    return done;
+}
+
+extern "C" {
+
+    bool IMPSeparableConvolve(IMPCpuImage source, IMPCpuImage destination,
+                              const float *horizontal, uint32_t horizontalLength,
+                              const float *vertical, uint32_t verticalLength) {
+
+        if (!horizontal || !vertical || horizontalLength == 0 || verticalLength == 0) return false;
+
+        SeparableConvolution convolution(std::vector<float>(horizontal, horizontal + horizontalLength),
+                                         std::vector<float>(vertical, vertical + verticalLength));
+
+        return applyConvolution(convolution, source, destination);
+    }
+
+    bool IMPSampledSeparableConvolve(IMPCpuImage source, IMPCpuImage destination,
+                                     const float *weights, const float *offsets, uint32_t count) {
+
+        if (!weights || !offsets) return false;
+
+        std::vector<float> kernel = SeparableConvolution::expand(weights, offsets, count);
+
+        return applyConvolution(SeparableConvolution(kernel, kernel), source, destination);
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  IMPSeparableConvolution_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPSeparableConvolution_cpu_hpp
+#define IMPSeparableConvolution_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// One dimensional convolution of interleaved samples with an odd length kernel:
+        /// out[e] = sum kernel[j] * in[e + (j - radius) * stride], `in` must have radius * stride
+        /// valid elements on both sides.
+        ///
+        void convolveLine(const float *in, float *out, size_t count, size_t stride, const std::vector<float> &kernel);
+
+        ///
+        /// Separable convolution processed by tiles which fit in L2. Every tile convolves its rows
+        /// with a halo, transposes the result in the tile, so the vertical pass streams contiguous
+        /// memory as well, and transposes back on store. Edges are clamped like clamp_to_edge sampling.
+        ///
+        class SeparableConvolution {
+
+        public:
+
+            ///
+            /// Odd length kernels with the centre tap in the middle
+            ///
+            SeparableConvolution(const std::vector<float> &horizontal, const std::vector<float> &vertical);
+
+            ///
+            /// Symmetric kernel of linearly sampled taps, the layout kernel_gaussianSampledBlur reads:
+            /// weights[0] at the centre and weights[i] at +/- offsets[i]. Every fractional tap is split
+            /// back between its two neighbouring pixels, the result is the same as bilinear sampling.
+            ///
+            static std::vector<float> expand(const float *weights, const float *offsets, size_t count);
+
+            inline const std::vector<float> &horizontal() const { return _horizontal; }
+            inline const std::vector<float> &vertical()   const { return _vertical; }
+
+            ///
+            /// Convolve source into destination, both must have the same size and channels.
+            /// Source and destination may be the same image. Returns false if the layouts don't match
+            /// or a kernel length is even.
+            ///
+            bool apply(const ImageView<const uint8_t>  &source, const ImageView<uint8_t>  &destination) const;
+            bool apply(const ImageView<const uint16_t> &source, const ImageView<uint16_t> &destination) const;
+            bool apply(const ImageView<const float>    &source, const ImageView<float>    &destination) const;
+
+        private:
+
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const;
+
+            std::vector<float> _horizontal;
+            std::vector<float> _vertical;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPSeparableConvolution_cpu_hpp */
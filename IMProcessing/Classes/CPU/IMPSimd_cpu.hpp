@@ -0,0 +1,306 @@
+//
+//  IMPSimd_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPSimd_cpu_hpp
+#define IMPSimd_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define IMP_CPU_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define IMP_CPU_NEON 1
+#endif
+
+//
+// Wider x86_64 paths are compiled with per function target attributes and selected
+// at run time, the rest of the library keeps the SSE2 baseline.
+//
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#  include <immintrin.h>
+#  define IMP_CPU_AVX2_DISPATCH 1
+#  define IMP_CPU_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Four float lanes. SSE2 on x86_64 and NEON on arm64 are the baseline of every
+        /// platform we ship on, so no runtime dispatch is needed at this width.
+        ///
+        struct Vec4f {
+
+#if IMP_CPU_SSE2
+            __m128 v;
+            Vec4f() {}
+            Vec4f(__m128 v): v(v) {}
+            explicit Vec4f(float s): v(_mm_set1_ps(s)) {}
+            Vec4f(float x, float y, float z, float w): v(_mm_setr_ps(x, y, z, w)) {}
+
+            static inline Vec4f load(const float *p)  { return _mm_loadu_ps(p); }
+            inline void store(float *p) const         { _mm_storeu_ps(p, v); }
+
+            inline float operator[](int i) const { float t[4]; store(t); return t[i]; }
+
+            friend inline Vec4f operator+(Vec4f a, Vec4f b) { return _mm_add_ps(a.v, b.v); }
+            friend inline Vec4f operator-(Vec4f a, Vec4f b) { return _mm_sub_ps(a.v, b.v); }
+            friend inline Vec4f operator*(Vec4f a, Vec4f b) { return _mm_mul_ps(a.v, b.v); }
+            friend inline Vec4f operator/(Vec4f a, Vec4f b) { return _mm_div_ps(a.v, b.v); }
+            friend inline Vec4f min(Vec4f a, Vec4f b)       { return _mm_min_ps(a.v, b.v); }
+            friend inline Vec4f max(Vec4f a, Vec4f b)       { return _mm_max_ps(a.v, b.v); }
+            friend inline Vec4f sqrt(Vec4f a)               { return _mm_sqrt_ps(a.v); }
+#elif IMP_CPU_NEON
+            float32x4_t v;
+            Vec4f() {}
+            Vec4f(float32x4_t v): v(v) {}
+            explicit Vec4f(float s): v(vdupq_n_f32(s)) {}
+            Vec4f(float x, float y, float z, float w) { float t[4] = {x, y, z, w}; v = vld1q_f32(t); }
+
+            static inline Vec4f load(const float *p)  { return vld1q_f32(p); }
+            inline void store(float *p) const         { vst1q_f32(p, v); }
+
+            inline float operator[](int i) const { float t[4]; store(t); return t[i]; }
+
+            friend inline Vec4f operator+(Vec4f a, Vec4f b) { return vaddq_f32(a.v, b.v); }
+            friend inline Vec4f operator-(Vec4f a, Vec4f b) { return vsubq_f32(a.v, b.v); }
+            friend inline Vec4f operator*(Vec4f a, Vec4f b) { return vmulq_f32(a.v, b.v); }
+#  if defined(__aarch64__)
+            friend inline Vec4f operator/(Vec4f a, Vec4f b) { return vdivq_f32(a.v, b.v); }
+#  else
+            friend inline Vec4f operator/(Vec4f a, Vec4f b) {
+                float32x4_t r = vrecpeq_f32(b.v);
+                r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+                r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+                return vmulq_f32(a.v, r);
+            }
+#  endif
+            friend inline Vec4f min(Vec4f a, Vec4f b)       { return vminq_f32(a.v, b.v); }
+            friend inline Vec4f max(Vec4f a, Vec4f b)       { return vmaxq_f32(a.v, b.v); }
+#  if defined(__aarch64__)
+            friend inline Vec4f sqrt(Vec4f a)               { return vsqrtq_f32(a.v); }
+#  else
+            friend inline Vec4f sqrt(Vec4f a) {
+                float t[4]; a.store(t);
+                return Vec4f(std::sqrt(t[0]), std::sqrt(t[1]), std::sqrt(t[2]), std::sqrt(t[3]));
+            }
+#  endif
+#else
+            float v[4];
+            Vec4f() {}
+            explicit Vec4f(float s) { v[0] = v[1] = v[2] = v[3] = s; }
+            Vec4f(float x, float y, float z, float w) { v[0] = x; v[1] = y; v[2] = z; v[3] = w; }
+
+            static inline Vec4f load(const float *p)  { return Vec4f(p[0], p[1], p[2], p[3]); }
+            inline void store(float *p) const         { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+
+            inline float operator[](int i) const { return v[i]; }
+
+#  define IMP_VEC4F_OP(op) \
+            friend inline Vec4f operator op(Vec4f a, Vec4f b) { \
+                return Vec4f(a.v[0] op b.v[0], a.v[1] op b.v[1], a.v[2] op b.v[2], a.v[3] op b.v[3]); }
+            IMP_VEC4F_OP(+)
+            IMP_VEC4F_OP(-)
+            IMP_VEC4F_OP(*)
+            IMP_VEC4F_OP(/)
+#  undef IMP_VEC4F_OP
+            friend inline Vec4f min(Vec4f a, Vec4f b) {
+                return Vec4f(std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1]), std::min(a.v[2], b.v[2]), std::min(a.v[3], b.v[3]));
+            }
+            friend inline Vec4f max(Vec4f a, Vec4f b) {
+                return Vec4f(std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3]));
+            }
+            friend inline Vec4f sqrt(Vec4f a) {
+                return Vec4f(std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]));
+            }
+#endif
+            inline Vec4f &operator+=(Vec4f b) { *this = *this + b; return *this; }
+            inline Vec4f &operator-=(Vec4f b) { *this = *this - b; return *this; }
+            inline Vec4f &operator*=(Vec4f b) { *this = *this * b; return *this; }
+        };
+
+        /// a*b + c, fused where the instruction set has it
+        inline Vec4f madd(Vec4f a, Vec4f b, Vec4f c) {
+#if IMP_CPU_NEON && defined(__aarch64__)
+            return vfmaq_f32(c.v, a.v, b.v);
+#else
+            return a * b + c;
+#endif
+        }
+
+        inline Vec4f clamp(Vec4f x, Vec4f lo, Vec4f hi) { return min(max(x, lo), hi); }
+
+        ///
+        /// Four double lanes for recursions whose state does not fit float precision.
+        /// Plain arrays are enough here, the compilers vectorize them on both architectures.
+        ///
+        struct Vec4d {
+
+            double v[4];
+
+            Vec4d() {}
+            explicit Vec4d(double s) { v[0] = v[1] = v[2] = v[3] = s; }
+            Vec4d(double x, double y, double z, double w) { v[0] = x; v[1] = y; v[2] = z; v[3] = w; }
+
+            static inline Vec4d load(const double *p) { return Vec4d(p[0], p[1], p[2], p[3]); }
+            static inline Vec4d load(const float *p)  { return Vec4d(p[0], p[1], p[2], p[3]); }
+            inline void store(double *p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+            inline void store(float *p) const  { p[0] = float(v[0]); p[1] = float(v[1]); p[2] = float(v[2]); p[3] = float(v[3]); }
+
+            inline double operator[](int i) const { return v[i]; }
+
+#define IMP_VEC4D_OP(op) \
+            friend inline Vec4d operator op(Vec4d a, Vec4d b) { \
+                return Vec4d(a.v[0] op b.v[0], a.v[1] op b.v[1], a.v[2] op b.v[2], a.v[3] op b.v[3]); }
+            IMP_VEC4D_OP(+)
+            IMP_VEC4D_OP(-)
+            IMP_VEC4D_OP(*)
+            IMP_VEC4D_OP(/)
+#undef IMP_VEC4D_OP
+        };
+
+        inline Vec4d madd(Vec4d a, Vec4d b, Vec4d c) { return a * b + c; }
+
+        ///
+        /// Sixteen unsigned 8-bit lanes, min and max only: enough for rank filters of masks and RGBA8
+        ///
+        struct Vec16u8 {
+
+            static constexpr size_t lanes = 16;
+
+#if IMP_CPU_SSE2
+            __m128i v;
+            Vec16u8() {}
+            Vec16u8(__m128i v): v(v) {}
+            explicit Vec16u8(uint8_t s): v(_mm_set1_epi8(char(s))) {}
+
+            static inline Vec16u8 load(const uint8_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            inline void store(uint8_t *p) const         { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+            friend inline Vec16u8 min(Vec16u8 a, Vec16u8 b) { return _mm_min_epu8(a.v, b.v); }
+            friend inline Vec16u8 max(Vec16u8 a, Vec16u8 b) { return _mm_max_epu8(a.v, b.v); }
+#elif IMP_CPU_NEON
+            uint8x16_t v;
+            Vec16u8() {}
+            Vec16u8(uint8x16_t v): v(v) {}
+            explicit Vec16u8(uint8_t s): v(vdupq_n_u8(s)) {}
+
+            static inline Vec16u8 load(const uint8_t *p) { return vld1q_u8(p); }
+            inline void store(uint8_t *p) const         { vst1q_u8(p, v); }
+
+            friend inline Vec16u8 min(Vec16u8 a, Vec16u8 b) { return vminq_u8(a.v, b.v); }
+            friend inline Vec16u8 max(Vec16u8 a, Vec16u8 b) { return vmaxq_u8(a.v, b.v); }
+#else
+            uint8_t v[16];
+            Vec16u8() {}
+            explicit Vec16u8(uint8_t s) { std::fill(v, v + 16, s); }
+
+            static inline Vec16u8 load(const uint8_t *p) { Vec16u8 r; std::copy(p, p + 16, r.v); return r; }
+            inline void store(uint8_t *p) const         { std::copy(v, v + 16, p); }
+
+            friend inline Vec16u8 min(Vec16u8 a, Vec16u8 b) { for (int i = 0; i < 16; i++) a.v[i] = std::min(a.v[i], b.v[i]); return a; }
+            friend inline Vec16u8 max(Vec16u8 a, Vec16u8 b) { for (int i = 0; i < 16; i++) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+#endif
+        };
+
+        ///
+        /// Eight unsigned 16-bit lanes, min and max only. SSE2 has signed 16-bit min/max only,
+        /// the lanes are biased by 0x8000 around them.
+        ///
+        struct Vec8u16 {
+
+            static constexpr size_t lanes = 8;
+
+#if IMP_CPU_SSE2
+            __m128i v;
+            Vec8u16() {}
+            Vec8u16(__m128i v): v(v) {}
+            explicit Vec8u16(uint16_t s): v(_mm_set1_epi16(short(s))) {}
+
+            static inline Vec8u16 load(const uint16_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            inline void store(uint16_t *p) const         { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+#  if defined(__SSE4_1__)
+            friend inline Vec8u16 min(Vec8u16 a, Vec8u16 b) { return _mm_min_epu16(a.v, b.v); }
+            friend inline Vec8u16 max(Vec8u16 a, Vec8u16 b) { return _mm_max_epu16(a.v, b.v); }
+#  else
+            static inline __m128i bias() { return _mm_set1_epi16(short(0x8000)); }
+            friend inline Vec8u16 min(Vec8u16 a, Vec8u16 b) {
+                return _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(a.v, bias()), _mm_xor_si128(b.v, bias())), bias());
+            }
+            friend inline Vec8u16 max(Vec8u16 a, Vec8u16 b) {
+                return _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(a.v, bias()), _mm_xor_si128(b.v, bias())), bias());
+            }
+#  endif
+#elif IMP_CPU_NEON
+            uint16x8_t v;
+            Vec8u16() {}
+            Vec8u16(uint16x8_t v): v(v) {}
+            explicit Vec8u16(uint16_t s): v(vdupq_n_u16(s)) {}
+
+            static inline Vec8u16 load(const uint16_t *p) { return vld1q_u16(p); }
+            inline void store(uint16_t *p) const         { vst1q_u16(p, v); }
+
+            friend inline Vec8u16 min(Vec8u16 a, Vec8u16 b) { return vminq_u16(a.v, b.v); }
+            friend inline Vec8u16 max(Vec8u16 a, Vec8u16 b) { return vmaxq_u16(a.v, b.v); }
+#else
+            uint16_t v[8];
+            Vec8u16() {}
+            explicit Vec8u16(uint16_t s) { std::fill(v, v + 8, s); }
+
+            static inline Vec8u16 load(const uint16_t *p) { Vec8u16 r; std::copy(p, p + 8, r.v); return r; }
+            inline void store(uint16_t *p) const         { std::copy(v, v + 8, p); }
+
+            friend inline Vec8u16 min(Vec8u16 a, Vec8u16 b) { for (int i = 0; i < 8; i++) a.v[i] = std::min(a.v[i], b.v[i]); return a; }
+            friend inline Vec8u16 max(Vec8u16 a, Vec8u16 b) { for (int i = 0; i < 8; i++) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+#endif
+        };
+
+        ///
+        /// Scalar counterparts, so rank filters can be written once for samples and lanes
+        ///
+        inline uint8_t  min(uint8_t  a, uint8_t  b) { return a < b ? a : b; }
+        inline uint8_t  max(uint8_t  a, uint8_t  b) { return a < b ? b : a; }
+        inline uint16_t min(uint16_t a, uint16_t b) { return a < b ? a : b; }
+        inline uint16_t max(uint16_t a, uint16_t b) { return a < b ? b : a; }
+        inline float    min(float    a, float    b) { return a < b ? a : b; }
+        inline float    max(float    a, float    b) { return a < b ? b : a; }
+
+        ///
+        /// Widest min/max vector of a sample type
+        ///
+        template<typename T> struct RankLanes;
+        template<> struct RankLanes<uint8_t>  { typedef Vec16u8 type; static constexpr size_t count = 16; };
+        template<> struct RankLanes<uint16_t> { typedef Vec8u16 type; static constexpr size_t count = 8; };
+        template<> struct RankLanes<float>    { typedef Vec4f   type; static constexpr size_t count = 4; };
+
+        ///
+        /// True if AVX2 and FMA paths can run on this CPU
+        ///
+        inline bool hasAVX2() {
+#if IMP_CPU_AVX2_DISPATCH
+            static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+            return supported;
+#else
+            return false;
+#endif
+        }
+    }
+}
+
+#endif
+
+#endif /* IMPSimd_cpu_hpp */
@@ -0,0 +1,289 @@
+//
+//  IMPSobelGradient_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPSobelGradient_cpu.hpp"
+#include "IMPSobelGradient-Bridging-CPU.h"
+#include "IMPParallel_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        constexpr float SobelGradient::directionThreshold;
+
+        namespace {
+
+            //
+            // kIMP_Y_YCbCr_factor luma, IMProcessing::lum of the Kernel3x3Colors samples, normalized.
+            // The row goes to luma[1 ... width], luma[0] and luma[width+1] replicate the edges.
+            //
+            template<typename T> void lumaRow(const T *p, size_t width, size_t channels, float *luma) {
+
+                const float scale = 1.0f / PixelTraits<T>::maximum;
+
+                float *out = luma + 1;
+
+                if (channels < 3) {
+                    for (size_t x = 0; x < width; x++, p += channels) out[x] = float(p[0]) * scale;
+                }
+                else {
+                    const float r = 0.299f * scale, g = 0.587f * scale, b = 0.114f * scale;
+                    for (size_t x = 0; x < width; x++, p += channels)
+                        out[x] = r * float(p[0]) + g * float(p[1]) + b * float(p[2]);
+                }
+
+                luma[0]         = out[0];
+                luma[width + 1] = out[width - 1];
+            }
+
+            //
+            // -1, 0 or 1 the way the shader rounds a normalized gradient component, stored as 0, 0.5, 1
+            //
+            inline float direction(float g, float length) {
+                if (length <= 0.0f) return 0.5f;
+                float q = std::floor(std::fabs(g) / length + SobelGradient::directionThreshold);
+                return g < 0.0f ? 0.5f - 0.5f * q : 0.5f + 0.5f * q;
+            }
+
+            template<typename S> bool aliased(const ImageView<const S> &source, const void *data) {
+                return data && static_cast<const void*>(source.data) == data;
+            }
+
+            template<typename S> ImageView<const S> detached(const ImageView<const S> &source, Image<S> &copy) {
+                copy.resize(source.width, source.height, source.channels);
+                for (size_t y = 0; y < source.height; y++)
+                    std::copy(source.row(y), source.row(y) + source.rowElements(), copy.row(y));
+                return copy.view().readonly();
+            }
+        }
+
+        template<typename S, typename F> void SobelGradient::run(const ImageView<const S> &source, F &&emit) const {
+
+            const size_t width    = source.width;
+            const size_t height   = source.height;
+            const size_t channels = source.channels;
+            const size_t padded   = width + 2;
+
+            parallelStrips(height, 64, [&](size_t begin, size_t end){
+
+                AlignedBuffer<float> lumas(3 * padded);
+                AlignedBuffer<float> smooth(padded);
+                AlignedBuffer<float> difference(padded);
+                AlignedBuffer<float> gx(width), gy(width), magnitude(width);
+
+                //
+                // Rolling window: image row r lives in slot r % 3, the three rows a pixel needs are
+                // always consecutive, so they never share a slot
+                //
+                size_t loaded[3] = { size_t(-1), size_t(-1), size_t(-1) };
+
+                auto luma = [&](size_t r){
+                    float *slot = lumas.data() + (r % 3) * padded;
+                    if (loaded[r % 3] != r) {
+                        lumaRow(source.row(r), width, channels, slot);
+                        loaded[r % 3] = r;
+                    }
+                    return slot;
+                };
+
+                for (size_t y = begin; y < end; y++) {
+
+                    const float *up   = luma(y > 0 ? y - 1 : 0);
+                    const float *mid  = luma(y);
+                    const float *down = luma(std::min(y + 1, height - 1));
+
+                    //
+                    // Columns: [1 2 1] for Gx, top - bottom for Gy
+                    //
+                    float *s = smooth.data();
+                    float *d = difference.data();
+
+                    size_t i = 0;
+
+                    for (; i + 4 <= padded; i += 4) {
+                        Vec4f u = Vec4f::load(up + i), m = Vec4f::load(mid + i), b = Vec4f::load(down + i);
+                        madd(Vec4f(2.0f), m, u + b).store(s + i);
+                        (u - b).store(d + i);
+                    }
+                    for (; i < padded; i++) {
+                        s[i] = up[i] + 2.0f * mid[i] + down[i];
+                        d[i] = up[i] - down[i];
+                    }
+
+                    //
+                    // Rows: [-1 0 1] for Gx, [1 2 1] for Gy
+                    //
+                    float *ox = gx.data(), *oy = gy.data(), *om = magnitude.data();
+
+                    size_t x = 0;
+
+                    for (; x + 4 <= width; x += 4) {
+                        Vec4f h = Vec4f::load(s + x + 2) - Vec4f::load(s + x);
+                        Vec4f v = madd(Vec4f(2.0f), Vec4f::load(d + x + 1), Vec4f::load(d + x) + Vec4f::load(d + x + 2));
+                        h.store(ox + x);
+                        v.store(oy + x);
+                        sqrt(madd(h, h, v * v)).store(om + x);
+                    }
+                    for (; x < width; x++) {
+                        float h = s[x + 2] - s[x];
+                        float v = d[x] + 2.0f * d[x + 1] + d[x + 2];
+                        ox[x] = h;
+                        oy[x] = v;
+                        om[x] = std::sqrt(h * h + v * v);
+                    }
+
+                    emit(y, om, ox, oy);
+                }
+            });
+        }
+
+        template<typename S, typename D>
+        bool SobelGradient::apply(const ImageView<const S> &source, const ImageView<D> &magnitude, const ImageView<D> &direction) const {
+
+            if (source.empty()) return false;
+            if (magnitude.empty() && direction.empty()) return false;
+
+            if (!magnitude.empty() &&
+                (magnitude.width != source.width || magnitude.height != source.height || magnitude.channels != 1)) return false;
+
+            if (!direction.empty() &&
+                (direction.width != source.width || direction.height != source.height || direction.channels != 2)) return false;
+
+            Image<S> copy;
+            ImageView<const S> input = source;
+
+            if (aliased(source, magnitude.data) || aliased(source, direction.data)) input = detached(source, copy);
+
+            const float scale = PixelTraits<D>::maximum;
+
+            run(input, [&](size_t y, const float *m, const float *gx, const float *gy){
+
+                if (!magnitude.empty()) {
+                    D *out = magnitude.row(y);
+                    for (size_t x = 0; x < magnitude.width; x++) out[x] = PixelTraits<D>::fromFloat(m[x] * scale);
+                }
+
+                if (!direction.empty()) {
+                    D *out = direction.row(y);
+                    for (size_t x = 0; x < direction.width; x++, out += 2) {
+                        out[0] = PixelTraits<D>::fromFloat(cpu::direction(gx[x], m[x]) * scale);
+                        out[1] = PixelTraits<D>::fromFloat(cpu::direction(gy[x], m[x]) * scale);
+                    }
+                }
+            });
+
+            return true;
+        }
+
+        template<typename S, typename D>
+        bool SobelGradient::apply(const ImageView<const S> &source, const ImageView<D> &destination) const {
+
+            if (source.empty() || destination.empty()) return false;
+            if (source.width != destination.width || source.height != destination.height) return false;
+            if (destination.channels != 1 && destination.channels != 4) return false;
+
+            Image<S> copy;
+            ImageView<const S> input = source;
+
+            if (aliased(source, destination.data)) input = detached(source, copy);
+
+            const float  scale    = PixelTraits<D>::maximum;
+            const D      one      = PixelTraits<D>::fromFloat(scale);
+            const size_t channels = destination.channels;
+
+            run(input, [&](size_t y, const float *m, const float *gx, const float *gy){
+
+                D *out = destination.row(y);
+
+                if (channels == 1) {
+                    for (size_t x = 0; x < destination.width; x++) out[x] = PixelTraits<D>::fromFloat(m[x] * scale);
+                    return;
+                }
+
+                for (size_t x = 0; x < destination.width; x++, out += 4) {
+                    out[0] = PixelTraits<D>::fromFloat(m[x] * scale);
+                    out[1] = PixelTraits<D>::fromFloat(direction(gx[x], m[x]) * scale);
+                    out[2] = PixelTraits<D>::fromFloat(direction(gy[x], m[x]) * scale);
+                    out[3] = one;
+                }
+            });
+
+            return true;
+        }
+
+        template<typename S>
+        bool SobelGradient::components(const ImageView<const S> &source, const ImageView<float> &gradient) const {
+
+            if (source.empty() || gradient.empty()) return false;
+            if (source.width != gradient.width || source.height != gradient.height || gradient.channels != 2) return false;
+
+            Image<S> copy;
+            ImageView<const S> input = source;
+
+            if (aliased(source, gradient.data)) input = detached(source, copy);
+
+            //
+            // Gy of the run is the row above minus the row below
+            //
+            run(input, [&](size_t y, const float *, const float *gx, const float *gy){
+                float *out = gradient.row(y);
+                for (size_t x = 0; x < gradient.width; x++, out += 2) {
+                    out[0] = gx[x];
+                    out[1] = -gy[x];
+                }
+            });
+
+            return true;
+        }
+
+        template bool SobelGradient::components<uint8_t>(const ImageView<const uint8_t>&, const ImageView<float>&) const;
+        template bool SobelGradient::components<uint16_t>(const ImageView<const uint16_t>&, const ImageView<float>&) const;
+        template bool SobelGradient::components<float>(const ImageView<const float>&, const ImageView<float>&) const;
+
+#define IMP_SOBEL_GRADIENT_APPLY(S, D) \
+        template bool SobelGradient::apply<S, D>(const ImageView<const S>&, const ImageView<D>&, const ImageView<D>&) const; \
+        template bool SobelGradient::apply<S, D>(const ImageView<const S>&, const ImageView<D>&) const;
+
+        IMP_SOBEL_GRADIENT_APPLY(uint8_t,  uint8_t)
+        IMP_SOBEL_GRADIENT_APPLY(uint8_t,  uint16_t)
+        IMP_SOBEL_GRADIENT_APPLY(uint8_t,  float)
+        IMP_SOBEL_GRADIENT_APPLY(uint16_t, uint8_t)
+        IMP_SOBEL_GRADIENT_APPLY(uint16_t, uint16_t)
+        IMP_SOBEL_GRADIENT_APPLY(uint16_t, float)
+        IMP_SOBEL_GRADIENT_APPLY(float,    uint8_t)
+        IMP_SOBEL_GRADIENT_APPLY(float,    uint16_t)
+        IMP_SOBEL_GRADIENT_APPLY(float,    float)
+
+#undef IMP_SOBEL_GRADIENT_APPLY
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPSobelGradient(IMPCpuImage source, IMPCpuImage destination) {
+
+        SobelGradient sobel;
+
+        bool done = false;
+
+        dispatch(source, [&](auto input){
+            dispatch(destination, [&](auto target){
+                done = sobel.apply(input.readonly(), target);
+            });
+        });
+
+        return done;
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  IMPSobelGradient_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPSobelGradient_cpu_hpp
+#define IMPSobelGradient_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Sobel gradient of luma with the kernel_directionalSobelEdge output: gradient length and
+        /// the direction quantized to 8 neighbours. Luma is converted once per source row into a
+        /// 3 row rolling window, Gx and Gy are the separable [1 2 1] x [-1 0 1] forms of
+        /// IMPSobelEdges.Gx/Gy. Bands of rows run in parallel, edges are replicated.
+        ///
+        /// Luma is normalized to 0 - 1 whatever the source type is, so the gradient is the one the
+        /// shader writes and 8/16-bit outputs saturate the way a unorm texture does.
+        ///
+        class SobelGradient {
+
+        public:
+
+            ///
+            /// Direction components are -1, 0 or 1 (0 when the gradient is within 22.5 degrees of the
+            /// other axis) stored as 0, 0.5 and 1. A zero gradient has no direction: 0.5, 0.5.
+            ///
+            static constexpr float directionThreshold = 0.617316f;
+
+            ///
+            /// One pass into planes of any storage type. magnitude has 1 channel, direction has 2
+            /// (x, y), either of them may be empty. Outputs must have the source size.
+            ///
+            template<typename S, typename D>
+            bool apply(const ImageView<const S> &source, const ImageView<D> &magnitude, const ImageView<D> &direction) const;
+
+            ///
+            /// kernel_directionalSobelEdge layout: 4 channels of magnitude, direction x, direction y
+            /// and 1, or a 1 channel magnitude. Source and destination may be the same image.
+            ///
+            template<typename S, typename D>
+            bool apply(const ImageView<const S> &source, const ImageView<D> &destination) const;
+
+            ///
+            /// Unquantized gradient of the luma into a 2 channel plane of the source size: Gx and
+            /// the derivative down the rows, so atan2 of them is the angle of the edge normal in
+            /// pixel coordinates.
+            ///
+            template<typename S>
+            bool components(const ImageView<const S> &source, const ImageView<float> &gradient) const;
+
+        private:
+
+            template<typename S, typename F> void run(const ImageView<const S> &source, F &&row) const;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPSobelGradient_cpu_hpp */
@@ -0,0 +1,229 @@
+//
+//  IMPStripStages_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPStripStages_cpu.hpp"
+#include "IMPStripStream-Bridging-CPU.h"
+#include "IMPSeparableConvolution_cpu.hpp"
+#include "IMPMedian_cpu.hpp"
+#include "IMPSimd_cpu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        std::vector<float> gaussianKernel(float sigma) {
+
+            if (!(sigma > 0)) return std::vector<float>(1, 1.0f);
+
+            size_t radius = size_t(std::ceil(3.0f * sigma));
+
+            std::vector<float> kernel(2 * radius + 1);
+
+            double sum = 0;
+            for (size_t i = 0; i < kernel.size(); i++) {
+                double x = double(i) - double(radius);
+                kernel[i] = float(std::exp(-0.5 * x * x / (double(sigma) * double(sigma))));
+                sum += kernel[i];
+            }
+
+            for (auto &k: kernel) k = float(k / sum);
+
+            return kernel;
+        }
+
+        void addGaussianBlur(StripStream &stream, float sigma) {
+            std::vector<float> kernel = gaussianKernel(sigma);
+            stream.add(std::make_shared<HorizontalConvolutionStage>(kernel));
+            stream.add(std::make_shared<VerticalConvolutionStage>(kernel));
+        }
+
+        void addMorphology(StripStream &stream, RankStage::Operation operation, size_t radius) {
+            stream.add(std::make_shared<RankStage>(operation, RankStage::horizontal, radius));
+            stream.add(std::make_shared<RankStage>(operation, RankStage::vertical, radius));
+        }
+
+        //
+        // Copy a row into a buffer with `radius` clamped pixels on both sides
+        //
+        static void padRow(const float *row, float *padded, size_t width, size_t channels, size_t radius) {
+
+            std::copy(row, row + width * channels, padded + radius * channels);
+
+            for (size_t i = 0; i < radius; i++) {
+                std::copy(row, row + channels, padded + i * channels);
+                std::copy(row + (width - 1) * channels, row + width * channels, padded + (radius + width + i) * channels);
+            }
+        }
+
+        void HorizontalConvolutionStage::process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const {
+
+            size_t width    = input.width();
+            size_t channels = input.channels();
+            size_t radius   = _kernel.size() / 2;
+
+            AlignedBuffer<float> padded((width + 2 * radius) * channels);
+
+            for (size_t y = begin; y < end; y++) {
+                padRow(input.row(long(y)), padded.data(), width, channels, radius);
+                convolveLine(padded.data() + radius * channels, output.row(long(y)), width * channels, channels, _kernel);
+            }
+        }
+
+        void VerticalConvolutionStage::process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const {
+
+            size_t elements   = input.rowElements();
+            size_t vectorized = elements & ~size_t(3);
+            long   radius     = long(_kernel.size() / 2);
+
+            for (size_t y = begin; y < end; y++) {
+
+                float *out = output.row(long(y));
+
+                for (size_t i = 0; i < vectorized; i += 4) {
+                    Vec4f acc(0.0f);
+                    for (long j = -radius; j <= radius; j++)
+                        acc = madd(Vec4f(_kernel[size_t(j + radius)]), Vec4f::load(input.row(long(y) + j) + i), acc);
+                    acc.store(out + i);
+                }
+
+                for (size_t i = vectorized; i < elements; i++) {
+                    float acc = 0;
+                    for (long j = -radius; j <= radius; j++)
+                        acc += _kernel[size_t(j + radius)] * input.row(long(y) + j)[i];
+                    out[i] = acc;
+                }
+            }
+        }
+
+        void SobelStage::process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const {
+
+            size_t width    = input.width();
+            size_t channels = input.channels();
+
+            for (size_t y = begin; y < end; y++) {
+
+                const float *r0 = input.row(long(y) - 1);
+                const float *r1 = input.row(long(y));
+                const float *r2 = input.row(long(y) + 1);
+
+                float *out = output.row(long(y));
+
+                for (size_t x = 0; x < width; x++) {
+
+                    size_t l = (x > 0 ? x - 1 : 0) * channels;
+                    size_t c = x * channels;
+                    size_t r = (x + 1 < width ? x + 1 : x) * channels;
+
+                    for (size_t k = 0; k < channels; k++) {
+                        float gx = (r0[r + k] + 2 * r1[r + k] + r2[r + k]) - (r0[l + k] + 2 * r1[l + k] + r2[l + k]);
+                        float gy = (r2[l + k] + 2 * r2[c + k] + r2[r + k]) - (r0[l + k] + 2 * r0[c + k] + r0[r + k]);
+                        out[c + k] = std::sqrt(gx * gx + gy * gy);
+                    }
+                }
+            }
+        }
+
+        void Median3x3Stage::process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const {
+
+            AlignedBuffer<float> scratch(3 * input.rowElements());
+
+            for (size_t y = begin; y < end; y++) {
+                const float *const rows[3] = { input.row(long(y) - 1), input.row(long(y)), input.row(long(y) + 1) };
+                median3x3Row(rows, output.row(long(y)), input.width(), input.channels(), scratch.data());
+            }
+        }
+
+        void RankStage::process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const {
+
+            size_t width    = input.width();
+            size_t channels = input.channels();
+            size_t elements = input.rowElements();
+            bool   minimum  = _operation == erode;
+
+            if (_direction == vertical) {
+                long radius = long(_radius);
+                for (size_t y = begin; y < end; y++) {
+                    float *out = output.row(long(y));
+                    std::copy(input.row(long(y) - radius), input.row(long(y) - radius) + elements, out);
+                    for (long j = -radius + 1; j <= radius; j++) {
+                        const float *p = input.row(long(y) + j);
+                        if (minimum) for (size_t i = 0; i < elements; i++) out[i] = std::min(out[i], p[i]);
+                        else         for (size_t i = 0; i < elements; i++) out[i] = std::max(out[i], p[i]);
+                    }
+                }
+                return;
+            }
+
+            AlignedBuffer<float> padded((width + 2 * _radius) * channels);
+
+            for (size_t y = begin; y < end; y++) {
+
+                padRow(input.row(long(y)), padded.data(), width, channels, _radius);
+
+                float *out = output.row(long(y));
+
+                std::copy(padded.data(), padded.data() + elements, out);
+
+                for (size_t j = 1; j <= 2 * _radius; j++) {
+                    const float *p = padded.data() + j * channels;
+                    if (minimum) for (size_t i = 0; i < elements; i++) out[i] = std::min(out[i], p[i]);
+                    else         for (size_t i = 0; i < elements; i++) out[i] = std::max(out[i], p[i]);
+                }
+            }
+        }
+    }
+}
+
+using namespace IMProcessing::cpu;
+
+extern "C" {
+
+    bool IMPStripStreamRun(IMPCpuImage source, IMPCpuImage destination,
+                           const IMPStripStage *stages, uint32_t count, uint32_t band) {
+
+        if (source.format != destination.format || (count > 0 && !stages)) return false;
+
+        StripStream stream(band > 0 ? band : 64);
+
+        for (uint32_t i = 0; i < count; i++) {
+            switch (stages[i].type) {
+                case IMPStripStageGaussianBlur:
+                    addGaussianBlur(stream, stages[i].radius);
+                    break;
+                case IMPStripStageSobel:
+                    stream.add(std::make_shared<SobelStage>());
+                    break;
+                case IMPStripStageMedian3x3:
+                    stream.add(std::make_shared<Median3x3Stage>());
+                    break;
+                case IMPStripStageErode:
+                    addMorphology(stream, RankStage::erode, size_t(std::max(stages[i].radius, 0.0f)));
+                    break;
+                case IMPStripStageDilate:
+                    addMorphology(stream, RankStage::dilate, size_t(std::max(stages[i].radius, 0.0f)));
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        bool done = false;
+
+        dispatch(destination, [&](auto target){
+            typedef typename std::remove_const<typename std::remove_pointer<decltype(target.data)>::type>::type T;
+            ImageView<const T> view(static_cast<const T*>(source.data),
+                                    source.width, source.height, target.channels, source.bytesPerRow);
+            done = stream.run(view, target);
+        });
+
+        return done;
+    }
+}
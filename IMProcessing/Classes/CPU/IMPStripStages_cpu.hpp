@@ -0,0 +1,96 @@
+//
+//  IMPStripStages_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPStripStages_cpu_hpp
+#define IMPStripStages_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPStripStream_cpu.hpp"
+
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Horizontal pass of a separable convolution, odd kernel length
+        ///
+        class HorizontalConvolutionStage: public StripStage {
+        public:
+            explicit HorizontalConvolutionStage(const std::vector<float> &kernel): _kernel(kernel) {}
+            size_t halo() const override { return 0; }
+            void process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const override;
+        private:
+            std::vector<float> _kernel;
+        };
+
+        ///
+        /// Vertical pass of a separable convolution, odd kernel length
+        ///
+        class VerticalConvolutionStage: public StripStage {
+        public:
+            explicit VerticalConvolutionStage(const std::vector<float> &kernel): _kernel(kernel) {}
+            size_t halo() const override { return _kernel.size() / 2; }
+            void process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const override;
+        private:
+            std::vector<float> _kernel;
+        };
+
+        ///
+        /// Sobel gradient magnitude of every channel
+        ///
+        class SobelStage: public StripStage {
+        public:
+            size_t halo() const override { return 1; }
+            void process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const override;
+        };
+
+        ///
+        /// 3x3 median of every channel
+        ///
+        class Median3x3Stage: public StripStage {
+        public:
+            size_t halo() const override { return 1; }
+            void process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const override;
+        };
+
+        ///
+        /// Minimum (erosion) or maximum (dilation) over a horizontal or vertical segment of 2*radius+1 samples
+        ///
+        class RankStage: public StripStage {
+        public:
+            enum Operation { erode, dilate };
+            enum Direction { horizontal, vertical };
+            RankStage(Operation operation, Direction direction, size_t radius):
+            _operation(operation), _direction(direction), _radius(radius) {}
+            size_t halo() const override { return _direction == vertical ? _radius : 0; }
+            void process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const override;
+        private:
+            Operation _operation;
+            Direction _direction;
+            size_t    _radius;
+        };
+
+        ///
+        /// Normalized gaussian kernel of radius ceil(3 * sigma)
+        ///
+        std::vector<float> gaussianKernel(float sigma);
+
+        /// Gaussian blur as two streamed stages
+        void addGaussianBlur(StripStream &stream, float sigma);
+
+        /// Square structuring element of (2*radius+1) x (2*radius+1) as two streamed stages
+        void addMorphology(StripStream &stream, RankStage::Operation operation, size_t radius);
+    }
+}
+
+#endif
+
+#endif /* IMPStripStages_cpu_hpp */
@@ -0,0 +1,126 @@
+//
+//  IMPStripStream_cpu.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#include "IMPStripStream_cpu.hpp"
+#include "IMPParallel_cpu.hpp"
+
+#include <algorithm>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        void StripRows::resize(size_t width, size_t height, size_t channels, size_t capacity) {
+
+            _width    = width;
+            _height   = height;
+            _channels = channels;
+            _capacity = std::max<size_t>(1, std::min(capacity, height));
+
+            //
+            // Rows start on 64 byte boundaries
+            //
+            _stride = (width * channels + 15) / 16 * 16;
+
+            _buffer.resize(_stride * _capacity);
+            _data = _buffer.data();
+        }
+
+        StripStream::StripStream(size_t band): _band(std::max<size_t>(band, 1)) {}
+
+        StripStream &StripStream::add(const std::shared_ptr<StripStage> &stage) {
+            if (stage) _stages.push_back(stage);
+            return *this;
+        }
+
+        //
+        // A ring feeding a stage with halo h keeps band + 2h rows: from the oldest row the stage
+        // still reads to the newest one produced for the band. The first band runs ahead by the
+        // halos of all the later stages, so the ring also covers them.
+        //
+        size_t StripStream::capacity(size_t index) const {
+
+            if (index == _stages.size()) return _band;
+
+            size_t halo  = _stages[index]->halo();
+            size_t ahead = 0;
+
+            for (size_t k = index + 1; k < _stages.size(); k++) ahead += _stages[k]->halo();
+
+            return _band + halo + std::max(halo, ahead);
+        }
+
+        size_t StripStream::outputChannels(size_t channels) const {
+            for (auto &stage: _stages) channels = stage->outputChannels(channels);
+            return channels;
+        }
+
+        size_t StripStream::peakBytes(size_t width, size_t channels) const {
+
+            size_t bytes = 0;
+
+            for (size_t k = 0; k <= _stages.size(); k++) {
+                bytes += width * channels * sizeof(float) * capacity(k);
+                if (k < _stages.size()) channels = _stages[k]->outputChannels(channels);
+            }
+
+            return bytes;
+        }
+
+        void StripStream::run(size_t width, size_t height, size_t channels, const Reader &reader, const Writer &writer) const {
+
+            if (width == 0 || height == 0) return;
+
+            size_t count = _stages.size();
+
+            //
+            // rings[0] holds source rows, rings[k + 1] the output of stage k
+            //
+            std::vector<StripRows> rings(count + 1);
+            std::vector<size_t>    produced(count + 1, 0);
+            std::vector<size_t>    needed(count + 1, 0);
+
+            for (size_t k = 0; k <= count; k++) {
+                rings[k].resize(width, height, channels, capacity(k));
+                if (k < count) channels = _stages[k]->outputChannels(channels);
+            }
+
+            for (size_t y = 0; y < height; ) {
+
+                size_t end = std::min(height, y + _band);
+
+                needed[count] = end;
+                for (size_t k = count; k-- > 0;)
+                    needed[k] = std::min(height, needed[k + 1] + _stages[k]->halo());
+
+                for (size_t r = produced[0]; r < needed[0]; r++) reader(r, rings[0].row(long(r)));
+                produced[0] = needed[0];
+
+                for (size_t k = 0; k < count; k++) {
+
+                    size_t begin = produced[k + 1];
+                    size_t rows  = needed[k + 1] - begin;
+
+                    const StripStage &stage  = *_stages[k];
+                    const StripRows  &input  = rings[k];
+                    const StripRows  &output = rings[k + 1];
+
+                    parallelStrips(rows, 4, [&](size_t b, size_t e){
+                        stage.process(input, begin + b, begin + e, output);
+                    });
+
+                    produced[k + 1] = needed[k + 1];
+                }
+
+                for (size_t r = y; r < end; r++) writer(r, rings[count].row(long(r)));
+
+                y = end;
+            }
+        }
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  IMPStripStream_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPStripStream_cpu_hpp
+#define IMPStripStream_cpu_hpp
+
+#ifdef __cplusplus
+
+#include "IMPImage_cpu.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Float rows of one stage kept in a ring. Rows outside the image are clamped to the edges,
+        /// rows which left the ring must not be requested.
+        ///
+        class StripRows {
+
+        public:
+
+            StripRows() {}
+
+            void resize(size_t width, size_t height, size_t channels, size_t capacity);
+
+            inline float *row(long y) const {
+                y = y < 0 ? 0 : y >= long(_height) ? long(_height) - 1 : y;
+                return _data + (size_t(y) % _capacity) * _stride;
+            }
+
+            inline size_t width()       const { return _width; }
+            inline size_t height()      const { return _height; }
+            inline size_t channels()    const { return _channels; }
+            inline size_t rowElements() const { return _width * _channels; }
+            inline size_t bytes()       const { return _buffer.size() * sizeof(float); }
+
+        private:
+
+            AlignedBuffer<float> _buffer;
+            float  *_data     = nullptr;
+            size_t  _width    = 0;
+            size_t  _height   = 0;
+            size_t  _channels = 0;
+            size_t  _capacity = 1;
+            size_t  _stride   = 0;
+        };
+
+        ///
+        /// Neighbourhood operation which computes an output row from the input rows
+        /// [y - halo, y + halo]. process() is called concurrently for disjoint row ranges.
+        ///
+        class StripStage {
+
+        public:
+
+            virtual ~StripStage() {}
+
+            /// Input rows needed above and below an output row
+            virtual size_t halo() const = 0;
+
+            virtual size_t outputChannels(size_t inputChannels) const { return inputChannels; }
+
+            /// Compute output rows [begin, end)
+            virtual void process(const StripRows &input, size_t begin, size_t end, const StripRows &output) const = 0;
+        };
+
+        ///
+        /// Streams an image through a chain of stages band by band. Every stage keeps only a ring of
+        /// about band + 2 * halo rows of its input, so the peak memory is O(width * (band + halo))
+        /// whatever the image height is. Rows of a band are processed in parallel.
+        ///
+        class StripStream {
+
+        public:
+
+            /// Provides source row y converted to float, called in row order
+            typedef std::function<void(size_t y, float *row)> Reader;
+
+            /// Receives the final row y, called in row order
+            typedef std::function<void(size_t y, const float *row)> Writer;
+
+            explicit StripStream(size_t band = 64);
+
+            StripStream &add(const std::shared_ptr<StripStage> &stage);
+
+            inline const std::vector<std::shared_ptr<StripStage>> &stages() const { return _stages; }
+
+            inline size_t band() const { return _band; }
+
+            /// Channels of the rows the writer receives
+            size_t outputChannels(size_t channels) const;
+
+            /// Bytes of all the rings for an image of the width
+            size_t peakBytes(size_t width, size_t channels) const;
+
+            void run(size_t width, size_t height, size_t channels, const Reader &reader, const Writer &writer) const;
+
+            ///
+            /// Stream an image into destination, the source rows are read before any output row
+            /// which depends on them is written, so the images may be the same.
+            ///
+            template<typename T> bool run(const ImageView<const T> &source, const ImageView<T> &destination) const {
+
+                if (source.empty() || destination.empty()) return false;
+                if (source.width != destination.width || source.height != destination.height) return false;
+                if (outputChannels(source.channels) != destination.channels) return false;
+
+                run(source.width, source.height, source.channels,
+                    [&](size_t y, float *row){ loadRow(source.row(y), row, source.rowElements()); },
+                    [&](size_t y, const float *row){ storeRow(row, destination.row(y), destination.rowElements()); });
+
+                return true;
+            }
+
+        private:
+
+            size_t capacity(size_t ring) const;
+
+            size_t _band;
+            std::vector<std::shared_ptr<StripStage>> _stages;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPStripStream_cpu_hpp */
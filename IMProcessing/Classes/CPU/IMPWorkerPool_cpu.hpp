@@ -0,0 +1,125 @@
+//
+//  IMPWorkerPool_cpu.hpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+#ifndef IMPWorkerPool_cpu_hpp
+#define IMPWorkerPool_cpu_hpp
+
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IMProcessing
+{
+    namespace cpu
+    {
+        ///
+        /// Fixed capacity FIFO. push() blocks while the queue is full, which is the
+        /// backpressure point between a fast producer and slower workers.
+        ///
+        template<typename T> class BoundedQueue {
+
+        public:
+
+            explicit BoundedQueue(size_t capacity): _capacity(capacity > 0 ? capacity : 1) {}
+
+            bool push(T item) {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _notFull.wait(lock, [this]{ return _closed || _items.size() < _capacity; });
+                if (_closed) return false;
+                _items.push_back(std::move(item));
+                _notEmpty.notify_one();
+                return true;
+            }
+
+            ///
+            /// Returns false when the queue has been closed and drained.
+            ///
+            bool pop(T &item) {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _notEmpty.wait(lock, [this]{ return _closed || !_items.empty(); });
+                if (_items.empty()) return false;
+                item = std::move(_items.front());
+                _items.pop_front();
+                _notFull.notify_one();
+                return true;
+            }
+
+            void close() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+                _notEmpty.notify_all();
+                _notFull.notify_all();
+            }
+
+        private:
+            size_t                  _capacity;
+            bool                    _closed = false;
+            std::deque<T>           _items;
+            std::mutex              _mutex;
+            std::condition_variable _notEmpty;
+            std::condition_variable _notFull;
+        };
+
+        ///
+        /// Long living pool of workers pulling jobs from a bounded queue. Every job gets
+        /// the index of the worker running it, so callers can keep per-worker state
+        /// (decoders, scratch buffers) without locking.
+        ///
+        class WorkerPool {
+
+        public:
+
+            typedef std::function<void(size_t worker)> Job;
+
+            WorkerPool(size_t workers, size_t queueDepth): _queue(queueDepth) {
+                workers = workers > 0 ? workers : 1;
+                _threads.reserve(workers);
+                for (size_t w = 0; w < workers; w++) {
+                    _threads.emplace_back([this, w]{
+                        Job job;
+                        while (_queue.pop(job)) job(w);
+                    });
+                }
+            }
+
+            ~WorkerPool() { wait(); }
+
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            inline size_t workers() const { return _threads.size(); }
+
+            ///
+            /// Enqueue a job, blocking the caller while the queue is full.
+            ///
+            bool submit(Job job) { return _queue.push(std::move(job)); }
+
+            ///
+            /// Close the queue and wait until every submitted job is done.
+            ///
+            void wait() {
+                _queue.close();
+                for (auto &t: _threads) if (t.joinable()) t.join();
+            }
+
+        private:
+            BoundedQueue<Job>        _queue;
+            std::vector<std::thread> _threads;
+        };
+    }
+}
+
+#endif
+
+#endif /* IMPWorkerPool_cpu_hpp */
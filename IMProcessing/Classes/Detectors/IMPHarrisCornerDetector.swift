@@ -48,6 +48,22 @@ public class IMPHarrisCornerDetector: IMPDetector{
     
     public typealias PointsListObserver = ((_ corners: [IMPCorner], _ imageSize:NSSize) -> Void)
     
+    public enum Strategy {
+        /// Derivative, blur, response and fused suppression scanner passes on GPU
+        case shaders
+        /// All the stages fused per tile on CPU, no full frame intermediates
+        case tiled
+    }
+    
+    public var strategy:Strategy = .shaders {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
     public static let defaultBlurRadius:Float = 2
     public static let defaultTexelRadius:Float = 2
     
@@ -75,15 +91,18 @@ public class IMPHarrisCornerDetector: IMPDetector{
     }
     
     
-    public var threshold:Float {
-        set {
-            nonMaximumSuppression.threshold = newValue
-        }
-        get{ return nonMaximumSuppression.threshold }
-    }
+    public var threshold:Float = IMPNonMaximumSuppression.defaultThreshold { didSet{ dirty = true } }
+    
+    /// Drop corners closer than that to a stronger one in pixels, 0 keeps all; the tiled strategy only
+    public var minDistance:Float = 0 { didSet{ dirty = true } }
     
    
     public var pointsMax:Int = 4096 { didSet{ pointsBuffer = self.pointsBufferGetter() } }
+    
+    public static let defaultSlopeRegionSize:Int = 24
+    
+    /// Window of the corner slopes in pixels, the sums cover slopeRegionSize/2 pixels on each side
+    public var slopeRegionSize:Int = IMPHarrisCornerDetector.defaultSlopeRegionSize { didSet{ dirty = true } }
 
     public override func configure(complete:CompleteHandler?=nil) {
         extendName(suffix: "HarrisCornerDetector")
@@ -95,23 +114,81 @@ public class IMPHarrisCornerDetector: IMPDetector{
         threshold   = IMPNonMaximumSuppression.defaultThreshold
         texelRadius = IMPHarrisCornerDetector.defaultTexelRadius
         
-        pointsScannerKernel.threadsPerThreadgroup = MTLSize(width: 1, height: 1, depth: 1)
-        pointsScannerKernel.preferedDimension =  MTLSize(width: regionSize, height: regionSize, depth: 1)
+        suppressionScannerKernel.threadsPerThreadgroup = MTLSize(width: 16, height: 16, depth: 1)
     
-        add(filter: xyDerivative) { (source) in
-            self.derivativeTexture = source.texture
-        }
-        
-        add(filter: blurFilter)
-        add(filter: harrisCorner)
-        add(filter: nonMaximumSuppression)
-        add(function: pointsScannerKernel) { (result) in
-            self.readCorners(result)
-            complete?(result)
+        stagesComplete = complete
+        addStages()
+    }
+    
+    private var stagesComplete:CompleteHandler? = nil
+    
+    private func addStages() {
+        switch strategy {
+        case .shaders:
+            add(filter: xyDerivative) { (source) in
+                self.derivativeTexture = source.texture
+                self.integrateDerivative()
+            }
+            
+            add(filter: blurFilter)
+            add(filter: harrisCorner)
+            add(function: suppressionScannerKernel) { (result) in
+                self.readCorners(result)
+                self.stagesComplete?(result)
+            }
+        case .tiled:
+            add(function: cpuKernel) { (result) in
+                self.detectCorners(result)
+                self.stagesComplete?(result)
+            }
         }
     }
     
     fileprivate var derivativeTexture:MTLTexture?
+    fileprivate var integralRowsTexture:MTLTexture?
+    fileprivate var integralTexture:MTLTexture?
+    
+    //
+    // Tile-relative summed-area table of the derivative, the scanner sums every slope quadrant with
+    // four reads per kIMP_Integral_Tile block it covers. Entries sum one block only, so float32 keeps
+    // the window sums exact enough at any frame size; every block row and column is a thread
+    //
+    private func integrateDerivative() {
+        
+        guard let derivative = derivativeTexture else { return }
+        
+        if integralTexture?.width != derivative.width || integralTexture?.height != derivative.height {
+            let size = MTLSize(width: derivative.width, height: derivative.height, depth: 1)
+            integralRowsTexture = context.device.make2DTexture(size: size, pixelFormat: .rg32Float, mode: .private)
+            integralTexture = context.device.make2DTexture(size: size, pixelFormat: .rg32Float, mode: .private)
+        }
+        
+        guard let rows = integralRowsTexture, let integral = integralTexture else { return }
+        
+        let tile = Int(kIMP_Integral_Tile)
+        
+        context.execute(.sync, wait: true) { (commandBuffer) in
+            
+            //
+            // Threads run along the lines, the grid height is the number of blocks across them
+            //
+            for (kernel, input, output, lines, length) in [
+                (self.integralRowsKernel, derivative, rows, derivative.height, derivative.width),
+                (self.integralColumnsKernel, rows, integral, derivative.width, derivative.height)] {
+                
+                let threads = MTLSize(width: kernel.pipeline.threadExecutionWidth, height: 1, depth: 1)
+                let groups  = MTLSize(width: (lines + threads.width - 1) / threads.width,
+                                      height: (length + tile - 1) / tile,
+                                      depth: 1)
+                
+                let commandEncoder = kernel.commandEncoder(from: commandBuffer)
+                commandEncoder.setTexture(input, index: 0)
+                commandEncoder.setTexture(output, index: 1)
+                commandEncoder.dispatchThreadgroups(groups, threadsPerThreadgroup: threads)
+                commandEncoder.endEncoding()
+            }
+        }
+    }
     
     func pointsBufferGetter() -> MTLBuffer {
         //
@@ -128,10 +205,12 @@ public class IMPHarrisCornerDetector: IMPDetector{
     private lazy var xyDerivative:IMPXYDerivative = IMPXYDerivative(context: self.context)
     private lazy var blurFilter:IMPGaussianBlur = IMPGaussianBlur(context: self.context)
     private lazy var harrisCorner:IMPHarrisCorner = IMPHarrisCorner(context: self.context)
-    private lazy var nonMaximumSuppression:IMPNonMaximumSuppression = IMPNonMaximumSuppression(context: self.context)
     
-    private lazy var pointsScannerKernel:IMPFunction = {
-        let f = IMPFunction(context: self.context, kernelName: "kernel_pointsScanner")
+    //
+    // Suppression emits the corners directly, the mask is never written nor rescanned
+    //
+    private lazy var suppressionScannerKernel:IMPFunction = {
+        let f = IMPFunction(context: self.context, kernelName: "kernel_nonMaximumSuppressionScanner")
         
         f.optionsHandler = { (function, command, input, output) in
             
@@ -140,27 +219,76 @@ public class IMPHarrisCornerDetector: IMPDetector{
             command.setBuffer(self.pointsBuffer,       offset: 0, index: 0)
             command.setBuffer(self.pointsCountBuffer,  offset: 0, index: 1)
             
-            if let texture = self.derivativeTexture {
+            if let texture = self.integralTexture {
                 command.setTexture(texture, index: 2)
             }
 
             var mmx = uint(self.pointsMax)
             command.setBytes(&mmx, length: MemoryLayout.size(ofValue: mmx),   index: 2)
+            
+            var region = uint(max(self.slopeRegionSize, 0))
+            command.setBytes(&region, length: MemoryLayout.size(ofValue: region),   index: 3)
+            
+            var threshold = self.threshold
+            command.setBytes(&threshold, length: MemoryLayout.size(ofValue: threshold),   index: 4)
         }
         
         return f
     }()
     
+    private lazy var integralRowsKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_derivativeIntegralRows")
+    private lazy var integralColumnsKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_derivativeIntegralColumns")
+    
     fileprivate func getPoints(_ countBuff:MTLBuffer, _ maximumsBuff:MTLBuffer) -> [IMPCorner] {
         
-        let count = Int(countBuff.contents().bindMemory(to: uint.self,
-                                                        capacity: MemoryLayout<uint>.size).pointee)
+        let count = min(Int(countBuff.contents().bindMemory(to: uint.self,
+                                                            capacity: MemoryLayout<uint>.size).pointee), pointsMax)
         
         var maximums = [IMPCorner](repeating:IMPCorner(), count:  count)
         memcpy(&maximums, maximumsBuff.contents(), MemoryLayout<IMPCorner>.size * count)
+        
+        //
+        // Tiles are appended in completion order, the list is put in raster order
+        //
+        maximums.sort { $0.point.y < $1.point.y || ($0.point.y == $1.point.y && $0.point.x < $1.point.x) }
+        
         return maximums
     }
 
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
+    
+    fileprivate func detectCorners(_ destination: IMPImageProvider) {
+        
+        guard let size = destination.size, let texture = destination.texture else { return }
+        
+        let options = IMPHarrisCornersOptions(texelRadius: UInt32(max(texelRadius, 1)),
+                                              blurRadius:  blurRadius,
+                                              sensitivity: sensitivity,
+                                              k:           0.04,
+                                              threshold:   threshold,
+                                              slopeRegion: UInt32(max(slopeRegionSize, 0)),
+                                              topK:        UInt32(pointsMax),
+                                              minDistance: minDistance)
+        
+        var points = [IMPCorner](repeating:IMPCorner(), count: pointsMax)
+        var count = 0
+        
+        context.processOnCpu(texture: texture) { (image) -> Bool in
+            points.withUnsafeMutableBytes { (buffer) in
+                count = IMPHarrisCornersDetect(image,
+                                               buffer.baseAddress?.assumingMemoryBound(to: IMPCpuCorner.self),
+                                               pointsMax, options)
+            }
+            return false
+        }
+        
+        points.removeLast(max(pointsMax - count, 0))
+        
+        for o in cornersObserverList {
+            o(points,size)
+        }
+    }
+    
     fileprivate func readCorners(_ destination: IMPImageProvider) {
         
         guard let size = destination.size else { return }
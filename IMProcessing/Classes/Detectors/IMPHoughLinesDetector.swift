@@ -15,10 +15,66 @@ public class IMPHoughLinesDetector: IMPHoughSpaceDetector {
     
     public typealias LinesListObserver = ((_ lines: [IMPPolarLine], _ imageSize:NSSize) -> Void)
 
+    public typealias SegmentsListObserver = ((_ segments: [IMPLineSegment], _ imageSize:NSSize) -> Void)
+
     public func addObserver(lines observer: @escaping LinesListObserver) {
         linesObserverList.append(observer)
     }
 
+    /// Segments in normalized coordinates, the probabilistic strategy only
+    public func addObserver(segments observer: @escaping SegmentsListObserver) {
+        segmentsObserverList.append(observer)
+    }
+
+    public enum Strategy {
+        /// Atomic voting and local maximums of the (theta, rho) accumulator on GPU
+        case accumulator
+        /// PCLines: parallel coordinates voting of the edge pixels on CPU
+        case pcLines
+        /// Progressive probabilistic Hough on CPU: finite segments, stops after linesMax of them
+        case probabilistic
+        /// Two level accumulator on CPU: the fine bins around the peaks of a coarse space only
+        case coarseToFine
+    }
+    
+    public var strategy:Strategy = .accumulator {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
+    /// Columns of each of the PCLines T and S spaces, the pcLines strategy only
+    public var pcLinesResolution:Int = 256 { didSet{ dirty = true } }
+    
+    /// Coarse bins per fine bin along distance and angle, the coarseToFine strategy only
+    public var coarseFactor:Int = 4 { didSet{ dirty = true } }
+    
+    /// Shorter segments are dropped, in pixels along x or y; the probabilistic strategy only
+    public var minLineLength:Float = 30 { didSet{ dirty = true } }
+    
+    /// Longest run of missing edge pixels a segment may bridge; the probabilistic strategy only
+    public var maxLineGap:Float = 10 { didSet{ dirty = true } }
+    
+    /// Edge pixels drawn at most to bound the latency, 0 draws all of them; the probabilistic strategy only
+    public var samplesMax:Int = 0 { didSet{ dirty = true } }
+    
+    /// Voted angles on each side of the edge normal in radians, the normal is the Sobel gradient of the
+    /// source; 0 votes all the angles. The accumulator strategy only
+    public var orientationSpread:Float = 0 {
+        didSet{
+            guard (orientationSpread > 0) != (oldValue > 0) else { dirty = true; return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
+    /// An oriented pixel votes 1 + orientationWeight * gradient length rounded, 0 counts pixels
+    public var orientationWeight:Float = 0 { didSet{ dirty = true } }
+    
     public var blurRadius:Float {
         set{
             cannyEdge.blurRadius = newValue
@@ -36,29 +92,161 @@ public class IMPHoughLinesDetector: IMPHoughSpaceDetector {
         
         updateSettings()
         
-        func linesHandlerCallback(){
-            guard let size = edgesImage?.size else { return }
-            let lines = getLines(accum: getGPULocalMaximums(maximumsCountBuffer,maximumsBuffer), size:size)
-            if lines.count > 0 {
-                for l in linesObserverList {
-                    l(lines, size)
-                }
-            }
-        }
-
+        stagesComplete = complete
+        addStages()
+    }
+    
+    private var stagesComplete:CompleteHandler? = nil
+    
+    private func addStages() {
+        
         add(filter:cannyEdge) { (result) in
             self.edgesImage = result
             self.updateSettings()
         }
         
-        add(function:houghTransformKernel)
+        switch strategy {
+        case .accumulator:
+            add(function: orientationSpread > 0 ? houghGradientKernel : houghTransformKernel)
+            
+            add(function:houghSpaceLocalMaximumsKernel) { (result) in
+                self.linesHandlerCallback()
+                self.stagesComplete?(result)
+            }
+        case .pcLines:
+            add(function:cpuKernel) { (result) in
+                self.detectLines(result)
+                self.stagesComplete?(result)
+            }
+        case .probabilistic:
+            add(function:cpuKernel) { (result) in
+                self.detectSegments(result)
+                self.stagesComplete?(result)
+            }
+        case .coarseToFine:
+            add(function:cpuKernel) { (result) in
+                self.detectCoarseToFine(result)
+                self.stagesComplete?(result)
+            }
+        }
+    }
+    
+    private func linesHandlerCallback(){
+        guard let size = edgesImage?.size else { return }
+        let lines = getLines(accum: getGPULocalMaximums(maximumsCountBuffer,maximumsBuffer), size:size)
+        notify(lines: lines, size: size)
+    }
+    
+    private func notify(lines:[IMPPolarLine], size:NSSize) {
+        if lines.count > 0 {
+            for l in linesObserverList {
+                l(lines, size)
+            }
+        }
+    }
+    
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
+    
+    //
+    // Results of a CPU detector writing up to capacity of them and returning how many it has found:
+    // linesMax slots, or if linesMax does not limit them none first and then as many as were found.
+    // The detectors are deterministic, the second run finds the same results.
+    //
+    private func collect<T>(_ empty:T, _ detect:(_ results:UnsafeMutablePointer<T>?, _ capacity:Int) -> Int) -> [T] {
+        
+        var capacity = max(linesMax, 0)
+        var results  = [T]()
         
-        add(function:houghSpaceLocalMaximumsKernel) { (result) in
-            linesHandlerCallback()
-            complete?(result)
+        for _ in 0..<2 {
+            results = [T](repeating: empty, count: capacity)
+            let count = results.withUnsafeMutableBufferPointer { (buffer) in
+                return detect(buffer.baseAddress, capacity)
+            }
+            if count <= capacity || linesMax > 0 {
+                return Array(results.prefix(min(count, capacity)))
+            }
+            capacity = count
         }
+        
+        return results
     }
     
+    private func detectLines(_ destination: IMPImageProvider) {
+        
+        guard let size = destination.size, let texture = destination.texture else { return }
+        
+        let options = IMPPCLinesOptions(resolution:  UInt32(max(pcLinesResolution, 1)),
+                                        threshold:   UInt32(max(threshold, 0)),
+                                        linesMax:    UInt32(max(linesMax, 0)),
+                                        minDistance: 2)
+        
+        var found = [IMPCpuPolarLine]()
+        
+        context.processOnCpu(texture: texture) { (image) -> Bool in
+            found = collect(IMPCpuPolarLine()) { (lines, capacity) in
+                return IMPPCLinesDetect(image, lines, capacity, options)
+            }
+            return false
+        }
+        
+        let lines = found.map { IMPPolarLine(rho: $0.rho, theta: $0.theta) }
+        
+        notify(lines: lines, size: size)
+    }
+    
+    private func detectCoarseToFine(_ destination: IMPImageProvider) {
+        
+        guard let size = destination.size, let texture = destination.texture else { return }
+        
+        let options = IMPHoughSpaceOptions(rhoStep: rhoStep, thetaStep: thetaStep, minTheta: minTheta, maxTheta: maxTheta)
+        
+        let factor = UInt32(max(coarseFactor, 1))
+        var peaks = [IMPCpuHoughPeak]()
+        
+        context.processOnCpu(texture: texture) { (image) -> Bool in
+            peaks = collect(IMPCpuHoughPeak()) { (found, capacity) in
+                return IMPHoughCoarseToFinePeaks(image, options, peaksOptions, factor, found, capacity)
+            }
+            return false
+        }
+        
+        let lines = getLines(accum: peaks.map { uint2($0.index, $0.votes) }, size: size)
+        
+        notify(lines: lines, size: size)
+    }
+    
+    private func detectSegments(_ destination: IMPImageProvider) {
+        
+        guard let size = destination.size, let texture = destination.texture else { return }
+        
+        let options = IMPProbabilisticHoughOptions(rhoStep:       rhoStep,
+                                                   thetaStep:     thetaStep,
+                                                   threshold:     UInt32(max(threshold, 0)),
+                                                   minLineLength: minLineLength,
+                                                   maxLineGap:    maxLineGap,
+                                                   linesMax:      UInt32(max(linesMax, 0)),
+                                                   samplesMax:    UInt32(max(samplesMax, 0)),
+                                                   seed:          0x2545F491)
+        
+        var found = [IMPCpuLineSegment]()
+        
+        context.processOnCpu(texture: texture) { (image) -> Bool in
+            found = collect(IMPCpuLineSegment()) { (segments, capacity) in
+                return IMPProbabilisticHoughSegments(image, segments, capacity, options)
+            }
+            return false
+        }
+        
+        let segments = found.map {
+            IMPLineSegment(p0: float2($0.p0.0, $0.p0.1), p1: float2($0.p1.0, $0.p1.1))
+        }
+        
+        if segments.count > 0 {
+            for o in segmentsObserverList {
+                o(segments, size)
+            }
+        }
+    }
     
     internal override func updateSettings() {
         super.updateSettings()
@@ -96,6 +284,27 @@ public class IMPHoughLinesDetector: IMPHoughSpaceDetector {
         return f
     }()
     
+    private lazy var houghGradientKernel:IMPFunction = {
+        let f = IMPFunction(context: self.context, kernelName: "kernel_houghTransformAtomicGradient")
+        
+        f.optionsHandler = { (function, command, input, output) in
+            
+            command.setTexture(self.source?.texture ?? input, index: 2)
+            
+            command.setBuffer(self.accumBuffer,     offset: 0, index: 0)
+            command.setBytes(&self.numrho,    length: MemoryLayout.size(ofValue: self.numrho),   index: 1)
+            command.setBytes(&self.numangle,  length: MemoryLayout.size(ofValue: self.numangle), index: 2)
+            command.setBytes(&self.rhoStep,   length: MemoryLayout.size(ofValue: self.rhoStep),  index: 3)
+            command.setBytes(&self.thetaStep, length: MemoryLayout.size(ofValue: self.thetaStep),index: 4)
+            command.setBytes(&self.minTheta,  length: MemoryLayout.size(ofValue: self.minTheta), index: 5)
+            command.setBuffer(self.regionInBuffer,  offset: 0, index: 6)
+            command.setBytes(&self.orientationSpread, length: MemoryLayout.size(ofValue: self.orientationSpread), index: 7)
+            command.setBytes(&self.orientationWeight, length: MemoryLayout.size(ofValue: self.orientationWeight), index: 8)
+        }
+        
+        return f
+    }()
+    
     private lazy var houghSpaceLocalMaximumsKernel:IMPFunction = {
         let f = IMPFunction(context: self.context, kernelName: "kernel_houghSpaceLocalMaximums")
         f.optionsHandler = { (function, command, input, output) in
@@ -115,18 +324,7 @@ public class IMPHoughLinesDetector: IMPHoughSpaceDetector {
     private lazy var cannyEdge:IMPCannyEdges = IMPCannyEdges(context: self.context)
     
 
-    private func getGPULocalMaximums(_ countBuff:MTLBuffer?, _ maximumsBuff:MTLBuffer?) -> [uint2] {
-        
-        guard let maximumsBuff = maximumsBuff else {return []}
-        guard let countBuff = countBuff else {return []}
-        
-        let count = Int(countBuff.contents().bindMemory(to: uint.self,
-                                                        capacity: MemoryLayout<uint>.size).pointee)
-        var maximums = [uint2](repeating:uint2(0), count:  count)
-        memcpy(&maximums, maximumsBuff.contents(), MemoryLayout<uint2>.size * count)
-        return maximums.sorted { return $0.y>$1.y }
-    }
-    
     private lazy var linesObserverList = [LinesListObserver]()
+    private lazy var segmentsObserverList = [SegmentsListObserver]()
     
 }
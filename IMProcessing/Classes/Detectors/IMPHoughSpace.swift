@@ -23,6 +23,10 @@ public class IMPHoughSpace {
     
     public var linesMax:Int = 25
     public var threshold:Int = 100
+    
+    /// Weaker lines within these distance and angle bins of a stronger one are dropped, 0 keeps all
+    public var rhoRadius:Int = 0
+    public var thetaRadius:Int = 0
 
     public init(image:UnsafeMutablePointer<UInt8>,
                 bytesPerRow:Int,
@@ -71,14 +75,18 @@ public class IMPHoughSpace {
     
     private func updateSettings() {
         numangle = round((self.maxTheta - self.minTheta) / self.thetaStep).int
-        _accum = [Int](repeating:0, count:(numangle+2) * (numrho+2))
+        _accum = [UInt32](repeating:0, count:(numangle+2) * (numrho+2))
+    }
+    
+    private var options:IMPHoughSpaceOptions {
+        return IMPHoughSpaceOptions(rhoStep: rhoStep, thetaStep: thetaStep, minTheta: minTheta, maxTheta: maxTheta)
     }
     
     //
     // https://github.com/opencv/opencv/blob/master/modules/imgproc/src/hough.cpp
     //
     
-    private var _accum = [Int]()
+    private var _accum = [UInt32]()
     
     var numangle:Int = 0 {
         didSet{
@@ -105,20 +113,18 @@ public class IMPHoughSpace {
                 
         updateSettings()
         
-        for j in stride(from: 0, to: imageWidth, by: 1){
-            for i in stride(from: 0, to: imageHeight, by: 1){
-                
-                if image[i * bytesPerRow + j * 4] < 128 { continue }
-                
-                for n in 0..<numangle {
-                    
-                    var r = round( j.float * _tabCos[n] + i.float * _tabSin[n] )
-                    r += (numrho.float - 1) / 2
-                    
-                    let index = (n+1) * (numrho+2) + r.int+1
-                    _accum[index] += 1
-                }
-            }
+        //
+        // Edge pixels are compacted in row order and voted by angle ranges in parallel
+        //
+        let source = IMPCpuImage(data: image,
+                                 width: imageWidth,
+                                 height: imageHeight,
+                                 bytesPerRow: bytesPerRow,
+                                 format: IMPCpuPixelFormatRGBA8)
+        
+        let count = _accum.count
+        _accum.withUnsafeMutableBufferPointer { (buffer) in
+            _ = IMPHoughSpaceTransform(source, options, buffer.baseAddress, count)
         }
     }
     
@@ -128,39 +134,48 @@ public class IMPHoughSpace {
         
         updateSettings()
         
-        for p in points{
-            for n in 0..<numangle {
-                let x = p.x * imageWidth.float
-                let y = p.y * imageHeight.float
-                var r = round( x * _tabCos[n] + y * _tabSin[n] )
-                
-                r += (numrho.float - 1) / 2
-                
-                let index = (n+1) * (numrho+2) + r.int+1
-                _accum[index] += 1
+        let count = _accum.count
+        points.withUnsafeBytes { (list) in
+            _accum.withUnsafeMutableBufferPointer { (buffer) in
+                _ = IMPHoughSpaceTransformPoints(list.baseAddress?.assumingMemoryBound(to: Float.self), points.count,
+                                                 imageWidth, imageHeight, options, buffer.baseAddress, count)
             }
         }
     }
     
-    public func getLocalMaximums(threshold:Int = 50) -> [uint2] /*[(index:Int,bins:Int)]*/ {
-        // stage 2. find local maximums
-        var _sorted_accum = [uint2]()
-        
-        for r in stride(from: 0, to: numrho, by: 1) {
-            for n in stride(from: 0, to: numangle, by: 1){
-                
-                let base = (n+1) * (numrho+2) + r+1
-                let bins = _accum[base]
-                if( bins > threshold &&
-                    bins > _accum[base - 1] && bins >= _accum[base + 1] &&
-                    bins > _accum[base - numrho - 2] && bins >= _accum[base + numrho + 2] ){
-                }
-                _sorted_accum.append(uint2(UInt32(base),UInt32(bins)))
+    ///
+    /// Local maximums of the accumulator, the strongest first
+    ///
+    /// - Parameters:
+    ///   - threshold: votes a maximum must exceed
+    ///   - linesMax: strongest maximums to return, 0 returns all
+    public func getLocalMaximums(threshold:Int = 50, linesMax:Int = 0) -> [uint2] /*[(index:Int,bins:Int)]*/ {
+        
+        // stage 2. find local maximums, stage 3. keep the strongest in bounded heaps
+        
+        let options = IMPHoughPeaksOptions(threshold:   UInt32(max(threshold, 0)),
+                                           linesMax:    UInt32(max(linesMax, 0)),
+                                           rhoRadius:   UInt32(max(rhoRadius, 0)),
+                                           thetaRadius: UInt32(max(thetaRadius, 0)))
+        
+        //
+        // All the maximums are counted first when there is no bound
+        //
+        var capacity = linesMax
+        
+        if capacity <= 0 {
+            capacity = _accum.withUnsafeBufferPointer { (buffer) in
+                return IMPHoughPeaksFind(buffer.baseAddress, numangle, numrho, options, nil, 0)
             }
         }
         
-        // stage 3. sort
-        return _sorted_accum.sorted { return $0.y>$1.y }
+        var peaks = [IMPCpuHoughPeak](repeating:IMPCpuHoughPeak(), count: capacity)
+        
+        let found = _accum.withUnsafeBufferPointer { (buffer) in
+            return IMPHoughPeaksFind(buffer.baseAddress, numangle, numrho, options, &peaks, capacity)
+        }
+        
+        return peaks.prefix(min(found, capacity)).map { uint2($0.index, $0.votes) }
     }
     
     public func getPoint(from space:  [(index:Int,bins:Int)], at index: Int) -> (rho:Float,theta:Float,capcity:Int) {
@@ -180,7 +195,7 @@ public class IMPHoughSpace {
     
     public func getLines() -> [IMPPolarLine]  {
         
-        let _sorted_accum:[uint2] = getLocalMaximums(threshold: threshold)
+        let _sorted_accum:[uint2] = getLocalMaximums(threshold: threshold, linesMax: linesMax)
         
         // stage 4. store the first min(total,linesMax) lines to the output buffer
         let linesMax = min(self.linesMax, _sorted_accum.count)
@@ -30,6 +30,11 @@ public class IMPHoughSpaceDetector: IMPDetector {
     
     public var linesMax:Int = 100 { didSet{dirty = true} }
     
+    /// Weaker lines within these distance and angle bins of a stronger one are dropped, 0 keeps all
+    public var rhoRadius:Int = 0 { didSet{dirty = true} }
+    
+    public var thetaRadius:Int = 0 { didSet{dirty = true} }
+    
     internal var edgesImage:IMPImageProvider?
     
     internal func updateSettings() {
@@ -76,6 +81,35 @@ public class IMPHoughSpaceDetector: IMPDetector {
         return lines
     }
     
+    internal var peaksOptions:IMPHoughPeaksOptions {
+        return IMPHoughPeaksOptions(threshold:   UInt32(max(threshold, 0)),
+                                    linesMax:    UInt32(max(linesMax, 0)),
+                                    rhoRadius:   UInt32(max(rhoRadius, 0)),
+                                    thetaRadius: UInt32(max(thetaRadius, 0)))
+    }
+    
+    //
+    // The strongest linesMax of the GPU maximums, the strongest first: bounded heaps select
+    // them rather than sorting all the maximums
+    //
+    internal func getGPULocalMaximums(_ countBuff:MTLBuffer?, _ maximumsBuff:MTLBuffer?) -> [uint2] {
+        
+        guard let maximumsBuff = maximumsBuff else {return []}
+        guard let countBuff = countBuff else {return []}
+        
+        let count = Int(countBuff.contents().bindMemory(to: uint.self,
+                                                        capacity: MemoryLayout<uint>.size).pointee)
+        
+        let candidates = maximumsBuff.contents().bindMemory(to: IMPCpuHoughPeak.self, capacity: count)
+        
+        let capacity = linesMax > 0 ? linesMax : count
+        var peaks = [IMPCpuHoughPeak](repeating:IMPCpuHoughPeak(), count: capacity)
+        
+        let found = IMPHoughPeaksSelect(candidates, count, Int(numrho), peaksOptions, &peaks, capacity)
+        
+        return peaks.prefix(min(found, capacity)).map { uint2($0.index, $0.votes) }
+    }
+    
     internal func accumBufferGetter() -> MTLBuffer? {
         //
         // to echange data should be .storageModeShared!!!!
@@ -140,18 +140,6 @@ public class IMPOrientedLinesDetector: IMPHoughSpaceDetector {
     
     private lazy var sobelEdges:IMPSobelEdgesGradient = IMPSobelEdgesGradient(context: self.context)
     
-    private func getGPULocalMaximums(_ countBuff:MTLBuffer?, _ maximumsBuff:MTLBuffer?) -> [uint2] {
-        
-        guard let maximumsBuff = maximumsBuff else {return []}
-        guard let countBuff = countBuff else {return []}
-        
-        let count = Int(countBuff.contents().bindMemory(to: uint.self,
-                                                        capacity: MemoryLayout<uint>.size).pointee)
-        var maximums = [uint2](repeating:uint2(0), count:  count)
-        memcpy(&maximums, maximumsBuff.contents(), MemoryLayout<uint2>.size * count)
-        return maximums.sorted { return $0.y>$1.y }
-    }
-    
     
     fileprivate lazy var linesObserverList = [LinesListObserver]()
 }
@@ -0,0 +1,57 @@
+//
+//  IMPCatalogAnalyzer.swift
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+import Foundation
+
+///
+/// Headless histogram analyzer for large JPEG catalogs. Does the same binning as IMPHistogramAnalyzer
+/// and runs IMPHistogramRangeSolver, IMPHistogramZonesSolver and IMPHistogramDominantColorSolver
+/// on a bounded pool of CPU workers, without any Metal context.
+///
+/// Results are streamed as newline delimited JSON, one object per catalog entry.
+///
+public class IMPCatalogAnalyzer {
+
+    /// Decoding workers, 0 - one per core
+    public var workers:Int = 0
+
+    /// Catalog entries waiting for a free worker, 0 - twice the number of workers
+    public var queueDepth:Int = 0
+
+    /// The smallest side of an image decoded with reduced DCT scale, 0 - decode at full size
+    public var minimumSide:Int = 256
+
+    public var clipping = IMPHistogramRangeSolver.clippingType()
+
+    public var region = IMPRegion()
+
+    public init() {}
+
+    ///
+    /// Analyze files listed one path per line in the catalog file.
+    ///
+    /// - parameter catalog: catalog file path, "-" reads stdin
+    /// - parameter output:  newline delimited JSON output path, "-" writes to stdout
+    ///
+    /// - returns: number of processed entries or nil if catalog or output can't be opened
+    ///
+    @discardableResult public func analyze(catalog:String, output:String) -> Int? {
+        var options = IMPCatalogAnalyzerDefaultOptions()
+        options.workers            = UInt32(workers)
+        options.queueDepth         = UInt32(queueDepth)
+        options.minimumSide        = UInt32(minimumSide)
+        options.shadowsClipping    = clipping.shadows
+        options.highlightsClipping = clipping.highlights
+        options.regionLeft         = region.left
+        options.regionRight        = region.right
+        options.regionTop          = region.top
+        options.regionBottom       = region.bottom
+        let processed = IMPCatalogAnalyzerRun(catalog, output, &options)
+        return processed < 0 ? nil : processed
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  IMPVanHerkMorphology.swift
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+import Foundation
+import Metal
+
+///
+/// Van Herk - Gil-Werman morphology on CPU: the cost per pixel does not depend on the radius, and the
+/// structuring element may be a rectangle, a diamond or a disk. IMPErosion and IMPDilation keep the
+/// separable GPU passes of a rectangle.
+///
+open class IMPVanHerkMorphology: IMPFilter {
+
+    public enum Operation {
+        case erode
+        case dilate
+        /// Dilation of the erosion
+        case open
+        /// Erosion of the dilation
+        case close
+        /// Source minus opening
+        case topHat
+        /// Closing minus source
+        case blackHat
+        /// Dilation minus erosion
+        case gradient
+    }
+
+    public enum Shape {
+        /// (2*radius.width+1) x (2*radius.height+1) rectangle
+        case rectangle
+        /// |x| + |y| <= radius.width
+        case diamond
+        /// Regular octagon of radius.width approximating the disk
+        case disk
+    }
+
+    public typealias Radius = (width:Int,height:Int)
+
+    public var operation:Operation = .erode { didSet{ dirty = true } }
+
+    public var shape:Shape = .rectangle { didSet{ dirty = true } }
+
+    public var radius:Radius = (width:1,height:1) { didSet{ dirty = true } }
+
+    open override func configure(complete:CompleteHandler?=nil) {
+        extendName(suffix: "IMPVanHerkMorphology")
+        super.configure()
+        add(function: cpuKernel){ (result) in
+            if let texture = result.texture {
+                let radiusX = UInt32(max(self.radius.width, 0))
+                let radiusY = UInt32(max(self.radius.height, 0))
+                self.context.processOnCpu(texture: texture) { (image) -> Bool in
+                    return IMPMorphologyApply(image, image, self.cpuOperation, self.cpuShape, radiusX, radiusY)
+                }
+            }
+            complete?(result)
+        }
+    }
+
+    private var cpuOperation:IMPMorphologyOperation {
+        switch operation {
+        case .erode:    return IMPMorphologyErode
+        case .dilate:   return IMPMorphologyDilate
+        case .open:     return IMPMorphologyOpen
+        case .close:    return IMPMorphologyClose
+        case .topHat:   return IMPMorphologyTopHat
+        case .blackHat: return IMPMorphologyBlackHat
+        case .gradient: return IMPMorphologyGradient
+        }
+    }
+
+    private var cpuShape:IMPMorphologyShape {
+        switch shape {
+        case .rectangle: return IMPMorphologyRectangle
+        case .diamond:   return IMPMorphologyDiamond
+        case .disk:      return IMPMorphologyDisk
+        }
+    }
+
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
+}
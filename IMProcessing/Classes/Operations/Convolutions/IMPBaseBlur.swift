@@ -56,17 +56,28 @@ public class IMPBaseBlur: IMPFilter {
         extendName(suffix: "GaussianBlur")
         radius = 0
         
-        func fail(_ error:RegisteringError) {
-            fatalError("IMPGaussianBlurFilter: error = \(error)")
-            
-        }
+        stagesComplete = complete
+        
+        addStages()
+    }
+    
+    internal var stagesComplete:CompleteHandler? = nil
+    
+    internal func fail(_ error:RegisteringError) {
+        fatalError("IMPGaussianBlurFilter: error = \(error)")
+    }
+    
+    ///
+    /// Blur stages of the filter chain, subclasses may replace them with another blur strategy
+    ///
+    internal func addStages() {
         
         if prefersRendering {
             add(shader: downscaleShader, fail: fail)
             add(shader: horizontalShader, fail: fail)
             add(shader: verticalShader, fail: fail)
             add(shader: upscaleShader, fail: fail){ (source) in
-                complete?(source)
+                self.stagesComplete?(source)
             }
             
         }
@@ -75,12 +86,26 @@ public class IMPBaseBlur: IMPFilter {
             add(function: horizontalKernel, fail: fail)
             add(function: verticalKernel, fail: fail)
             add(function: upscaleKernel, fail: fail){ (source) in
-                complete?(source)
+                self.stagesComplete?(source)
             }
             
         }
     }
     
+    ///
+    /// Host memory blur stages: the source is copied as is, processed in place by a CPU engine
+    /// and blended with the source the same way the sampled blur does
+    ///
+    internal func addCpuStages(_ blur: @escaping (_ image:IMPCpuImage) -> Bool) {
+        add(function: cpuKernel, fail: fail) { (result) in
+            guard self.radius > 0, let texture = result.texture else { return }
+            self.context.processOnCpu(texture: texture, blur)
+        }
+        add(function: upscaleKernel, fail: fail){ (source) in
+            self.stagesComplete?(source)
+        }
+    }
+    
     private var sigma:Float {
         get {
             return radiusApproximation > radius ? radius : radiusApproximation
@@ -88,6 +113,10 @@ public class IMPBaseBlur: IMPFilter {
     }
     
     private var pixelRadius:Int {
+        return pixelRadius(sigma: sigma)
+    }
+    
+    func pixelRadius(sigma:Float) -> Int {
         let samplingArea:Float = 1.0 / 256.0
         var newRadius:Int = 0
         if sigma >= 1.0 {
@@ -136,17 +165,7 @@ public class IMPBaseBlur: IMPFilter {
             factor = float2(0, 1/newSize.height.float)
             memcpy(vTexelSizeBuffer.contents(), &factor, vTexelSizeBuffer.length)
 
-            var extendedWeights:[Float]
-            var extendedOffsets:[Float]
-            
-            (offsets, weights, extendedOffsets, extendedWeights) = optimized(pixelRadius, sigma: sigma)
-            
-            if extendedOffsets.count > 0 {
-                for i in 0..<extendedWeights.count {
-                    weights.append(extendedWeights[i])
-                    offsets.append(extendedOffsets[i])
-                }
-            }
+            (weights, offsets) = sampledKernel(sigma: sigma)
         }
         
         if weights.count == 0 {
@@ -159,6 +178,16 @@ public class IMPBaseBlur: IMPFilter {
     }
     
     
+    ///
+    /// Linearly sampled weights and offsets of the kernel, the layout kernel_gaussianSampledBlur reads
+    ///
+    func sampledKernel(sigma:Float) -> (weights:[Float], offsets:[Float]) {
+        
+        let (offsets, weights, extendedOffsets, extendedWeights) = optimized(pixelRadius(sigma: sigma), sigma: sigma)
+        
+        return (weights + extendedWeights, offsets + extendedOffsets)
+    }
+    
     lazy var hTexelSizeBuffer:MTLBuffer = self.context.device.makeBuffer(length: MemoryLayout<float2>.size, options: [])!
     lazy var vTexelSizeBuffer:MTLBuffer = self.context.device.makeBuffer(length: MemoryLayout<float2>.size, options: [])!
     lazy var weightsTexture:MTLTexture = {
@@ -187,6 +216,8 @@ public class IMPBaseBlur: IMPFilter {
         return f
     }()
     
+    lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
+    
     lazy var upscaleKernel:IMPFunction = {
         let f = IMPFunction(context: self.context,
                             kernelName: "kernel_blendSource")
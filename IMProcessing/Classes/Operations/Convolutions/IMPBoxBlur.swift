@@ -9,6 +9,34 @@
 import Foundation
 
 public class IMPBoxBlur: IMPBaseBlur {
+    
+    public enum Strategy {
+        /// Separable convolution with linearly sampled weights on GPU
+        case sampled
+        /// Running sum box filter on CPU, the cost does not depend on radius. The window spans
+        /// pixelRadius(sigma: radius) pixels each side, the half-width of the sampled box at full resolution
+        case runningSum
+    }
+    
+    public var strategy:Strategy = .sampled {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
+    override func addStages() {
+        guard strategy == .runningSum else {
+            super.addStages()
+            return
+        }
+        addCpuStages { (image) -> Bool in
+            return IMPRunningSumBoxBlur(image, image, UInt32(self.pixelRadius(sigma: self.radius)))
+        }
+    }
+    
     public override func weights(radius inPixels: Int, sigma: Float) -> [Float] {
         let boxWeight = 1.0 / (Float(inPixels * 2) + 1 )
         var weights = [Float]()
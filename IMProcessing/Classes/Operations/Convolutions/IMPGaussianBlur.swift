@@ -16,6 +16,56 @@ import Accelerate
 import simd
 
 public class IMPGaussianBlur: IMPBaseBlur {    
+    
+    public enum Strategy {
+        /// Separable convolution with linearly sampled weights on GPU
+        case sampled
+        /// Young - van Vliet recursive filter on CPU, the cost does not depend on radius
+        case recursive
+        /// Stacked running sum box filters on CPU, the fastest preview approximation
+        case stackedBoxes
+        /// Cache blocked separable convolution on CPU with the sampled weights at full resolution
+        case tiled
+    }
+    
+    public var strategy:Strategy = .sampled {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
+    /// Number of box passes of the stackedBoxes strategy, 3 - 5
+    public var boxPasses:Int = 3 {
+        didSet{
+            boxPasses = min(max(boxPasses, 3), 5)
+            dirty = true
+        }
+    }
+    
+    override func addStages() {
+        switch strategy {
+        case .sampled:
+            super.addStages()
+        case .recursive:
+            addCpuStages { (image) -> Bool in
+                return IMPRecursiveGaussianBlur(image, image, self.radius)
+            }
+        case .stackedBoxes:
+            addCpuStages { (image) -> Bool in
+                return IMPStackedBoxGaussianBlur(image, image, self.radius, UInt32(self.boxPasses))
+            }
+        case .tiled:
+            addCpuStages { (image) -> Bool in
+                let kernel = self.sampledKernel(sigma: self.radius)
+                guard kernel.weights.count > 0 else { return false }
+                return IMPSampledSeparableConvolve(image, image, kernel.weights, kernel.offsets, UInt32(kernel.weights.count))
+            }
+        }
+    }
+    
     public override func weights(radius inPixels: Int, sigma: Float) -> [Float] {
         var weights = [Float]()
         var sumOfWeights:Float = 0.0
@@ -28,8 +28,24 @@ import Metal
 
 public class IMPCannyEdges: IMPResampler{
     
+    public enum Strategy {
+        /// Non maximum suppression and one weak pixel inclusion pass on GPU
+        case weakPixelInclusion
+        /// The same stages on CPU with exact hysteresis: weak pixels connected to strong ones by any path are kept
+        case hysteresis
+    }
+    
     public static let defaultBlurRadius:Float = 2
     
+    public var strategy:Strategy = .weakPixelInclusion {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
     public var blurRadius:Float {
         set{
             blurFilter.radius = newValue
@@ -61,17 +77,40 @@ public class IMPCannyEdges: IMPResampler{
         super.configure()
             
         blurRadius = IMPCannyEdges.defaultBlurRadius
-
-        add(function: luminance)
-        add(filter: blurFilter)
-        add(filter: sobelEdgeFilter)
-        add(filter: directionalNonMaximumSuppression)
-        add(filter: weakPixelInclusion){ (source) in
-            complete?(source)
+        
+        stagesComplete = complete
+        addStages()
+    }
+    
+    private var stagesComplete:CompleteHandler? = nil
+    
+    private func addStages() {
+        switch strategy {
+        case .weakPixelInclusion:
+            add(function: luminance)
+            add(filter: blurFilter)
+            add(filter: sobelEdgeFilter)
+            add(filter: directionalNonMaximumSuppression)
+            add(filter: weakPixelInclusion){ (source) in
+                self.stagesComplete?(source)
+            }
+        case .hysteresis:
+            add(function: cpuKernel){ (result) in
+                if let texture = result.texture {
+                    let options = IMPCannyOptions(blurRadius: self.blurRadius,
+                                                  upperThreshold: self.upperThreshold,
+                                                  lowerThreshold: self.lowerThreshold)
+                    self.context.processOnCpu(texture: texture) { (image) -> Bool in
+                        return IMPCannyApply(image, image, options)
+                    }
+                }
+                self.stagesComplete?(result)
+            }
         }
     }
     
     private lazy var luminance:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_luminance")
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
     
     private lazy var blurFilter:IMPGaussianBlur = IMPGaussianBlur(context: self.context)
     private lazy var directionalNonMaximumSuppression:IMPDirectionalNonMaximumSuppression = IMPDirectionalNonMaximumSuppression(context: self.context)
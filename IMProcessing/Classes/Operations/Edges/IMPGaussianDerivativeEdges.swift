@@ -10,14 +10,52 @@ import Foundation
 
 public class IMPGaussianDerivativeEdges: IMPFilter{
     
+    public enum Strategy {
+        /// Every thread samples the derivatives of its neighbours on GPU
+        case shader
+        /// Derivative planes computed once on CPU
+        case derivativePlanes
+    }
+    
     var pitch:Int = 1
     
+    public var strategy:Strategy = .shader {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
     public override func configure(complete:CompleteHandler?) {
         extendName(suffix: "GaussianDerivativeEdges")
-        add(function: gaussianDerivative){ (source) in
-            complete?(source)
+        stagesComplete = complete
+        addStages()
+    }
+    
+    private var stagesComplete:CompleteHandler? = nil
+    
+    private func addStages() {
+        switch strategy {
+        case .shader:
+            add(function: gaussianDerivative){ (source) in
+                self.stagesComplete?(source)
+            }
+        case .derivativePlanes:
+            add(function: cpuKernel){ (result) in
+                if let texture = result.texture {
+                    self.context.processOnCpu(texture: texture) { (image) -> Bool in
+                        return IMPGaussianDerivativeEdgesApply(image, image, UInt32(max(self.pitch, 1)), 1)
+                    }
+                }
+                self.stagesComplete?(result)
+            }
         }
     }
+    
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
+    
     lazy var gaussianDerivative:IMPFunction = {
         let f = IMPFunction(context: self.context, kernelName: "kernel_gaussianDerivativeEdge")
         f.optionsHandler = { (function, command, input, output) in
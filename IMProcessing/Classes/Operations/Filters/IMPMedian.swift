@@ -11,13 +11,48 @@ import Metal
 
 open class IMPMedian: IMPFilter {
     
+    public enum Strategy {
+        /// Window samples sorted by luma on GPU, dimensions up to 64
+        case sorted
+        /// Perreault - Hébert histogram median on CPU, the cost does not depend on dimensions
+        case constantTime
+    }
+    
     public var dimensions:Int = 3 { didSet{ dirty = true } }
     
+    public var strategy:Strategy = .sorted {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
+    
     open override func configure(complete:CompleteHandler?=nil) {
         extendName(suffix: "IMPMedian")
         super.configure()
-        add(function: medianKernel){ (source) in
-            complete?(source)
+        stagesComplete = complete
+        addStages()
+    }
+    
+    private var stagesComplete:CompleteHandler? = nil
+    
+    private func addStages() {
+        switch strategy {
+        case .sorted:
+            add(function: medianKernel){ (source) in
+                self.stagesComplete?(source)
+            }
+        case .constantTime:
+            add(function: cpuKernel){ (result) in
+                if self.dimensions > 1, let texture = result.texture {
+                    self.context.processOnCpu(texture: texture) { (image) -> Bool in
+                        return IMPConstantTimeMedian(image, image, UInt32(self.dimensions/2), IMPMedianModeLuma, 0)
+                    }
+                }
+                self.stagesComplete?(result)
+            }
         }
     }
     
@@ -31,6 +66,8 @@ open class IMPMedian: IMPFilter {
         
         return f
     }()
+    
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
 }
 
 open class IMPTwoPassMedian: IMPTwoPass {
@@ -10,26 +10,65 @@ import Foundation
 
 public class IMPAdaptiveThreshold: IMPFilter {
     
+    public enum Strategy {
+        /// Luminance and box blur textures on GPU
+        case blurred
+        /// Summed-area table of luma on CPU, the cost does not depend on blurRadius
+        case integral
+    }
+    
     public var blurRadius:Float = 4
     
+    public var strategy:Strategy = .blurred {
+        didSet{
+            guard strategy != oldValue else { return }
+            removeAll()
+            addStages()
+            dirty = true
+        }
+    }
     
     public override func configure(complete: IMPFilterProtocol.CompleteHandler?) {
         extendName(suffix: "AdaptiveThreshold")
         super.configure()
-        
-        boxBlur.radius = blurRadius
-        
-        add(function: luminance){ (source) in
-            self.luminanceOutput = source
-        }
-        add(filter: boxBlur)
-        add(function: adaptiveKernel) { (source) in
-            complete?(source)
+        stagesComplete = complete
+        addStages()
+    }
+    
+    private var stagesComplete:CompleteHandler? = nil
+    
+    private func addStages() {
+        switch strategy {
+        case .blurred:
+            boxBlur.radius = blurRadius
+            
+            add(function: luminance){ (source) in
+                self.luminanceOutput = source
+            }
+            add(filter: boxBlur)
+            add(function: adaptiveKernel) { (source) in
+                self.stagesComplete?(source)
+            }
+        case .integral:
+            add(function: cpuKernel){ (result) in
+                if let texture = result.texture {
+                    // the window of the box blur the .blurred strategy averages with
+                    let radius = self.boxBlur.pixelRadius(sigma: self.blurRadius)
+                    let options = IMPAdaptiveThresholdOptions(method: IMPAdaptiveThresholdBradley,
+                                                              radius: UInt32(max(radius, 0)),
+                                                              k: 0, offset: 0.05, range: 0.5)
+                    self.context.processOnCpu(texture: texture) { (image) -> Bool in
+                        return IMPAdaptiveThresholdApply(image, image, options)
+                    }
+                }
+                self.stagesComplete?(result)
+            }
         }
     }
     
     private lazy var luminance:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_luminance")
     private lazy var boxBlur:IMPBoxBlur = IMPBoxBlur(context:self.context)
+    private lazy var cpuKernel:IMPFunction = IMPFunction(context: self.context, kernelName: "kernel_passthrough")
 
     
     private lazy var adaptiveKernel:IMPFunction = {
@@ -0,0 +1,100 @@
+//
+//  IMPCpuImage.swift
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+
+import Metal
+
+public extension IMPCpuImage {
+
+    /// Bridged CPU layout of a Metal pixel format, nil if CPU engines can't process it
+    public static func format(of pixelFormat:MTLPixelFormat) -> (format:IMPCpuPixelFormat, bytesPerPixel:Int)? {
+        switch pixelFormat {
+        case .r8Unorm:
+            return (IMPCpuPixelFormatR8, 1)
+        case .rgba8Unorm, .bgra8Unorm:
+            return (IMPCpuPixelFormatRGBA8, 4)
+        case .r16Unorm:
+            return (IMPCpuPixelFormatR16, 2)
+        case .rgba16Unorm:
+            return (IMPCpuPixelFormatRGBA16, 8)
+        case .r32Float:
+            return (IMPCpuPixelFormatR32F, 4)
+        case .rgba32Float:
+            return (IMPCpuPixelFormatRGBA32F, 16)
+        default:
+            return nil
+        }
+    }
+}
+
+public extension IMPContext {
+
+    ///
+    /// Copy a texture to host memory, let a CPU engine process it in place and upload the result back.
+    /// Both copies are blits in the context queue, so the texture may be a result of the previous stage.
+    ///
+    /// - parameter texture: 2D texture of one of IMPCpuPixelFormat layouts
+    /// - parameter body:    CPU processing, returns false if nothing has been changed
+    ///
+    /// - returns: false if the texture format is not supported or the body has failed
+    ///
+    @discardableResult public func processOnCpu(texture:MTLTexture, _ body:(_ image:IMPCpuImage) -> Bool) -> Bool {
+
+        guard let (format, bytesPerPixel) = IMPCpuImage.format(of: texture.pixelFormat) else { return false }
+
+        let bytesPerRow   = bytesPerPixel * texture.width
+        let bytesPerImage = bytesPerRow * texture.height
+        let region        = MTLSize(width: texture.width, height: texture.height, depth: 1)
+
+        guard let buffer = device.makeBuffer(length: bytesPerImage, options: []) else { return false }
+
+        execute(.sync, wait: true) { (commandBuffer) in
+            let blit = commandBuffer.makeBlitCommandEncoder()
+            blit?.copy(from:         texture,
+                       sourceSlice:  0,
+                       sourceLevel:  0,
+                       sourceOrigin: MTLOrigin(x:0,y:0,z:0),
+                       sourceSize:   region,
+                       to:           buffer,
+                       destinationOffset: 0,
+                       destinationBytesPerRow: bytesPerRow,
+                       destinationBytesPerImage: bytesPerImage)
+            #if os(OSX)
+                blit?.synchronize(resource: buffer)
+            #endif
+            blit?.endEncoding()
+        }
+
+        let image = IMPCpuImage(data: buffer.contents(),
+                                width: texture.width,
+                                height: texture.height,
+                                bytesPerRow: bytesPerRow,
+                                format: format)
+
+        guard body(image) else { return false }
+
+        #if os(OSX)
+            buffer.didModifyRange(0..<bytesPerImage)
+        #endif
+
+        execute(.sync, wait: true) { (commandBuffer) in
+            let blit = commandBuffer.makeBlitCommandEncoder()
+            blit?.copy(from:         buffer,
+                       sourceOffset: 0,
+                       sourceBytesPerRow: bytesPerRow,
+                       sourceBytesPerImage: bytesPerImage,
+                       sourceSize:   region,
+                       to:           texture,
+                       destinationSlice:  0,
+                       destinationLevel:  0,
+                       destinationOrigin: MTLOrigin(x:0,y:0,z:0))
+            blit?.endEncoding()
+        }
+
+        return true
+    }
+}
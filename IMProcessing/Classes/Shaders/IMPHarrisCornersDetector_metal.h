@@ -24,89 +24,199 @@ using namespace metal;
 #ifdef __cplusplus
 
 
-inline float2 getSlops(int startx, int endx, int starty, int endy, uint2 gid,
-                       texture2d<float>  derivative,
-                       texture2d<float, access::write>  destination ){
+///
+/// Tile-relative summed-area table of the derivative hd^2, vd^2 channels: every kIMP_Integral_Tile
+/// square block holds the inclusive prefix sums of its own samples only. A table over the whole
+/// frame reaches 1e5 - 1e7 where the float32 ulp is about 1 and the window sums cancel to noise,
+/// block entries stay within kIMP_Integral_Tile^2 samples. A row prefix pass, one thread per
+/// row of a block, then a column prefix pass, one thread per column of a block, rg32Float.
+///
+kernel void kernel_derivativeIntegralRows(
+                                          texture2d<float, access::read>   derivative [[texture(0)]],
+                                          texture2d<float, access::write>  rows       [[texture(1)]],
+                                          uint2 gid [[thread_position_in_grid]]
+                                          )
+{
+    uint width  = derivative.get_width();
+    uint height = derivative.get_height();
+    
+    uint y  = gid.x;
+    uint x0 = gid.y * kIMP_Integral_Tile;
+    
+    if (y >= height || x0 >= width) return;
+    
+    uint x1 = min(x0 + kIMP_Integral_Tile, width);
+    
+    float2 sum = float2(0);
+    for (uint x = x0; x < x1; x++){
+        sum += derivative.read(uint2(x,y)).xy;
+        rows.write(float4(sum,0,1), uint2(x,y));
+    }
+}
+
+kernel void kernel_derivativeIntegralColumns(
+                                             texture2d<float, access::read>   rows     [[texture(0)]],
+                                             texture2d<float, access::write>  integral [[texture(1)]],
+                                             uint2 gid [[thread_position_in_grid]]
+                                             )
+{
+    uint width  = rows.get_width();
+    uint height = rows.get_height();
+    
+    uint x  = gid.x;
+    uint y0 = gid.y * kIMP_Integral_Tile;
+    
+    if (x >= width || y0 >= height) return;
+    
+    uint y1 = min(y0 + kIMP_Integral_Tile, height);
+    
+    float2 sum = float2(0);
+    for (uint y = y0; y < y1; y++){
+        sum += rows.read(uint2(x,y)).xy;
+        integral.write(float4(sum,0,1), uint2(x,y));
+    }
+}
+
+///
+/// Sum of [x0,x1)x[y0,y1) lying in one block of the tile-relative table
+///
+inline float2 getIntegralBlockSum(int x0, int x1, int y0, int y1,
+                                  texture2d<float, access::read>  integral){
+    
+    int bx = x0 - x0 % kIMP_Integral_Tile;
+    int by = y0 - y0 % kIMP_Integral_Tile;
+    
+    float2 sum = integral.read(uint2(x1-1,y1-1)).xy;
+    
+    if (x0 > bx)             sum -= integral.read(uint2(x0-1,y1-1)).xy;
+    if (y0 > by)             sum -= integral.read(uint2(x1-1,y0-1)).xy;
+    if (x0 > bx && y0 > by)  sum += integral.read(uint2(x0-1,y0-1)).xy;
+    
+    return sum;
+}
+
+///
+/// Sum of the derivative channels over the window [startx,endx)x[starty,endy) around gid, from the
+/// tile-relative summed-area table: the window is clipped to the image and cut at the block edges,
+/// four reads per block it covers instead of a loop over the window
+///
+inline float2 getIntegralSlops(int startx, int endx, int starty, int endy, uint2 gid,
+                               texture2d<float, access::read>  integral){
+    
+    int width  = int(integral.get_width());
+    int height = int(integral.get_height());
+    
+    int x0 = clamp(int(gid.x)+startx, 0, width);
+    int x1 = clamp(int(gid.x)+endx,   0, width);
+    int y0 = clamp(int(gid.y)+starty, 0, height);
+    int y1 = clamp(int(gid.y)+endy,   0, height);
     
     float2 slops = float2(0);
     
-    for(int i = startx; i<endx; i++ ){
-        for(int j = starty; j<endy; j++ ){
-            uint2 gid2 = uint2(int2(gid)+int2(i,j));
-            float2 s = derivative.read(gid2).xy;
-            slops += s;
+    for (int ys = y0; ys < y1;) {
+        int ye = min((ys / kIMP_Integral_Tile + 1) * kIMP_Integral_Tile, y1);
+        for (int xs = x0; xs < x1;) {
+            int xe = min((xs / kIMP_Integral_Tile + 1) * kIMP_Integral_Tile, x1);
+            slops += getIntegralBlockSum(xs, xe, ys, ye, integral);
+            xs = xe;
         }
+        ys = ye;
     }
     
     return slops.yx;
 }
 
-kernel void kernel_pointsScanner(
-                                 texture2d<float, access::sample> suppression      [[texture(0)]],
-                                 texture2d<float, access::write>  destination      [[texture(1)]],
-                                 texture2d<float, access::sample>  derivative      [[texture(2)]],
-                                 
-                                 device   IMPCorner      *corners   [[ buffer(0) ]],
-                                 device   atomic_uint    *count     [[ buffer(1) ]],
-                                 constant uint           &pointsMax [[ buffer(2) ]],
-                                 
-                                 uint2 groupId   [[threadgroup_position_in_grid]],
-                                 uint2 gridSize  [[threadgroups_per_grid]],
-                                 uint2 pid [[thread_position_in_grid]]
-                                 )
+inline float suppressionResponse(texture2d<float, access::read> response, int2 gid, int2 size){
+    return response.read(uint2(clamp(gid, int2(0), size-1))).r;
+}
+
+///
+/// fragment_nonMaximumSuppression fused with the corner list: no mask is written and nothing is
+/// rescanned. The slopes of a corner sum the derivatives over the left, top, bottom and right
+/// quadrants of the window of slopeRegion/2 pixels on each side. Every threadgroup is a tile, its maxima are compacted by a prefix sum of
+/// the flags in threadgroup memory and one atomic reserves the place of the tile in the list, so
+/// the list keeps raster order inside tiles. Threadgroups are up to 256 threads.
+///
+kernel void kernel_nonMaximumSuppressionScanner(
+                                                texture2d<float, access::read>   response    [[texture(0)]],
+                                                texture2d<float, access::write>  destination [[texture(1)]],
+                                                texture2d<float, access::read>   integral    [[texture(2)]],
+                                                
+                                                device   IMPCorner      *corners     [[ buffer(0) ]],
+                                                device   atomic_uint    *count       [[ buffer(1) ]],
+                                                constant uint           &pointsMax   [[ buffer(2) ]],
+                                                constant uint           &slopeRegion [[ buffer(3) ]],
+                                                constant float          &threshold   [[ buffer(4) ]],
+                                                
+                                                uint2 gid   [[thread_position_in_grid]],
+                                                uint  tid   [[thread_index_in_threadgroup]],
+                                                uint2 tsize [[threads_per_threadgroup]]
+                                                )
 {
-    uint width  = derivative.get_width();
-    uint height = derivative.get_height();
+    threadgroup uint prefix[256];
+    threadgroup uint base;
+    
+    int2 size = int2(response.get_width(), response.get_height());
+    int2 p    = int2(gid);
+    uint n    = tsize.x * tsize.y;
+    
+    bool maximum = false;
+    
+    if (p.x < size.x && p.y < size.y) {
+        
+        float c = suppressionResponse(response, p, size);
+        
+        maximum = c >= threshold
+        && c >  suppressionResponse(response, p + int2( 0,-1), size)
+        && c >  suppressionResponse(response, p + int2(-1,-1), size)
+        && c >  suppressionResponse(response, p + int2(-1, 0), size)
+        && c >  suppressionResponse(response, p + int2(-1, 1), size)
+        && c >= suppressionResponse(response, p + int2( 0, 1), size)
+        && c >= suppressionResponse(response, p + int2( 1, 1), size)
+        && c >= suppressionResponse(response, p + int2( 1, 0), size)
+        && c >= suppressionResponse(response, p + int2( 1,-1), size);
+    }
+    
+    prefix[tid] = maximum ? 1 : 0;
+    threadgroup_barrier(mem_flags::mem_threadgroup);
     
-    uint gw = (width+gridSize.x-1)/gridSize.x;
-    uint gh = (height+gridSize.y-1)/gridSize.y;
+    for (uint offset = 1; offset < n; offset <<= 1) {
+        uint v = tid >= offset ? prefix[tid - offset] : 0;
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+        prefix[tid] += v;
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+    }
     
+    if (tid == n - 1) {
+        base = prefix[tid] > 0 ? atomic_fetch_add_explicit(count, prefix[tid], memory_order_relaxed) : 0;
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
     
-    int regionSize = 24;
+    if (!maximum) return;
+    
+    uint index = base + prefix[tid] - 1;
+    if (index >= pointsMax) return;
+    
+    int regionSize = int(slopeRegion);
     int rs = -regionSize/2;
     int re = regionSize/2+1;
     
-    for (uint y=0; y<gh; y+=1){
-        
-        uint ry = y + groupId.y * gh;
-        if (ry > height) break;
-        
-        for (uint x=0; x<gw; x+=1){
-
-            uint rx = x + groupId.x * gw;
-            if (rx > width) break;
-            
-            uint2 gid(rx,ry);
-
-            float3 color = suppression.read(gid).rgb;
-
-            //destination.write(derivative.read(gid),gid);
-
-            if (color.g > 0) {
-
-                uint index = atomic_fetch_add_explicit(count, 1, memory_order_relaxed);
-                if (index > pointsMax) {
-                    return;
-                }
-
-                IMPCorner corner;
-                corner.point = float2(gid)/float2(width,height);
-                corner.slope = float4(0);
-                
-                corner.slope.x  = getSlops(rs, 0,  rs, re,  gid, derivative,destination).x;
-                corner.slope.y  = getSlops(rs, re, rs, 0,   gid, derivative,destination).y;
-                corner.slope.z  = getSlops(rs, re, 0,  re,  gid, derivative,destination).y;
-                corner.slope.w  = getSlops(0,  re, rs, re,  gid, derivative,destination).x;
-                
-                if (length(corner.slope)){
-                    corner.slope = normalize(corner.slope);
-                }
-
-                corners[index] = corner;
-            }
-        }
+    IMPCorner corner;
+    corner.point = float2(gid)/float2(size);
+    corner.slope = float4(0);
+    
+    corner.slope.x  = getIntegralSlops(rs, 0,  rs, re,  gid, integral).x;
+    corner.slope.y  = getIntegralSlops(rs, re, rs, 0,   gid, integral).y;
+    corner.slope.z  = getIntegralSlops(rs, re, 0,  re,  gid, integral).y;
+    corner.slope.w  = getIntegralSlops(0,  re, rs, re,  gid, integral).x;
+    
+    if (length(corner.slope)){
+        corner.slope = normalize(corner.slope);
     }
+    
+    corners[index] = corner;
 }
+
 #endif // __cplusplus
 #endif //__METAL_VERSION__
 #endif // IMPHarisCorrnersDetector_metal
@@ -68,6 +68,103 @@ kernel void kernel_houghTransformAtomic(
     }
 }
 
+/**
+ Sobel gradient of the luma in the edges grid, the second component goes down the rows
+ */
+inline float2 houghSourceGradient(
+                                  texture2d<float, access::sample>   source,
+                                  float2 coords,
+                                  float2 texel
+                                  )
+{
+    float tl = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2(-1,-1)).rgb);
+    float t  = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2( 0,-1)).rgb);
+    float tr = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2( 1,-1)).rgb);
+    float l  = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2(-1, 0)).rgb);
+    float r  = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2( 1, 0)).rgb);
+    float bl = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2(-1, 1)).rgb);
+    float b  = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2( 0, 1)).rgb);
+    float br = IMProcessing::lum(source.sample(IMProcessing::baseSampler, coords + texel * float2( 1, 1)).rgb);
+    
+    return float2((tr + 2*r + br) - (tl + 2*l + bl),
+                  (bl + 2*b + br) - (tl + 2*t + tr));
+}
+
+/**
+ Oriented voting: an edge pixel votes only the angles within spread of its edge normal, the direction of
+ the Sobel gradient of the source. Angles of a half turn wrap, theta + pi is the same line of the opposite rho.
+ A pixel votes 1 + weight * gradient length rounded, a pixel without a gradient votes every angle.
+ */
+kernel void kernel_houghTransformAtomicGradient(
+                                                texture2d<float, access::sample>   inTexture     [[texture(0)]],
+                                                texture2d<float, access::write>    outTexture    [[texture(1)]],
+                                                texture2d<float, access::sample>   sourceTexture [[texture(2)]],
+                                                volatile device   atomic_uint      *accum      [[ buffer(0)]],
+                                                constant uint                      &numrho     [[ buffer(1)]],
+                                                constant uint                      &numangle   [[ buffer(2)]],
+                                                constant float                     &rhoStep    [[ buffer(3)]],
+                                                constant float                     &thetaStep  [[ buffer(4)]],
+                                                constant float                     &minTheta   [[ buffer(5)]],
+                                                constant IMPRegion                 &regionIn   [[ buffer(6)]],
+                                                constant float                     &spread     [[ buffer(7)]],
+                                                constant float                     &weight     [[ buffer(8)]],
+                                                uint2 gid [[thread_position_in_grid]]
+                                                )
+{
+    
+    float4 inColor = IMProcessing::sampledColor(inTexture,regionIn,1,gid);
+    
+    if (!(inColor.a>0 && inColor.b > 0)) return;
+    
+    float2 texel    = 1/float2(inTexture.get_width(), inTexture.get_height());
+    float2 gradient = houghSourceGradient(sourceTexture, float2(gid) * texel, texel);
+    float  length   = sqrt(dot(gradient,gradient));
+    
+    int N = int(numangle);
+    int K = int(round(max(spread,0.0) / thetaStep));
+    
+    if (length <= 0 || 2 * K + 1 >= N) {
+        houghTransformAtomic(accum,numrho,numangle,rhoStep,thetaStep,minTheta,gid);
+        return;
+    }
+    
+    uint  votes = 1 + uint(round(max(weight,0.0) * length));
+    float pi    = M_PI_F;
+    
+    float theta = atan2(gradient.y, gradient.x);
+    if (theta < 0)   theta += pi;
+    if (theta >= pi) theta -= pi;
+    
+    bool circular = float(N) * thetaStep >= pi - 0.5 * thetaStep;
+    
+    float t = fmod(theta - minTheta, pi);
+    if (t < 0) t += pi;
+    
+    int c = int(round(t / thetaStep));
+    
+    if (circular)       c %= N;
+    else if (c >= N + K) c = int(round((t - pi) / thetaStep));
+    
+    float irho = 1/rhoStep;
+    
+    for (int d = -K; d <= K; d++) {
+        
+        int n = c + d;
+        
+        if (circular) n = (n + N) % N;
+        else if (n < 0 || n >= N) continue;
+        
+        float angle = minTheta + float(n) * thetaStep;
+        
+        float r = round( float(gid.x) * cos(angle) * irho + float(gid.y) * sin(angle) * irho);
+        r += (numrho - 1) / 2;
+        
+        int index = int((n+1) * (numrho+2) + r+1);
+        
+        atomic_fetch_add_explicit(&accum[index], votes, memory_order_relaxed);
+    }
+}
+
 kernel void kernel_houghTransformAtomicOriented(
                                                 texture2d<float, access::sample>   inTexture   [[texture(0)]],
                                                 texture2d<float, access::write>    outTexture  [[texture(1)]],
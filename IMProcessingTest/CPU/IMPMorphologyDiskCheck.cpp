@@ -0,0 +1,75 @@
+//
+//  IMPMorphologyDiskCheck.cpp
+//  IMProcessing
+//
+//  Created by agent on 19.10.2026.
+//  Copyright © 2026 Dehancer. All rights reserved.
+//
+//  Dilates a single impulse with the disk of radius 1 - 8 and compares the result with the
+//  lattice octagon |x| <= r, |y| <= r, |x| + |y| <= s the decomposition promises, s within one
+//  of sqrt(2) r. Build from the repository root:
+//
+//  c++ -std=c++14 -O2 -IIMProcessing/Classes/CPU -IIMProcessing/Classes/Bridging
+//      IMProcessingTest/CPU/IMPMorphologyDiskCheck.cpp IMProcessing/Classes/CPU/IMPMorphology_cpu.cpp -lpthread
+//
+
+#include "IMPMorphology_cpu.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace IMProcessing::cpu;
+
+int main() {
+
+    //
+    // |x| + |y| reach of radius 1 - 8
+    //
+    const long reach[9] = { 0, 2, 3, 4, 6, 8, 8, 10, 12 };
+
+    int failures = 0;
+
+    for (long r = 1; r <= 8; r++) {
+
+        const long s = reach[r];
+
+        if (std::fabs(double(s) - std::sqrt(2.0) * double(r)) > 1.0) {
+            std::printf("radius %ld: |x| + |y| reach %ld is not within one of sqrt(2) r\n", r, s);
+            failures++;
+        }
+
+        const size_t side = 2 * size_t(r) + 9, centre = side / 2;
+
+        Image<uint8_t> image(side, side, 1);
+        for (size_t y = 0; y < side; y++)
+            for (size_t x = 0; x < side; x++) image.row(y)[x] = x == centre && y == centre ? 255 : 0;
+
+        Morphology disk(Morphology::disk, size_t(r));
+
+        if (!disk.apply(image.view().readonly(), image.view(), Morphology::dilate)) {
+            std::printf("radius %ld: dilation failed\n", r);
+            failures++;
+            continue;
+        }
+
+        size_t wrong = 0;
+
+        for (size_t y = 0; y < side; y++) {
+            for (size_t x = 0; x < side; x++) {
+                const long dx = std::labs(long(x) - long(centre)), dy = std::labs(long(y) - long(centre));
+                const bool inside = dx <= r && dy <= r && dx + dy <= s;
+                if ((image.row(y)[x] == 255) != inside) wrong++;
+            }
+        }
+
+        if (wrong > 0) {
+            std::printf("radius %ld: %zu pixels differ from the octagon\n", r, wrong);
+            failures++;
+        }
+    }
+
+    std::printf(failures == 0 ? "disk: ok\n" : "disk: %d failures\n", failures);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}